@@ -30,6 +30,7 @@
  */
 
 #include <cmath>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -50,6 +51,7 @@
 #include "atlas/mesh/actions/BuildHalo.h"
 #include "atlas/mesh/actions/BuildParallelFields.h"
 #include "atlas/mesh/actions/BuildPeriodicBoundaries.h"
+#include "atlas/mesh/actions/ReorderMesh.h"
 #include "atlas/meshgenerator.h"
 #include "atlas/output/Gmsh.h"
 #include "atlas/parallel/Checksum.h"
@@ -58,6 +60,7 @@
 #include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/AtlasTool.h"
 #include "atlas/runtime/Trace.h"
+#include "atlas/runtime/trace/Timings.h"
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/Earth.h"
 
@@ -141,8 +144,14 @@ public:
         add_option( new SimpleOption<size_t>( "omp", "Number of OpenMP threads per MPI task" ) );
         add_option( new SimpleOption<bool>( "progress", "Show progress bar instead of intermediate timings" ) );
         add_option( new SimpleOption<bool>( "output", "Write output in gmsh format" ) );
+        add_option( new SimpleOption<std::string>(
+            "reorder", "Renumber mesh for memory locality: hilbert, morton or reverse_cuthill_mckee" ) );
         add_option( new SimpleOption<long>( "exclude", "Exclude number of iterations in statistics (default=1)" ) );
         add_option( new SimpleOption<bool>( "details", "Show detailed timers (default=false)" ) );
+        add_option( new SimpleOption<bool>(
+            "trace-mpi", "Report timers reduced over MPI tasks, with load imbalance (default=false)" ) );
+        add_option( new SimpleOption<std::string>( "trace-json", "Write timers in JSON format to given file" ) );
+        add_option( new SimpleOption<std::string>( "trace-csv", "Write timers in CSV format to given file" ) );
     }
 
     void setup();
@@ -173,6 +182,7 @@ private:
     long omp_threads;
     double dz;
     std::string gridname;
+    std::string reorder;
 
     TimerStats iteration_timer;
     TimerStats haloexchange_timer;
@@ -203,6 +213,7 @@ void AtlasBenchmark::execute( const Args& args ) {
     args.get( "exclude", exclude );
     output = false;
     args.get( "output", output );
+    args.get( "reorder", reorder );
     bool help( false );
     args.get( "help", help );
 
@@ -217,6 +228,7 @@ void AtlasBenchmark::execute( const Args& args ) {
     Log::info() << "  grid: " << gridname << endl;
     Log::info() << "  nlev: " << nlev << endl;
     Log::info() << "  niter: " << niter << endl;
+    if ( reorder.size() ) Log::info() << "  reorder: " << reorder << endl;
     Log::info() << endl;
     Log::info() << "  MPI tasks: " << mpi::comm().size() << endl;
     Log::info() << "  OpenMP threads per MPI task: " << atlas_omp_get_max_threads() << endl;
@@ -263,9 +275,22 @@ void AtlasBenchmark::execute( const Args& args ) {
     report_config.set( "indent", 4 );
     if ( not args.getBool( "details", false ) )
         report_config.set( "exclude", std::vector<std::string>{"halo-exchange", "atlas-benchmark-setup/*"} );
+    report_config.set( "mpi", args.getBool( "trace-mpi", false ) );
     Log::info() << timer.report( report_config ) << std::endl;
     Log::info() << endl;
 
+    auto write_report = [&]( const std::string& path, const std::string& format ) {
+        // collective in case of "trace-mpi"
+        std::string report = runtime::trace::Timings::report( report_config | util::Config( "format", format ) );
+        if ( mpi::comm().rank() == 0 ) {
+            std::ofstream file( path );
+            file << report;
+        }
+    };
+    std::string path;
+    if ( args.get( "trace-json", path ) ) write_report( path, "json" );
+    if ( args.get( "trace-csv", path ) ) write_report( path, "csv" );
+
     mpi::comm().barrier();
 
     Log::info() << "Results:" << endl;
@@ -324,6 +349,9 @@ void AtlasBenchmark::setup() {
     //  gmsh.write( mesh );
 
     ATLAS_TRACE_SCOPE( "build_edges_parallel_fiels" ) { build_edges_parallel_fields( mesh ); }
+    if ( reorder.size() ) {
+        ATLAS_TRACE_SCOPE( "reorder_mesh" ) { reorder_mesh( mesh, reorder ); }
+    }
     ATLAS_TRACE_SCOPE( "build_median_dual_mesh" ) { build_median_dual_mesh( mesh ); }
     ATLAS_TRACE_SCOPE( "build_node_to_edge_connectivity" ) { build_node_to_edge_connectivity( mesh ); }
 
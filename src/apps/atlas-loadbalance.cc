@@ -20,6 +20,7 @@
 #include "atlas/meshgenerator/MeshGenerator.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/runtime/Log.h"
+#include "atlas/util/Config.h"
 #include "eckit/config/Resource.h"
 #include "eckit/exception/Exceptions.h"
 #include "eckit/runtime/Tool.h"
@@ -57,6 +58,8 @@ public:
             "\n"
             "       --halo       Output file for mesh\n"
             "\n"
+            "       --timings    Append timers reduced over MPI tasks, with load imbalance\n"
+            "\n"
             "AUTHOR\n"
             "       Written by Willem Deconinck.\n"
             "\n"
@@ -78,8 +81,9 @@ public:
             if ( i == 1 && argv[i][0] != '-' ) { key = std::string( argv[i] ); }
         }
 
-        halo   = Resource<int>( "--halo", 1 );
-        output = Resource<std::string>( "--output", "" );
+        halo    = Resource<int>( "--halo", 1 );
+        output  = Resource<std::string>( "--output", "" );
+        timings = Resource<bool>( "--timings", false );
     }
 
 private:
@@ -87,6 +91,7 @@ private:
     std::string key;
     int halo;
     std::string output;
+    bool timings;
     std::string identifier;
 };
 
@@ -108,10 +113,11 @@ void AtlasLoadbalance::run() {
 
     functionspace::NodeColumns nodes( mesh, option::halo( halo ) );
 
-    if ( output.size() ) { write_load_balance_report( mesh, output ); }
+    util::Config config( "timings", timings );
+    if ( output.size() ) { write_load_balance_report( mesh, output, config ); }
     else {
         std::stringstream s;
-        write_load_balance_report( mesh, s );
+        write_load_balance_report( mesh, s, config );
 
         if ( mpi::comm().rank() == 0 ) { std::cout << s.str() << std::endl; }
     }
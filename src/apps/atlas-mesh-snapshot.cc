@@ -0,0 +1,124 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <string>
+
+#include "atlas/functionspace/NodeColumns.h"
+#include "atlas/grid.h"
+#include "atlas/library/Library.h"
+#include "atlas/mesh/Mesh.h"
+#include "atlas/mesh/actions/BuildEdges.h"
+#include "atlas/mesh/actions/BuildParallelFields.h"
+#include "atlas/meshgenerator/MeshGenerator.h"
+#include "atlas/output/detail/MeshSnapshotIO.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/AtlasTool.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/Config.h"
+#include "eckit/exception/Exceptions.h"
+#include "eckit/filesystem/PathName.h"
+#include "eckit/log/Bytes.h"
+
+//------------------------------------------------------------------------------
+
+using namespace atlas;
+using atlas::util::Config;
+using eckit::PathName;
+
+//------------------------------------------------------------------------------
+
+class MeshSnapshot : public AtlasTool {
+    virtual void execute( const Args& args );
+    virtual std::string briefDescription() {
+        return "Generate a partitioned mesh with halo and write it as binary mesh snapshot";
+    }
+    virtual std::string usage() { return name() + " (--grid.name=name|--grid.json=path) [OPTION]... OUTPUT [--help]"; }
+    virtual std::string longDescription() {
+        return "Each MPI task generates, using OpenMP threads, the mesh of its own partition, builds parallel\n" +
+               indent() + "fields and halo, and writes it to OUTPUT.<part>. The index OUTPUT is written by task 0.\n" +
+               indent() + "All partitions can be created on one node by launching as many tasks as partitions.\n" +
+               indent() + "A model run with the same number of MPI tasks then reads its partition with\n" +
+               indent() + "atlas::output::detail::MeshSnapshotIO::read( OUTPUT ).";
+    }
+
+public:
+    MeshSnapshot( int argc, char** argv );
+};
+
+//-----------------------------------------------------------------------------
+
+MeshSnapshot::MeshSnapshot( int argc, char** argv ) : AtlasTool( argc, argv ) {
+    add_option( new SimpleOption<std::string>(
+        "grid.name", "Grid unique identifier\n" + indent() + "     Example values: N80, F40, O24, L32" ) );
+    add_option( new SimpleOption<PathName>( "grid.json", "Grid described by json file" ) );
+    add_option( new SimpleOption<long>( "halo", "Halo size" ) );
+    add_option( new SimpleOption<bool>( "edges", "Build edge datastructure" ) );
+    add_option( new SimpleOption<std::string>( "generator", "Mesh generator" ) );
+    add_option( new SimpleOption<std::string>( "partitioner", "Mesh partitioner" ) );
+    add_option( new SimpleOption<double>( "angle", "Maximum element-edge slant deviation from meridian in degrees" ) );
+    add_option( new SimpleOption<bool>( "include_pole", "Include pole point" ) );
+    add_option( new SimpleOption<bool>( "patch_pole", "Patch poles with elements." ) );
+}
+
+//-----------------------------------------------------------------------------
+
+void MeshSnapshot::execute( const Args& args ) {
+    std::string key;
+    args.get( "grid.name", key );
+    std::string path_in_str;
+    args.get( "grid.json", path_in_str );
+
+    long halo = 0;
+    args.get( "halo", halo );
+    bool edges = false;
+    args.get( "edges", edges );
+    if ( edges ) halo = std::max( halo, 1l );
+
+    if ( !args.count() || ( key.empty() && path_in_str.empty() ) ) {
+        Log::warning() << "missing argument --grid.name or --grid.json, or OUTPUT" << std::endl;
+        Log::warning() << "Usage: " << usage() << std::endl;
+        return;
+    }
+    PathName path_out = args( 0 );
+
+    Grid grid = key.size() ? Grid( key ) : Grid( Config( PathName( path_in_str ) ) );
+
+    std::string generator_type = ( grid::RegularGrid( grid ) ? "regular" : "structured" );
+    args.get( "generator", generator_type );
+    eckit::LocalConfiguration generator_config( args );
+    generator_config.set( "3d", false );
+
+    Log::info() << "Generating " << mpi::comm().size() << " partitions of grid \"" << grid.name() << "\" with halo "
+                << halo << ", using " << atlas_omp_get_max_threads() << " threads per task" << std::endl;
+
+    Mesh mesh = MeshGenerator( generator_type, generator_config ).generate( grid );
+
+    functionspace::NodeColumns nodes_fs( mesh, option::halo( halo ) );
+    if ( edges ) {
+        mesh::actions::build_edges( mesh );
+        mesh::actions::build_pole_edges( mesh );
+        mesh::actions::build_edges_parallel_fields( mesh );
+    }
+
+    output::detail::MeshSnapshotIO::write( path_out, mesh );
+
+    Log::info() << "Written mesh snapshot \"" << path_out << "\", partition footprint "
+                << eckit::Bytes( mesh.footprint() ) << std::endl;
+}
+
+//------------------------------------------------------------------------------
+
+int main( int argc, char** argv ) {
+    MeshSnapshot tool( argc, argv );
+    return tool.start();
+}
@@ -0,0 +1,270 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/array/Allocator.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+#include "eckit/config/Resource.h"
+
+#include "atlas/array/native/NativeMemory.h"
+#include "atlas/runtime/ErrorHandling.h"
+
+//------------------------------------------------------------------------------
+
+namespace atlas {
+namespace array {
+
+namespace {
+
+constexpr size_t MB = 1024 * 1024;
+
+size_t align_up( size_t bytes ) {
+    return ( ( bytes + native::alignment() - 1 ) / native::alignment() ) * native::alignment();
+}
+
+//------------------------------------------------------------------------------
+
+class HostAllocator : public Allocator {
+public:
+    virtual void* allocate( size_t bytes ) override {
+        void* ptr = native::allocate_host( bytes );
+        std::lock_guard<std::mutex> guard( lock_ );
+        ++stats_.allocations;
+        stats_.bytes_in_use += bytes;
+        stats_.high_water = std::max( stats_.high_water, stats_.bytes_in_use );
+        return ptr;
+    }
+
+    virtual void deallocate( void* ptr, size_t bytes ) override {
+        if ( ptr == nullptr ) return;
+        native::deallocate_host( ptr, bytes );
+        std::lock_guard<std::mutex> guard( lock_ );
+        stats_.bytes_in_use -= bytes;
+    }
+
+    virtual std::string name() const override { return "host"; }
+
+    virtual Statistics statistics() const override {
+        std::lock_guard<std::mutex> guard( lock_ );
+        return stats_;
+    }
+
+private:
+    mutable std::mutex lock_;
+    Statistics stats_;
+};
+
+//------------------------------------------------------------------------------
+
+class PoolAllocator : public Allocator {
+public:
+    PoolAllocator( Allocator& upstream ) :
+        upstream_( upstream ),
+        limit_( eckit::Resource<size_t>( "$ATLAS_ARRAY_POOL_LIMIT", 1024 ) * MB ) {}
+
+    virtual void* allocate( size_t bytes ) override {
+        if ( bytes == 0 ) return nullptr;
+        size_t cls        = size_class( bytes );
+        size_t block_size = class_bytes( cls );
+        void* ptr         = nullptr;
+        {
+            std::lock_guard<std::mutex> guard( lock_ );
+            ++stats_.allocations;
+            stats_.bytes_in_use += block_size;
+            if ( not free_[cls].empty() ) {
+                ptr = free_[cls].back();
+                free_[cls].pop_back();
+                ++stats_.hits;
+                stats_.bytes_cached -= block_size;
+            }
+            else {
+                stats_.high_water = std::max( stats_.high_water, stats_.bytes_in_use + stats_.bytes_cached );
+            }
+        }
+        if ( ptr == nullptr ) { return upstream_.allocate( block_size ); }
+        // A reused block still holds the data of its previous owner
+        if ( native::initialise() ) { std::memset( ptr, 0, bytes ); }
+        return ptr;
+    }
+
+    virtual void deallocate( void* ptr, size_t bytes ) override {
+        if ( ptr == nullptr ) return;
+        size_t cls        = size_class( bytes );
+        size_t block_size = class_bytes( cls );
+        {
+            std::lock_guard<std::mutex> guard( lock_ );
+            stats_.bytes_in_use -= block_size;
+            if ( stats_.bytes_cached + block_size <= limit_ ) {
+                free_[cls].push_back( ptr );
+                stats_.bytes_cached += block_size;
+                return;
+            }
+        }
+        upstream_.deallocate( ptr, block_size );
+    }
+
+    virtual std::string name() const override { return "pool"; }
+
+    virtual Statistics statistics() const override {
+        std::lock_guard<std::mutex> guard( lock_ );
+        return stats_;
+    }
+
+    void release_cached() {
+        std::lock_guard<std::mutex> guard( lock_ );
+        for ( size_t cls = 0; cls < free_.size(); ++cls ) {
+            for ( void* ptr : free_[cls] ) {
+                upstream_.deallocate( ptr, class_bytes( cls ) );
+            }
+            free_[cls].clear();
+        }
+        stats_.bytes_cached = 0;
+    }
+
+private:
+    static constexpr size_t min_class = 6;  // 64 bytes, one cache line
+
+    static size_t size_class( size_t bytes ) {
+        size_t cls = min_class;
+        while ( class_bytes( cls ) < bytes ) {
+            ++cls;
+        }
+        ASSERT( cls < nb_classes );
+        return cls;
+    }
+
+    static size_t class_bytes( size_t cls ) { return size_t( 1 ) << cls; }
+
+    static constexpr size_t nb_classes = 8 * sizeof( size_t );
+
+    Allocator& upstream_;
+    size_t limit_;
+    mutable std::mutex lock_;
+    Statistics stats_;
+    std::array<std::vector<void*>, nb_classes> free_;
+};
+
+constexpr size_t PoolAllocator::min_class;
+constexpr size_t PoolAllocator::nb_classes;
+
+//------------------------------------------------------------------------------
+
+// The allocators are never destroyed, as storage of static objects may still be returned
+// to them during static destruction
+
+HostAllocator& host_allocator() {
+    static HostAllocator* allocator = new HostAllocator();
+    return *allocator;
+}
+
+PoolAllocator& pool_allocator() {
+    static PoolAllocator* allocator = new PoolAllocator( host_allocator() );
+    return *allocator;
+}
+
+Allocator& default_allocator() {
+    static Allocator& allocator = eckit::Resource<bool>( "$ATLAS_ARRAY_POOL", false )
+                                      ? static_cast<Allocator&>( pool_allocator() )
+                                      : static_cast<Allocator&>( host_allocator() );
+    return allocator;
+}
+
+thread_local Allocator* current_allocator = nullptr;
+
+void report_line( std::ostream& out, const Allocator& allocator ) {
+    Allocator::Statistics stats = allocator.statistics();
+    if ( stats.allocations == 0 ) return;
+    out << "Array allocator \"" << allocator.name() << "\" : " << stats.allocations << " allocations";
+    if ( stats.hits ) {
+        out << ", " << stats.hits << " reused (" << std::fixed << std::setprecision( 1 )
+            << 100. * double( stats.hits ) / double( stats.allocations ) << "%)";
+    }
+    out << std::fixed << std::setprecision( 1 ) << ", in use " << double( stats.bytes_in_use ) / MB << " MB";
+    if ( stats.bytes_cached ) { out << ", cached " << double( stats.bytes_cached ) / MB << " MB"; }
+    out << ", high-water " << double( stats.high_water ) / MB << " MB" << std::endl;
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+
+Allocator& Allocator::host() {
+    return host_allocator();
+}
+
+Allocator& Allocator::pool() {
+    return pool_allocator();
+}
+
+Allocator& Allocator::current() {
+    return current_allocator ? *current_allocator : default_allocator();
+}
+
+void Allocator::release() {
+    pool_allocator().release_cached();
+}
+
+std::string Allocator::report() {
+    std::stringstream out;
+    report_line( out, host() );
+    report_line( out, pool() );
+    return out.str();
+}
+
+//------------------------------------------------------------------------------
+
+ScopedAllocator::ScopedAllocator( Allocator& allocator ) : previous_( current_allocator ) {
+    current_allocator = &allocator;
+}
+
+ScopedAllocator::~ScopedAllocator() {
+    current_allocator = previous_;
+}
+
+//------------------------------------------------------------------------------
+
+Arena::Arena( size_t block_bytes, Allocator& upstream ) :
+    upstream_( upstream ),
+    block_bytes_( block_bytes ? block_bytes : MB ),
+    offset_( 0 ),
+    size_( 0 ) {}
+
+Arena::~Arena() {
+    for ( const Block& block : blocks_ ) {
+        upstream_.deallocate( block.data, block.bytes );
+    }
+}
+
+void* Arena::allocate( size_t bytes ) {
+    if ( bytes == 0 ) return nullptr;
+    bytes = align_up( bytes );
+    if ( blocks_.empty() || offset_ + bytes > blocks_.back().bytes ) {
+        Block block;
+        block.bytes = std::max( bytes, block_bytes_ );
+        block.data  = static_cast<char*>( upstream_.allocate( block.bytes ) );
+        blocks_.push_back( block );
+        offset_ = 0;
+    }
+    void* ptr = blocks_.back().data + offset_;
+    offset_ += bytes;
+    size_ += bytes;
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+
+}  // namespace array
+}  // namespace atlas
@@ -0,0 +1,138 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+namespace atlas {
+namespace array {
+
+//------------------------------------------------------------------------------
+
+/// @brief Source of host memory for array storage and communication buffers
+///
+/// Memory returned by allocate() is aligned to native::alignment(). The size passed to
+/// deallocate() must be the size passed to allocate().
+class Allocator {
+public:
+    struct Statistics {
+        size_t allocations{0};   ///< Number of calls to allocate()
+        size_t hits{0};          ///< Allocations served without requesting memory from the system
+        size_t bytes_in_use{0};  ///< Bytes currently handed out
+        size_t bytes_cached{0};  ///< Bytes held for reuse, not handed out
+        size_t high_water{0};    ///< Maximum of bytes_in_use + bytes_cached
+    };
+
+public:
+    virtual ~Allocator() {}
+
+    virtual void* allocate( size_t bytes ) = 0;
+
+    virtual void deallocate( void* ptr, size_t bytes ) = 0;
+
+    virtual std::string name() const = 0;
+
+    virtual Statistics statistics() const = 0;
+
+    /// Report statistics of host() and pool() allocators, printed with the trace report
+    static std::string report();
+
+    /// Allocator with memory straight from the system, see native::allocate_host()
+    static Allocator& host();
+
+    /// Size-class caching pool on top of host(). Freed blocks are kept in power-of-two size classes
+    /// and handed out again, set to zero unless ATLAS_ARRAY_INITIALISE=0.
+    /// The amount of cached memory is bounded by ATLAS_ARRAY_POOL_LIMIT (MB, default 1024).
+    static Allocator& pool();
+
+    /// Allocator currently used for new Array storage and SVector on this thread.
+    /// This is host(), or pool() when the environment variable ATLAS_ARRAY_POOL=1,
+    /// unless overridden within the scope of a ScopedAllocator
+    static Allocator& current();
+
+    /// Return cached memory of pool() to the system
+    static void release();
+};
+
+//------------------------------------------------------------------------------
+
+/// @brief Use a given allocator for all Arrays and SVectors created on this thread within scope
+///
+/// The allocator is remembered by each storage, so it may outlive the scope.
+///
+/// Example:
+///
+///     {
+///         array::ScopedAllocator scope( array::Allocator::pool() );
+///         Field tmp = fs.createField( field, option::global() );  // storage comes from pool
+///         ...
+///     }  // storage of tmp returns to pool
+class ScopedAllocator {
+public:
+    ScopedAllocator( Allocator& );
+    ~ScopedAllocator();
+    ScopedAllocator( const ScopedAllocator& ) = delete;
+    ScopedAllocator& operator=( const ScopedAllocator& ) = delete;
+
+private:
+    Allocator* previous_;
+};
+
+//------------------------------------------------------------------------------
+
+/// @brief Scoped bump allocator for transient buffers
+///
+/// Allocations are carved out of large blocks requested from an upstream allocator (by default
+/// Allocator::current()) and are only released, all together, when the Arena goes out of scope.
+/// Memory is not initialised. An Arena is not thread-safe.
+///
+/// Example:
+///
+///     array::Arena arena;
+///     double* send = arena.allocate<double>( send_size );
+///     double* recv = arena.allocate<double>( recv_size );
+class Arena {
+public:
+    Arena( size_t block_bytes = 0, Allocator& upstream = Allocator::current() );
+    ~Arena();
+    Arena( const Arena& ) = delete;
+    Arena& operator=( const Arena& ) = delete;
+
+    void* allocate( size_t bytes );
+
+    template <typename T>
+    T* allocate( size_t n ) {
+        return static_cast<T*>( allocate( n * sizeof( T ) ) );
+    }
+
+    /// Bytes handed out since construction
+    size_t size() const { return size_; }
+
+private:
+    struct Block {
+        char* data;
+        size_t bytes;
+    };
+    Allocator& upstream_;
+    std::vector<Block> blocks_;
+    size_t block_bytes_;
+    size_t offset_;
+    size_t size_;
+};
+
+//------------------------------------------------------------------------------
+
+}  // namespace array
+}  // namespace atlas
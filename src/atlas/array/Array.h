@@ -101,6 +101,16 @@ public:
 
     virtual void insert( size_t idx1, size_t size1 ) = 0;
 
+    /// @brief Reserve storage for at least size0 entries in the first dimension
+    ///
+    /// Subsequent calls to resize() or insert() that only grow the first dimension up to
+    /// capacity() then do not reallocate. When capacity is exhausted, storage grows
+    /// geometrically so that repeated growth has amortised constant cost per entry.
+    virtual void reserve( size_t size0 ) = 0;
+
+    /// @brief Number of entries in the first dimension for which storage is allocated
+    virtual size_t capacity() const = 0;
+
     virtual void dump( std::ostream& os ) const = 0;
 
     virtual bool accMap() const = 0;
@@ -184,6 +194,10 @@ public:
 
     virtual void insert( size_t idx1, size_t size1 );
 
+    virtual void reserve( size_t size0 );
+
+    virtual size_t capacity() const;
+
     virtual void resize( const ArrayShape& );
 
     virtual void resize( size_t size0 );
@@ -206,10 +220,16 @@ public:
 
     virtual bool accMap() const;
 
+private:
+    /// Move storage to a new allocation for capacity0 entries of the first dimension, leaving
+    /// gap_size uninitialised entries at index gap_index (native storage only)
+    void reallocate( size_t capacity0, size_t gap_index = 0, size_t gap_size = 0 );
+
 private:
     template <typename T>
     friend class ArrayT_impl;
     mutable bool acc_map_{false};
+    size_t capacity_{0};  // Allocated entries of first dimension (native storage only)
 };
 
 }  // namespace array
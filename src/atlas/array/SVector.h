@@ -13,6 +13,7 @@
 #include <cassert>
 #include <cstddef>
 
+#include "atlas/array/Allocator.h"
 #include "atlas/library/config.h"
 #include "atlas/runtime/ErrorHandling.h"
 
@@ -30,26 +31,31 @@ class SVector {
 public:
 
     ATLAS_HOST_DEVICE
-    SVector() : data_( nullptr ), size_( 0 ), externally_allocated_( false ) {}
+    SVector() : data_( nullptr ), size_( 0 ), externally_allocated_( false ), allocator_( nullptr ) {}
 
     ATLAS_HOST_DEVICE
     SVector( SVector const& other ) :
         data_( other.data_ ),
         size_( other.size_ ),
-        externally_allocated_( other.externally_allocated_ ) {}
+        externally_allocated_( other.externally_allocated_ ),
+        allocator_( other.allocator_ ) {}
 
     ATLAS_HOST_DEVICE
-    SVector( T* data, size_t size ) : data_( data ), size_( size ) {}
-
-    SVector( size_t N ) : data_( nullptr), size_( N ), externally_allocated_( false ) {
-        if( N != 0 ) {
-#if ATLAS_GRIDTOOLS_STORAGE_BACKEND_CUDA
-          cudaError_t err = cudaMallocManaged( &data_, N * sizeof( T ) );
-          if ( err != cudaSuccess ) throw eckit::AssertionFailed( "failed to allocate GPU memory" );
-#else
-          data_ = (T*)malloc( N * sizeof( T ) );
-#endif
-        }
+    SVector( T* data, size_t size ) :
+        data_( data ),
+        size_( size ),
+        externally_allocated_( true ),
+        allocator_( nullptr ) {}
+
+    SVector( size_t N ) : SVector( N, Allocator::current() ) {}
+
+    /// Allocate N elements from given allocator (ignored when memory must be accessible from device)
+    SVector( size_t N, Allocator& allocator ) :
+        data_( nullptr ),
+        size_( N ),
+        externally_allocated_( false ),
+        allocator_( &allocator ) {
+        data_ = allocate( N );
     }
     ATLAS_HOST_DEVICE
     ~SVector() {
@@ -70,9 +76,9 @@ public:
             if ( err != cudaSuccess ) throw eckit::AssertionFailed( "failed to free GPU memory" );
 
 #else
-            free( data_ );
+            allocator_->deallocate( data, size_ * sizeof( T ) );
 #endif
-            data_ = NULL;
+            data = NULL;
         }
     }
     ATLAS_HOST_DEVICE
@@ -110,19 +116,14 @@ public:
         assert( N >= size_ );
         if ( N == size_ ) return;
 
-        T* d_;
-#if ATLAS_GRIDTOOLS_STORAGE_BACKEND_CUDA
-        cudaError_t err = cudaMallocManaged( &d_, sizeof( T ) * N );
-        if ( err != cudaSuccess ) throw eckit::AssertionFailed( "failed to allocate GPU memory" );
-
-#else
-        d_ = (T*)malloc( sizeof( T ) * N );
-#endif
+        if ( allocator_ == nullptr ) { allocator_ = &Allocator::current(); }
+        T* d_ = allocate( N );
         for ( unsigned int c = 0; c < size_; ++c ) {
             d_[c] = data_[c];
         }
-        delete_managedmem( data_ );
-        data_ = d_;
+        if ( !externally_allocated_ ) delete_managedmem( data_ );
+        data_                 = d_;
+        externally_allocated_ = false;
     }
 
     void resize( size_t N ) {
@@ -130,10 +131,25 @@ public:
         size_ = N;
     }
 
+private:
+    T* allocate( size_t N ) {
+        T* data = nullptr;
+        if ( N != 0 ) {
+#if ATLAS_GRIDTOOLS_STORAGE_BACKEND_CUDA
+            cudaError_t err = cudaMallocManaged( &data, N * sizeof( T ) );
+            if ( err != cudaSuccess ) throw eckit::AssertionFailed( "failed to allocate GPU memory" );
+#else
+            data = static_cast<T*>( allocator_->allocate( N * sizeof( T ) ) );
+#endif
+        }
+        return data;
+    }
+
 private:
     T* data_;
     size_t size_;
     bool externally_allocated_;
+    Allocator* allocator_;
 };
 
 //------------------------------------------------------------------------------
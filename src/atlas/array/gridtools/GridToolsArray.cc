@@ -366,6 +366,17 @@ void ArrayT<Value>::insert( size_t idx1, size_t size1 ) {
 
 //------------------------------------------------------------------------------
 
+/// GridTools storage is always reallocated on resize; reserve() has no effect
+template <typename Value>
+void ArrayT<Value>::reserve( size_t ) {}
+
+template <typename Value>
+size_t ArrayT<Value>::capacity() const {
+    return shape( 0 );
+}
+
+//------------------------------------------------------------------------------
+
 template <typename Value>
 void ArrayT<Value>::resize( size_t dim0 ) {
     ArrayT_impl<Value>( *this ).resize_variadic( dim0 );
@@ -1,4 +1,7 @@
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <type_traits>
 
 #include "atlas/array.h"
 #include "atlas/array/ArrayUtil.h"
@@ -12,6 +15,39 @@ using namespace atlas::array::helpers;
 namespace atlas {
 namespace array {
 
+namespace {
+
+/// Capacity of first dimension needed to hold required entries. Growing by a factor 1.5 makes
+/// repeated growth (e.g. adding halo layers) cost amortised O(1) per entry.
+size_t grow_capacity( size_t capacity, size_t required ) {
+    return std::max( required, capacity + capacity / 2 );
+}
+
+/// Number of entries per index of the first dimension
+size_t row_size( const ArrayShape& shape ) {
+    size_t size = 1;
+    for ( size_t j = 1; j < shape.size(); ++j ) {
+        size *= shape[j];
+    }
+    return size;
+}
+
+/// True when storage is laid out as contiguous rows of the first dimension, so that it
+/// can grow or shift along the first dimension with plain memory copies
+bool has_row_layout( const ArraySpec& spec ) {
+    return spec.contiguous() && spec.hasDefaultLayout();
+}
+
+bool grows_first_dimension_only( const ArraySpec& spec, const ArrayShape& shape ) {
+    if ( not has_row_layout( spec ) ) return false;
+    for ( size_t j = 1; j < shape.size(); ++j ) {
+        if ( shape[j] != spec.shape()[j] ) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
 template <typename Value>
 Array* Array::create( size_t dim0 ) {
     return new ArrayT<Value>( dim0 );
@@ -76,32 +112,38 @@ template <typename Value>
 ArrayT<Value>::ArrayT( ArrayDataStore* ds, const ArraySpec& spec ) {
     data_store_ = std::unique_ptr<ArrayDataStore>( ds );
     spec_       = spec;
+    capacity_   = spec_.shape()[0];
 }
 
 template <typename Value>
 ArrayT<Value>::ArrayT( size_t dim0 ) {
     spec_       = ArraySpec( make_shape( dim0 ) );
     data_store_ = std::unique_ptr<ArrayDataStore>( new native::DataStore<Value>( spec_.size() ) );
+    capacity_   = dim0;
 }
 template <typename Value>
 ArrayT<Value>::ArrayT( size_t dim0, size_t dim1 ) {
     spec_       = ArraySpec( make_shape( dim0, dim1 ) );
     data_store_ = std::unique_ptr<ArrayDataStore>( new native::DataStore<Value>( spec_.size() ) );
+    capacity_   = dim0;
 }
 template <typename Value>
 ArrayT<Value>::ArrayT( size_t dim0, size_t dim1, size_t dim2 ) {
     spec_       = ArraySpec( make_shape( dim0, dim1, dim2 ) );
     data_store_ = std::unique_ptr<ArrayDataStore>( new native::DataStore<Value>( spec_.size() ) );
+    capacity_   = dim0;
 }
 template <typename Value>
 ArrayT<Value>::ArrayT( size_t dim0, size_t dim1, size_t dim2, size_t dim3 ) {
     spec_       = ArraySpec( make_shape( dim0, dim1, dim2, dim3 ) );
     data_store_ = std::unique_ptr<ArrayDataStore>( new native::DataStore<Value>( spec_.size() ) );
+    capacity_   = dim0;
 }
 template <typename Value>
 ArrayT<Value>::ArrayT( size_t dim0, size_t dim1, size_t dim2, size_t dim3, size_t dim4 ) {
     spec_       = ArraySpec( make_shape( dim0, dim1, dim2, dim3, dim4 ) );
     data_store_ = std::unique_ptr<ArrayDataStore>( new native::DataStore<Value>( spec_.size() ) );
+    capacity_   = dim0;
 }
 
 template <typename Value>
@@ -112,12 +154,14 @@ ArrayT<Value>::ArrayT( const ArrayShape& shape ) {
         size *= shape[j];
     data_store_ = std::unique_ptr<ArrayDataStore>( new native::DataStore<Value>( size ) );
     spec_       = ArraySpec( shape );
+    capacity_   = shape[0];
 }
 
 template <typename Value>
 ArrayT<Value>::ArrayT( const ArrayShape& shape, const ArrayLayout& layout ) {
     spec_       = ArraySpec( shape );
     data_store_ = std::unique_ptr<ArrayDataStore>( new native::DataStore<Value>( spec_.size() ) );
+    capacity_   = shape[0];
     for ( size_t j = 0; j < layout.size(); ++j )
         ASSERT( spec_.layout()[j] == layout[j] );
 }
@@ -127,6 +171,7 @@ ArrayT<Value>::ArrayT( const ArraySpec& spec ) {
     if ( not spec.contiguous() ) NOTIMP;
     spec_       = spec;
     data_store_ = std::unique_ptr<ArrayDataStore>( new native::DataStore<Value>( spec_.size() ) );
+    capacity_   = spec_.shape()[0];
 }
 
 template <typename Value>
@@ -145,6 +190,12 @@ void ArrayT<Value>::resize( const ArrayShape& _shape ) {
         }
     }
 
+    if ( grows_first_dimension_only( spec_, _shape ) ) {
+        if ( _shape[0] > capacity_ ) { reallocate( grow_capacity( capacity_, _shape[0] ) ); }
+        spec_ = ArraySpec( _shape );
+        return;
+    }
+
     Array* resized = Array::create<Value>( _shape );
 
     switch ( rank() ) {
@@ -181,6 +232,7 @@ void ArrayT<Value>::resize( const ArrayShape& _shape ) {
 
     replace( *resized );
     delete resized;
+    capacity_ = _shape[0];
 }
 
 template <typename Value>
@@ -191,11 +243,58 @@ void ArrayT<Value>::insert( size_t idx1, size_t size1 ) {
     }
     nshape[0] += size1;
 
+    if ( has_row_layout( spec_ ) ) {
+        if ( nshape[0] > capacity_ ) { reallocate( grow_capacity( capacity_, nshape[0] ), idx1, size1 ); }
+        else if ( size1 ) {
+            const size_t row = row_size( nshape );
+            Value* data      = host_data<Value>();
+            std::memmove( data + ( idx1 + size1 ) * row, data + idx1 * row,
+                          ( shape( 0 ) - idx1 ) * row * sizeof( Value ) );
+            // Inserted rows are zero, as when a new block is allocated
+            std::fill( data + idx1 * row, data + ( idx1 + size1 ) * row, Value() );
+        }
+        spec_ = ArraySpec( nshape );
+        return;
+    }
+
     Array* resized = Array::create<Value>( nshape );
 
     array_initializer_partitioned<0>::apply( *this, *resized, idx1, size1 );
     replace( *resized );
     delete resized;
+    capacity_ = nshape[0];
+}
+
+template <typename Value>
+void ArrayT<Value>::reserve( size_t size0 ) {
+    if ( size0 <= capacity_ ) return;
+    if ( not has_row_layout( spec_ ) ) NOTIMP;
+    reallocate( size0 );
+}
+
+template <typename Value>
+size_t ArrayT<Value>::capacity() const {
+    return capacity_;
+}
+
+template <typename Value>
+void ArrayT<Value>::reallocate( size_t capacity0, size_t gap_index, size_t gap_size ) {
+    static_assert( std::is_trivially_copyable<Value>::value, "Array storage is moved with memcpy" );
+    const size_t size0 = shape( 0 );
+    const size_t row   = row_size( shape() );
+    ASSERT( capacity0 >= size0 + gap_size );
+    ASSERT( gap_index <= size0 );
+
+    std::unique_ptr<ArrayDataStore> storage( new native::DataStore<Value>( capacity0 * row ) );
+    const Value* from = host_data<Value>();
+    Value* to         = storage->hostData<Value>();
+    if ( gap_index ) { std::memcpy( to, from, gap_index * row * sizeof( Value ) ); }
+    if ( size0 > gap_index ) {
+        std::memcpy( to + ( gap_index + gap_size ) * row, from + gap_index * row,
+                     ( size0 - gap_index ) * row * sizeof( Value ) );
+    }
+    data_store_.swap( storage );
+    capacity_ = capacity0;
 }
 
 template <typename Value>
@@ -265,6 +364,7 @@ size_t ArrayT<Value>::footprint() const {
     size_t size = sizeof( *this );
     size += bytes();
     if ( not contiguous() ) NOTIMP;
+    size += ( capacity_ - shape( 0 ) ) * row_size( shape() ) * sizeof( Value );
     return size;
 }
 
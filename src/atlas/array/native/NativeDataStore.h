@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include "atlas/array/Allocator.h"
 #include "atlas/array/ArrayUtil.h"
 #include "atlas/library/config.h"
 
@@ -19,10 +20,20 @@ namespace atlas {
 namespace array {
 namespace native {
 
+/// Host storage obtained from Allocator::current(), by default aligned and placed with
+/// first-touch policy, see allocate_host()
 template <typename Value>
 class DataStore : public ArrayDataStore {
 public:
-    DataStore( size_t size ) : data_store_( size ) {}
+    DataStore( size_t size ) :
+        allocator_( Allocator::current() ),
+        data_store_( static_cast<Value*>( allocator_.allocate( size * sizeof( Value ) ) ) ),
+        size_( size ) {}
+
+    ~DataStore() { allocator_.deallocate( data_store_, size_ * sizeof( Value ) ); }
+
+    DataStore( const DataStore& ) = delete;
+    DataStore& operator=( const DataStore& ) = delete;
 
     void cloneToDevice() const {}
 
@@ -40,14 +51,16 @@ public:
 
     void reactivateHostWriteViews() const {}
 
-    void* voidDataStore() { return static_cast<void*>( &data_store_.front() ); }
+    void* voidDataStore() { return static_cast<void*>( data_store_ ); }
 
-    void* voidHostData() { return static_cast<void*>( &data_store_.front() ); }
+    void* voidHostData() { return static_cast<void*>( data_store_ ); }
 
-    void* voidDeviceData() { return static_cast<void*>( &data_store_.front() ); }
+    void* voidDeviceData() { return static_cast<void*>( data_store_ ); }
 
 private:
-    std::vector<Value> data_store_;
+    Allocator& allocator_;
+    Value* data_store_;
+    size_t size_;
 };
 
 //------------------------------------------------------------------------------
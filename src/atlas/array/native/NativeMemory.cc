@@ -0,0 +1,108 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "atlas/array/native/NativeMemory.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "eckit/config/Resource.h"
+
+#include "atlas/parallel/omp/omp.h"
+
+//------------------------------------------------------------------------------
+
+namespace atlas {
+namespace array {
+namespace native {
+
+namespace {
+
+struct MemoryConfig {
+    bool initialise;
+    bool first_touch;
+    bool huge_pages;
+    size_t page_size;
+
+    static const MemoryConfig& instance() {
+        static MemoryConfig config;
+        return config;
+    }
+
+private:
+    MemoryConfig() :
+        initialise( eckit::Resource<bool>( "$ATLAS_ARRAY_INITIALISE", true ) ),
+        first_touch( eckit::Resource<bool>( "$ATLAS_ARRAY_FIRST_TOUCH", true ) ),
+        huge_pages( eckit::Resource<bool>( "$ATLAS_ARRAY_HUGE_PAGES", false ) ),
+        page_size( ::sysconf( _SC_PAGESIZE ) ) {}
+};
+
+/// Size of transparent huge pages
+constexpr size_t huge_page_size = 2 * 1024 * 1024;
+
+/// Below this size a parallel region costs more than it gains
+constexpr size_t first_touch_min_bytes = 256 * 1024;
+
+/// Initialise, or touch one byte per page, of [begin,end)
+void touch( char* data, size_t begin, size_t end, bool initialise, size_t page_size ) {
+    if ( begin >= end ) return;
+    if ( initialise ) { std::memset( data + begin, 0, end - begin ); }
+    else {
+        for ( size_t p = begin; p < end; p += page_size - ( p % page_size ) ) {
+            data[p] = 0;
+        }
+    }
+}
+
+}  // namespace
+
+void* allocate_host( size_t bytes ) {
+    if ( bytes == 0 ) return nullptr;
+
+    const MemoryConfig& config = MemoryConfig::instance();
+
+    bool huge    = config.huge_pages && bytes >= huge_page_size;
+    size_t align = huge ? huge_page_size : alignment();
+    void* ptr    = nullptr;
+    if ( ::posix_memalign( &ptr, align, bytes ) != 0 ) { throw std::bad_alloc(); }
+#ifdef MADV_HUGEPAGE
+    if ( huge ) { ::madvise( ptr, bytes - bytes % huge_page_size, MADV_HUGEPAGE ); }
+#endif
+
+    char* data = static_cast<char*>( ptr );
+    if ( config.first_touch && bytes >= first_touch_min_bytes && not atlas_omp_in_parallel() ) {
+        atlas_omp_parallel {
+            size_t nthreads = atlas_omp_get_num_threads();
+            size_t thread   = atlas_omp_get_thread_num();
+            touch( data, ( bytes * thread ) / nthreads, ( bytes * ( thread + 1 ) ) / nthreads, config.initialise,
+                   config.page_size );
+        }
+    }
+    else {
+        touch( data, 0, bytes, config.initialise, config.page_size );
+    }
+    return ptr;
+}
+
+void deallocate_host( void* ptr, size_t /*bytes*/ ) {
+    std::free( ptr );
+}
+
+bool initialise() {
+    return MemoryConfig::instance().initialise;
+}
+
+}  // namespace native
+}  // namespace array
+}  // namespace atlas
@@ -0,0 +1,47 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+//------------------------------------------------------------------------------
+
+namespace atlas {
+namespace array {
+namespace native {
+
+/// Alignment in bytes of host memory allocated for arrays (cache line, and widest SIMD register)
+constexpr size_t alignment() {
+    return 64;
+}
+
+/// @brief Allocate host memory for array data, aligned to alignment()
+///
+/// Behaviour is controlled with environment variables:
+///  - ATLAS_ARRAY_INITIALISE (default 1) : Set memory to zero. When 0, memory is left uninitialised
+///    apart from touching each page once.
+///  - ATLAS_ARRAY_FIRST_TOUCH (default 1) : Initialise (or touch) memory with all OpenMP threads,
+///    each thread taking an equal contiguous chunk, in the same way as a statically scheduled
+///    atlas_omp_for loop over the first dimension. Pages are then placed on the NUMA node of the
+///    thread that will use them.
+///  - ATLAS_ARRAY_HUGE_PAGES (default 0) : Align large allocations to 2MB and advise the kernel to
+///    back them with transparent huge pages.
+void* allocate_host( size_t bytes );
+
+/// @brief Release memory allocated with allocate_host()
+void deallocate_host( void* ptr, size_t bytes );
+
+/// @brief Whether array memory is set to zero (ATLAS_ARRAY_INITIALISE)
+bool initialise();
+
+}  // namespace native
+}  // namespace array
+}  // namespace atlas
@@ -158,9 +158,9 @@ private:
     static value_type* create( const Mesh& mesh ) {
         mesh.get()->attachObserver( instance() );
         value_type* value = new value_type();
-        eckit::SharedPtr<parallel::GatherScatter> gather(
-            EdgeColumnsGatherScatterCache::instance().get_or_create( mesh ) );
-        value->setup( gather );
+        value->setup( array::make_view<int, 1>( mesh.edges().partition() ).data(),
+                      array::make_view<int, 1>( mesh.edges().remote_index() ).data(), REMOTE_IDX_BASE,
+                      array::make_view<gidx_t, 1>( mesh.edges().global_index() ).data(), mesh.edges().size() );
         return value;
     }
 };
@@ -462,16 +462,7 @@ namespace {
 template <typename T>
 std::string checksum_3d_field( const parallel::Checksum& checksum, const Field& field ) {
     array::ArrayView<T, 3> values = array::make_view<T, 3>( field );
-    array::ArrayT<T> surface_field( field.shape( 0 ), field.shape( 2 ) );
-    array::ArrayView<T, 2> surface = array::make_view<T, 2>( surface_field );
-    for ( size_t n = 0; n < values.shape( 0 ); ++n ) {
-        for ( size_t j = 0; j < surface.shape( 1 ); ++j ) {
-            surface( n, j ) = 0.;
-            for ( size_t l = 0; l < values.shape( 1 ); ++l )
-                surface( n, j ) += values( n, l, j );
-        }
-    }
-    return checksum.execute( surface.data(), surface_field.stride( 0 ) );
+    return checksum.execute( values.data(), field.stride( 0 ) );
 }
 template <typename T>
 std::string checksum_2d_field( const parallel::Checksum& checksum, const Field& field ) {
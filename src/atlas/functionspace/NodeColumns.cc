@@ -13,6 +13,7 @@
 #include <cstdarg>
 #include <functional>
 #include <limits>
+#include <memory>
 
 #include "eckit/utils/MD5.h"
 
@@ -20,9 +21,11 @@
 #include "atlas/functionspace/NodeColumns.h"
 #include "atlas/grid/Grid.h"
 #include "atlas/library/config.h"
+#include "atlas/mesh/HybridElements.h"
 #include "atlas/mesh/IsGhostNode.h"
 #include "atlas/mesh/Mesh.h"
 #include "atlas/mesh/Nodes.h"
+#include "atlas/mesh/actions/BuildEdges.h"
 #include "atlas/mesh/actions/BuildHalo.h"
 #include "atlas/mesh/actions/BuildParallelFields.h"
 #include "atlas/mesh/actions/BuildPeriodicBoundaries.h"
@@ -95,6 +98,16 @@ array::LocalView<T, 2> make_per_level_view( const Field& field ) {
         return make_view<T, 1>( field ).slice( Range::all(), Range::dummy() );
 }
 
+/// Field for intermediate results of collectives. Its storage comes from Allocator::current(), so
+/// with ATLAS_ARRAY_POOL=1 repeated calls reuse memory instead of allocating global sized fields.
+Field create_temporary_field( const NodeColumns& fs, const eckit::Configuration& config ) {
+    return fs.createField( config );
+}
+
+Field create_temporary_field( const NodeColumns& fs, const Field& other, const eckit::Configuration& config ) {
+    return fs.createField( other, config );
+}
+
 }  // namespace
 
 class NodeColumnsHaloExchangeCache : public util::Cache<std::string, parallel::HaloExchange>,
@@ -220,9 +233,16 @@ private:
     static value_type* create( const Mesh& mesh ) {
         mesh.get()->attachObserver( instance() );
         value_type* value = new value_type();
-        eckit::SharedPtr<parallel::GatherScatter> gather(
-            NodeColumnsGatherScatterCache::instance().get_or_create( mesh ) );
-        value->setup( gather );
+
+        mesh::IsGhostNode is_ghost( mesh.nodes() );
+        std::vector<int> mask( mesh.nodes().size() );
+        const size_t npts = mask.size();
+        atlas_omp_parallel_for( size_t n = 0; n < npts; ++n ) { mask[n] = is_ghost( n ) ? 1 : 0; }
+
+        value->setup( array::make_view<int, 1>( mesh.nodes().partition() ).data(),
+                      array::make_view<int, 1>( mesh.nodes().remote_index() ).data(), REMOTE_IDX_BASE,
+                      array::make_view<gidx_t, 1>( mesh.nodes().global_index() ).data(), mask.data(),
+                      mesh.nodes().size() );
         return value;
     }
 };
@@ -444,39 +464,52 @@ const parallel::HaloExchange& NodeColumns::halo_exchange() const {
     return *halo_exchange_;
 }
 
-void NodeColumns::gather( const FieldSet& local_fieldset, FieldSet& global_fieldset ) const {
-    ASSERT( local_fieldset.size() == global_fieldset.size() );
-
+namespace {
+template <typename T>
+void gather_fields( const parallel::GatherScatter& gather, const FieldSet& local_fieldset,
+                    FieldSet& global_fieldset ) {
+    std::vector<parallel::Field<T const>> loc_fields;
+    std::vector<parallel::Field<T>> glb_fields;
+    std::vector<size_t> roots;
     for ( size_t f = 0; f < local_fieldset.size(); ++f ) {
-        const Field& loc       = local_fieldset[f];
-        Field& glb             = global_fieldset[f];
-        const size_t nb_fields = 1;
+        const Field& loc = local_fieldset[f];
+        if ( loc.datatype() != array::DataType::kind<T>() ) continue;
+        Field& glb = global_fieldset[f];
         size_t root( 0 );
         glb.metadata().get( "owner", root );
+        loc_fields.emplace_back( make_leveled_view<T>( loc ) );
+        glb_fields.emplace_back( make_leveled_view<T>( glb ) );
+        roots.push_back( root );
+    }
+    if ( roots.size() == 1 ) { gather.gather( loc_fields.data(), glb_fields.data(), 1, roots[0] ); }
+    else if ( roots.size() > 1 ) {
+        gather.gather( loc_fields.data(), glb_fields.data(), roots.size(), roots );
+    }
+}
+}  // namespace
 
-        if ( loc.datatype() == array::DataType::kind<int>() ) {
-            parallel::Field<int const> loc_field( make_leveled_view<int>( loc ) );
-            parallel::Field<int> glb_field( make_leveled_view<int>( glb ) );
-            gather().gather( &loc_field, &glb_field, nb_fields, root );
-        }
-        else if ( loc.datatype() == array::DataType::kind<long>() ) {
-            parallel::Field<long const> loc_field( make_leveled_view<long>( loc ) );
-            parallel::Field<long> glb_field( make_leveled_view<long>( glb ) );
-            gather().gather( &loc_field, &glb_field, nb_fields, root );
-        }
-        else if ( loc.datatype() == array::DataType::kind<float>() ) {
-            parallel::Field<float const> loc_field( make_leveled_view<float>( loc ) );
-            parallel::Field<float> glb_field( make_leveled_view<float>( glb ) );
-            gather().gather( &loc_field, &glb_field, nb_fields, root );
-        }
-        else if ( loc.datatype() == array::DataType::kind<double>() ) {
-            parallel::Field<double const> loc_field( make_leveled_view<double>( loc ) );
-            parallel::Field<double> glb_field( make_leveled_view<double>( glb ) );
-            gather().gather( &loc_field, &glb_field, nb_fields, root );
+void NodeColumns::gather( const FieldSet& local_fieldset, FieldSet& global_fieldset ) const {
+    ASSERT( local_fieldset.size() == global_fieldset.size() );
+
+    for ( size_t f = 0; f < local_fieldset.size(); ++f ) {
+        switch ( local_fieldset[f].datatype().kind() ) {
+            case array::DataType::KIND_INT32:
+            case array::DataType::KIND_INT64:
+            case array::DataType::KIND_REAL32:
+            case array::DataType::KIND_REAL64:
+                break;
+            default:
+                throw eckit::Exception( "datatype not supported", Here() );
         }
-        else
-            throw eckit::Exception( "datatype not supported", Here() );
     }
+
+    // Fields of equal datatype are gathered concurrently, each to the rank given by its "owner"
+    // metadata. Global fields created with option::global( parallel::io_rank( jfield, nb_io_ranks ) )
+    // spread the gathered fields over several ranks.
+    gather_fields<int>( gather(), local_fieldset, global_fieldset );
+    gather_fields<long>( gather(), local_fieldset, global_fieldset );
+    gather_fields<float>( gather(), local_fieldset, global_fieldset );
+    gather_fields<double>( gather(), local_fieldset, global_fieldset );
 }
 
 void NodeColumns::gather( const Field& local, Field& global ) const {
@@ -546,15 +579,19 @@ void NodeColumns::scatter( const Field& global, Field& local ) const {
 namespace {
 template <typename T>
 std::string checksum_3d_field( const parallel::Checksum& checksum, const Field& field ) {
+    if ( field.array().contiguous() ) {
+        // All levels and variables of a point are hashed in place
+        return checksum.execute( field.array().data<T>(), field.stride( 0 ) );
+    }
     array::LocalView<T, 3> values = make_leveled_view<T>( field );
-    array::ArrayT<T> surface_field( values.shape( 0 ), values.shape( 2 ) );
+    array::ArrayT<T> surface_field( values.shape( 0 ), values.shape( 1 ) * values.shape( 2 ) );
     array::ArrayView<T, 2> surface = array::make_view<T, 2>( surface_field );
     const size_t npts              = values.shape( 0 );
-    atlas_omp_for( size_t n = 0; n < npts; ++n ) {
-        for ( size_t j = 0; j < surface.shape( 1 ); ++j ) {
-            surface( n, j ) = 0.;
-            for ( size_t l = 0; l < values.shape( 1 ); ++l )
-                surface( n, j ) += values( n, l, j );
+    atlas_omp_parallel_for( size_t n = 0; n < npts; ++n ) {
+        for ( size_t l = 0; l < values.shape( 1 ); ++l ) {
+            for ( size_t j = 0; j < values.shape( 2 ); ++j ) {
+                surface( n, l * values.shape( 2 ) + j ) = values( n, l, j );
+            }
         }
     }
     return checksum.execute( surface.data(), surface_field.stride( 0 ) );
@@ -590,6 +627,97 @@ const parallel::Checksum& NodeColumns::checksum() const {
     return *checksum_;
 }
 
+const NodeColumns::StencilClassification& NodeColumns::stencil_classification( size_t depth ) const {
+    ASSERT( depth > 0 );
+    auto found = stencil_classifications_.find( depth );
+    if ( found != stencil_classifications_.end() ) return found->second;
+
+    ATLAS_TRACE( "NodeColumns::stencil_classification" );
+
+    if ( mesh_.edges().size() == 0 ) {
+        throw eckit::Exception( "Interior and boundary nodes are defined by edges. Call build_edges( mesh ) first.",
+                                Here() );
+    }
+    if ( nodes_.edge_connectivity().rows() != nodes_.size() ) {
+        Mesh mesh( mesh_ );
+        mesh::actions::build_node_to_edge_connectivity( mesh );
+    }
+    const mesh::Nodes::Connectivity& node_edge          = nodes_.edge_connectivity();
+    const mesh::HybridElements::Connectivity& edge_node = mesh_.edges().node_connectivity();
+    mesh::IsGhostNode is_ghost( nodes_ );
+
+    // Distance in edges to the nearest ghost node, computed up to the given depth, by breadth-first search
+    const size_t far = depth + 1;
+    std::vector<size_t> distance( nodes_.size(), far );
+    std::vector<idx_t> front;
+    std::vector<idx_t> next;
+    for ( size_t n = 0; n < nodes_.size(); ++n ) {
+        if ( is_ghost( n ) ) {
+            distance[n] = 0;
+            front.push_back( n );
+        }
+    }
+    for ( size_t d = 1; d <= depth && front.size(); ++d ) {
+        next.clear();
+        for ( idx_t n : front ) {
+            for ( size_t j = 0; j < node_edge.cols( n ); ++j ) {
+                const idx_t e = node_edge( n, j );
+                const idx_t m = ( edge_node( e, 0 ) == n ) ? edge_node( e, 1 ) : edge_node( e, 0 );
+                if ( distance[m] > d ) {
+                    distance[m] = d;
+                    next.push_back( m );
+                }
+            }
+        }
+        front.swap( next );
+    }
+
+    StencilClassification& classification = stencil_classifications_[depth];
+    for ( size_t n = 0; n < nb_nodes_; ++n ) {
+        if ( distance[n] == 0 ) continue;
+        if ( distance[n] > depth ) { classification.interior_nodes.push_back( n ); }
+        else {
+            classification.boundary_nodes.push_back( n );
+        }
+    }
+    for ( size_t e = 0; e < mesh_.edges().size(); ++e ) {
+        if ( std::min( distance[edge_node( e, 0 )], distance[edge_node( e, 1 )] ) >= depth ) {
+            classification.interior_edges.push_back( e );
+        }
+        else {
+            classification.boundary_edges.push_back( e );
+        }
+    }
+    return classification;
+}
+
+const std::vector<idx_t>& NodeColumns::interior_nodes( size_t depth ) const {
+    return stencil_classification( depth ).interior_nodes;
+}
+
+const std::vector<idx_t>& NodeColumns::boundary_nodes( size_t depth ) const {
+    return stencil_classification( depth ).boundary_nodes;
+}
+
+const std::vector<idx_t>& NodeColumns::interior_edges( size_t depth ) const {
+    return stencil_classification( depth ).interior_edges;
+}
+
+const std::vector<idx_t>& NodeColumns::boundary_edges( size_t depth ) const {
+    return stencil_classification( depth ).boundary_edges;
+}
+
+const std::vector<idx_t>& NodeColumns::owned_nodes() const {
+    if ( owned_nodes_computed_ ) return owned_nodes_;
+    mesh::IsGhostNode is_ghost( nodes_ );
+    owned_nodes_.reserve( nb_nodes_ );
+    for ( size_t n = 0; n < nb_nodes_; ++n ) {
+        if ( !is_ghost( n ) ) { owned_nodes_.push_back( n ); }
+    }
+    owned_nodes_computed_ = true;
+    return owned_nodes_;
+}
+
 // std::string NodesFunctionSpace::checksum( const FieldSet& fieldset ) const {
 //  const parallel::Checksum& checksum = mesh_.checksum().get(checksum_name());
 
@@ -624,16 +752,15 @@ namespace detail {  // Collectives implementation
 
 template <typename T>
 void dispatch_sum( const NodeColumns& fs, const Field& field, T& result, size_t& N ) {
-    const mesh::IsGhostNode is_ghost( fs.nodes() );
+    const std::vector<idx_t>& owned  = fs.owned_nodes();
     const array::LocalView<T, 2> arr = make_leveled_scalar_view<T>( field );
     T local_sum                      = 0;
-    const size_t npts                = std::min( arr.shape( 0 ), fs.nb_nodes() );
+    const size_t npts                = owned.size();
   atlas_omp_pragma( omp parallel for default(shared) reduction(+:local_sum) )
-  for( size_t n=0; n<npts; ++n ) {
-      if ( !is_ghost( n ) ) {
-          for ( size_t l = 0; l < arr.shape( 1 ); ++l )
-              local_sum += arr( n, l );
-      }
+  for( size_t i=0; i<npts; ++i ) {
+      const idx_t n = owned[i];
+      for ( size_t l = 0; l < arr.shape( 1 ); ++l )
+          local_sum += arr( n, l );
   }
   ATLAS_TRACE_MPI( ALLREDUCE ) { mpi::comm().allReduce( local_sum, result, eckit::mpi::sum() ); }
 
@@ -678,20 +805,19 @@ void sum( const NodeColumns& fs, const Field& field, T& result, size_t& N ) {
 template <typename T>
 void dispatch_sum( const NodeColumns& fs, const Field& field, std::vector<T>& result, size_t& N ) {
     const array::LocalView<T, 3> arr = make_leveled_view<T>( field );
-    const mesh::IsGhostNode is_ghost( fs.nodes() );
-    const size_t nvar = arr.shape( 2 );
+    const std::vector<idx_t>& owned  = fs.owned_nodes();
+    const size_t nvar                = arr.shape( 2 );
     std::vector<T> local_sum( nvar, 0 );
     result.resize( nvar );
 
     atlas_omp_parallel {
         std::vector<T> local_sum_private( nvar, 0 );
-        const size_t npts = arr.shape( 0 );
-        atlas_omp_for( size_t n = 0; n < npts; ++n ) {
-            if ( !is_ghost( n ) ) {
-                for ( size_t l = 0; l < arr.shape( 1 ); ++l ) {
-                    for ( size_t j = 0; j < arr.shape( 2 ); ++j ) {
-                        local_sum_private[j] += arr( n, l, j );
-                    }
+        const size_t npts = owned.size();
+        atlas_omp_for( size_t i = 0; i < npts; ++i ) {
+            const idx_t n = owned[i];
+            for ( size_t l = 0; l < arr.shape( 1 ); ++l ) {
+                for ( size_t j = 0; j < arr.shape( 2 ); ++j ) {
+                    local_sum_private[j] += arr( n, l, j );
                 }
             }
         }
@@ -744,7 +870,7 @@ void sum( const NodeColumns& fs, const Field& field, std::vector<T>& result, siz
 
 template <typename T>
 void dispatch_sum_per_level( const NodeColumns& fs, const Field& field, Field& sum, size_t& N ) {
-    mesh::IsGhostNode is_ghost( fs.nodes() );
+    const std::vector<idx_t>& owned = fs.owned_nodes();
 
     array::ArrayShape shape;
     shape.reserve( field.rank() - 1 );
@@ -772,13 +898,12 @@ void dispatch_sum_per_level( const NodeColumns& fs, const Field& field, Field& s
             }
         }
 
-        const size_t npts = arr.shape( 0 );
-        atlas_omp_for( size_t n = 0; n < npts; ++n ) {
-            if ( !is_ghost( n ) ) {
-                for ( size_t l = 0; l < arr.shape( 1 ); ++l ) {
-                    for ( size_t j = 0; j < arr.shape( 2 ); ++j ) {
-                        sum_per_level_private_view( l, j ) += arr( n, l, j );
-                    }
+        const size_t npts = owned.size();
+        atlas_omp_for( size_t i = 0; i < npts; ++i ) {
+            const idx_t n = owned[i];
+            for ( size_t l = 0; l < arr.shape( 1 ); ++l ) {
+                for ( size_t j = 0; j < arr.shape( 2 ); ++j ) {
+                    sum_per_level_private_view( l, j ) += arr( n, l, j );
                 }
             }
         }
@@ -817,7 +942,7 @@ void sum_per_level( const NodeColumns& fs, const Field& field, Field& sum, size_
 template <typename DATATYPE>
 void dispatch_order_independent_sum_2d( const NodeColumns& fs, const Field& field, DATATYPE& result, size_t& N ) {
     size_t root  = 0;
-    Field global = fs.createField( field, option::global() );
+    Field global = create_temporary_field( fs, field, option::global() );
     fs.gather( field, global );
     result   = 0;
     auto glb = array::make_view<DATATYPE, 1>( global );
@@ -833,8 +958,9 @@ void dispatch_order_independent_sum( const NodeColumns& fs, const Field& field,
     if ( field.levels() ) {
         const array::LocalView<T, 2> arr = make_leveled_scalar_view<T>( field );
 
-        Field surface_field = fs.createField<T>( option::name( "surface" ) | option::levels( false ) );
-        auto surface        = array::make_view<T, 1>( surface_field );
+        Field surface_field =
+            create_temporary_field( fs, option::datatypeT<T>() | option::name( "surface" ) | option::levels( false ) );
+        auto surface = array::make_view<T, 1>( surface_field );
 
         for ( size_t n = 0; n < arr.shape( 0 ); ++n ) {
             surface( n ) = 0;
@@ -894,7 +1020,7 @@ void dispatch_order_independent_sum_2d( const NodeColumns& fs, const Field& fiel
     result.resize( nvar );
     for ( size_t j = 0; j < nvar; ++j )
         result[j] = 0.;
-    Field global = fs.createField( field, option::name( "global" ) | option::global() );
+    Field global = create_temporary_field( fs, field, option::name( "global" ) | option::global() );
     fs.gather( field, global );
     if ( mpi::comm().rank() == 0 ) {
         const auto glb = make_surface_view<DATATYPE>( global );
@@ -916,7 +1042,8 @@ void dispatch_order_independent_sum( const NodeColumns& fs, const Field& field,
         const auto arr    = make_leveled_view<T>( field );
 
         Field surface_field =
-            fs.createField<T>( option::name( "surface" ) | option::variables( nvar ) | option::levels( false ) );
+            create_temporary_field( fs, option::datatypeT<T>() | option::name( "surface" ) |
+                                            option::variables( nvar ) | option::levels( false ) );
         auto surface = make_surface_view<T>( surface_field );
 
         atlas_omp_for( size_t n = 0; n < arr.shape( 0 ); ++n ) {
@@ -994,7 +1121,7 @@ void dispatch_order_independent_sum_per_level( const NodeColumns& fs, const Fiel
     }
 
     size_t root  = 0;
-    Field global = fs.createField( field, option::name( "global" ) | option::global() );
+    Field global = create_temporary_field( fs, field, option::name( "global" ) | option::global() );
 
     fs.gather( field, global );
     if ( mpi::comm().rank() == 0 ) {
@@ -1808,8 +1935,8 @@ void mean_per_level( const NodeColumns& fs, const Field& field, Field& mean, siz
 template <typename T>
 void mean_and_standard_deviation( const NodeColumns& fs, const Field& field, T& mu, T& sigma, size_t& N ) {
     mean( fs, field, mu, N );
-    Field squared_diff_field = fs.createField( option::name( "sqr_diff" ) | option::datatype( field.datatype() ) |
-                                               option::levels( field.levels() ) );
+    Field squared_diff_field = create_temporary_field(
+        fs, option::name( "sqr_diff" ) | option::datatype( field.datatype() ) | option::levels( field.levels() ) );
 
     array::LocalView<T, 2> squared_diff = make_leveled_scalar_view<T>( squared_diff_field );
     array::LocalView<T, 2> values       = make_leveled_scalar_view<T>( field );
@@ -1828,8 +1955,9 @@ template <typename T>
 void mean_and_standard_deviation( const NodeColumns& fs, const Field& field, std::vector<T>& mu, std::vector<T>& sigma,
                                   size_t& N ) {
     mean( fs, field, mu, N );
-    Field squared_diff_field = fs.createField<T>( option::name( "sqr_diff" ) | option::levels( field.levels() ) |
-                                                  option::variables( field.variables() ) );
+    Field squared_diff_field =
+        create_temporary_field( fs, option::datatypeT<T>() | option::name( "sqr_diff" ) |
+                                        option::levels( field.levels() ) | option::variables( field.variables() ) );
     array::LocalView<T, 3> squared_diff = make_leveled_view<T>( squared_diff_field );
     array::LocalView<T, 3> values       = make_leveled_view<T>( field );
 
@@ -1851,8 +1979,9 @@ template <typename T>
 void dispatch_mean_and_standard_deviation_per_level( const NodeColumns& fs, const Field& field, Field& mean,
                                                      Field& stddev, size_t& N ) {
     dispatch_mean_per_level<T>( fs, field, mean, N );
-    Field squared_diff_field = fs.createField<T>( option::name( "sqr_diff" ) | option::levels( field.levels() ) |
-                                                  option::variables( field.variables() ) );
+    Field squared_diff_field =
+        create_temporary_field( fs, option::datatypeT<T>() | option::name( "sqr_diff" ) |
+                                        option::levels( field.levels() ) | option::variables( field.variables() ) );
     auto squared_diff        = make_leveled_view<T>( squared_diff_field );
     auto values              = make_leveled_view<T>( field );
     auto mu                  = make_per_level_view<T>( mean );
@@ -1898,6 +2027,330 @@ void mean_and_standard_deviation_per_level( const NodeColumns& fs, const Field&
 
 }  // namespace detail
 
+namespace {
+
+struct StatisticsRequest {
+    bool sum;
+    bool sqr;
+    bool min;
+    bool max;
+    bool loc;
+};
+
+// Partial statistics of one field for each level and field-variable, accumulated by one thread
+struct StatisticsPartial {
+    std::vector<double> sum;  // sum of values relative to the reference value
+    std::vector<double> sqr;  // sum of squared values relative to the reference value
+    std::vector<double> min;
+    std::vector<double> max;
+    std::vector<idx_t> min_node;
+    std::vector<idx_t> max_node;
+
+    void reset( size_t size, const StatisticsRequest& request ) {
+        if ( request.sum ) sum.assign( size, 0. );
+        if ( request.sqr ) sqr.assign( size, 0. );
+        if ( request.min ) min.assign( size, std::numeric_limits<double>::max() );
+        if ( request.max ) max.assign( size, -std::numeric_limits<double>::max() );
+        if ( request.loc ) {
+            min_node.assign( size, -1 );
+            max_node.assign( size, -1 );
+        }
+    }
+
+    // Ties are resolved by smallest global index, so that the location does not depend on the distribution
+    void merge( const StatisticsPartial& other, const StatisticsRequest& request,
+                const array::ArrayView<gidx_t, 1>& glb_idx ) {
+        for ( size_t k = 0; k < sum.size(); ++k ) {
+            sum[k] += other.sum[k];
+        }
+        for ( size_t k = 0; k < sqr.size(); ++k ) {
+            sqr[k] += other.sqr[k];
+        }
+        for ( size_t k = 0; k < min.size(); ++k ) {
+            if ( other.min[k] < min[k] ||
+                 ( request.loc && other.min[k] == min[k] && other.min_node[k] >= 0 &&
+                   ( min_node[k] < 0 || glb_idx( other.min_node[k] ) < glb_idx( min_node[k] ) ) ) ) {
+                min[k] = other.min[k];
+                if ( request.loc ) min_node[k] = other.min_node[k];
+            }
+        }
+        for ( size_t k = 0; k < max.size(); ++k ) {
+            if ( other.max[k] > max[k] ||
+                 ( request.loc && other.max[k] == max[k] && other.max_node[k] >= 0 &&
+                   ( max_node[k] < 0 || glb_idx( other.max_node[k] ) < glb_idx( max_node[k] ) ) ) ) {
+                max[k] = other.max[k];
+                if ( request.loc ) max_node[k] = other.max_node[k];
+            }
+        }
+    }
+};
+
+class StatisticsAccumulator {
+public:
+    virtual ~StatisticsAccumulator() {}
+    size_t levels() const { return levels_; }
+    size_t variables() const { return variables_; }
+    size_t size() const { return levels_ * variables_; }
+    const std::vector<double>& reference() const { return reference_; }
+    virtual void accumulate( const idx_t owned[], size_t begin, size_t end, StatisticsPartial& ) const = 0;
+
+protected:
+    size_t levels_;
+    size_t variables_;
+    std::vector<double> reference_;
+};
+
+template <typename T>
+class StatisticsAccumulatorT : public StatisticsAccumulator {
+public:
+    StatisticsAccumulatorT( const Field& field, const std::vector<idx_t>& owned, const StatisticsRequest& request,
+                            const array::ArrayView<gidx_t, 1>& glb_idx ) :
+        values_( make_leveled_view<T>( field ) ),
+        request_( request ),
+        glb_idx_( glb_idx ) {
+        levels_    = values_.shape( 1 );
+        variables_ = values_.shape( 2 );
+        ASSERT( owned.empty() || size_t( owned.back() ) < values_.shape( 0 ) );
+
+        // Values are accumulated relative to the first owned value, to avoid loss of precision in the sum of squares
+        reference_.assign( size(), 0. );
+        if ( owned.size() ) {
+            for ( size_t l = 0; l < levels_; ++l ) {
+                for ( size_t j = 0; j < variables_; ++j ) {
+                    reference_[l * variables_ + j] = values_( owned.front(), l, j );
+                }
+            }
+        }
+    }
+
+    virtual void accumulate( const idx_t owned[], size_t begin, size_t end, StatisticsPartial& p ) const {
+        for ( size_t i = begin; i < end; ++i ) {
+            const idx_t n = owned[i];
+            for ( size_t l = 0; l < levels_; ++l ) {
+                for ( size_t j = 0; j < variables_; ++j ) {
+                    const size_t k = l * variables_ + j;
+                    const double v = values_( n, l, j );
+                    if ( request_.sum ) {
+                        const double d = v - reference_[k];
+                        p.sum[k] += d;
+                        if ( request_.sqr ) p.sqr[k] += d * d;
+                    }
+                    if ( request_.min ) {
+                        if ( v < p.min[k] ) {
+                            p.min[k] = v;
+                            if ( request_.loc ) p.min_node[k] = n;
+                        }
+                        else if ( request_.loc && v == p.min[k] && glb_idx_( n ) < glb_idx_( p.min_node[k] ) ) {
+                            p.min_node[k] = n;
+                        }
+                    }
+                    if ( request_.max ) {
+                        if ( v > p.max[k] ) {
+                            p.max[k] = v;
+                            if ( request_.loc ) p.max_node[k] = n;
+                        }
+                        else if ( request_.loc && v == p.max[k] && glb_idx_( n ) < glb_idx_( p.max_node[k] ) ) {
+                            p.max_node[k] = n;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    const array::LocalView<T, 3> values_;
+    const StatisticsRequest request_;
+    const array::ArrayView<gidx_t, 1> glb_idx_;
+};
+
+StatisticsAccumulator* make_statistics_accumulator( const Field& field, const std::vector<idx_t>& owned,
+                                                    const StatisticsRequest& request,
+                                                    const array::ArrayView<gidx_t, 1>& glb_idx ) {
+    switch ( field.datatype().kind() ) {
+        case array::DataType::KIND_INT32:
+            return new StatisticsAccumulatorT<int>( field, owned, request, glb_idx );
+        case array::DataType::KIND_INT64:
+            return new StatisticsAccumulatorT<long>( field, owned, request, glb_idx );
+        case array::DataType::KIND_REAL32:
+            return new StatisticsAccumulatorT<float>( field, owned, request, glb_idx );
+        case array::DataType::KIND_REAL64:
+            return new StatisticsAccumulatorT<double>( field, owned, request, glb_idx );
+        default:
+            throw eckit::Exception( "datatype not supported", Here() );
+    }
+}
+
+}  // namespace
+
+std::vector<NodeColumnsStatistics> NodeColumns::statistics( const FieldSet& fieldset, unsigned selection ) const {
+    ATLAS_TRACE( "NodeColumns::statistics" );
+    using Statistics = NodeColumnsStatistics;
+
+    if ( selection & Statistics::STDDEV ) selection |= Statistics::MEAN;
+    StatisticsRequest request;
+    request.sum = selection & ( Statistics::SUM | Statistics::MEAN );
+    request.sqr = selection & Statistics::STDDEV;
+    request.min = selection & Statistics::MINIMUM;
+    request.max = selection & Statistics::MAXIMUM;
+    request.loc = ( selection & Statistics::LOCATION ) && ( request.min || request.max );
+
+    const std::vector<idx_t>& owned = owned_nodes();
+    const size_t nb_owned           = owned.size();
+    const size_t nb_fields          = fieldset.size();
+    const auto glb_idx              = array::make_view<gidx_t, 1>( nodes_.global_index() );
+
+    std::vector<std::unique_ptr<StatisticsAccumulator>> accumulators( nb_fields );
+    for ( size_t f = 0; f < nb_fields; ++f ) {
+        accumulators[f].reset( make_statistics_accumulator( fieldset[f], owned, request, glb_idx ) );
+    }
+
+    // Each thread accumulates a contiguous range of owned nodes for all fields into its own partials
+    std::vector<std::vector<StatisticsPartial>> partials( atlas_omp_get_max_threads() );
+    atlas_omp_parallel {
+        const size_t nb_threads = atlas_omp_get_num_threads();
+        const size_t thread     = atlas_omp_get_thread_num();
+        const size_t begin      = ( nb_owned * thread ) / nb_threads;
+        const size_t end        = ( nb_owned * ( thread + 1 ) ) / nb_threads;
+
+        std::vector<StatisticsPartial>& partial = partials[thread];
+        partial.resize( nb_fields );
+        for ( size_t f = 0; f < nb_fields; ++f ) {
+            partial[f].reset( accumulators[f]->size(), request );
+            accumulators[f]->accumulate( owned.data(), begin, end, partial[f] );
+        }
+    }
+    std::vector<StatisticsPartial>& local = partials[0];
+    for ( size_t t = 1; t < partials.size(); ++t ) {
+        for ( size_t f = 0; f < partials[t].size(); ++f ) {
+            local[f].merge( partials[t][f], request, glb_idx );
+        }
+    }
+
+    // Pack all sums in one buffer, and all minima and negated maxima in another.
+    // For the standard deviation, keep the mean and the sum of squared deviations from the mean (M2) of this
+    // partition, for each level and field-variable.
+    std::vector<double> sums;
+    std::vector<double> extrema;
+    std::vector<double> moments;
+    for ( size_t f = 0; f < nb_fields; ++f ) {
+        const StatisticsPartial& p           = local[f];
+        const std::vector<double>& reference = accumulators[f]->reference();
+        const double n                       = nb_owned;
+        for ( size_t k = 0; k < accumulators[f]->size(); ++k ) {
+            if ( request.sum ) { sums.push_back( n * reference[k] + p.sum[k] ); }
+            if ( request.sqr ) {
+                moments.push_back( nb_owned ? reference[k] + p.sum[k] / n : 0. );
+                moments.push_back( nb_owned ? p.sqr[k] - p.sum[k] * p.sum[k] / n : 0. );
+            }
+            if ( request.min ) { extrema.push_back( p.min[k] ); }
+            if ( request.max ) { extrema.push_back( -p.max[k] ); }
+        }
+    }
+    ATLAS_TRACE_MPI( ALLREDUCE ) {
+        if ( sums.size() ) { mpi::comm().allReduceInPlace( sums.data(), sums.size(), eckit::mpi::sum() ); }
+        if ( extrema.size() ) { mpi::comm().allReduceInPlace( extrema.data(), extrema.size(), eckit::mpi::min() ); }
+    }
+
+    // The global M2 is the sum over partitions of M2 + n * ( mean - global mean )^2, with the global mean taken
+    // from the reduced sums. Reducing a raw sum of squares instead would suffer from cancellation for fields with
+    // a large offset compared to their variance.
+    std::vector<double> M2;
+    if ( request.sqr ) {
+        const double N = nb_nodes_global();
+        M2.resize( sums.size() );
+        for ( size_t k = 0; k < M2.size(); ++k ) {
+            const double delta = moments[2 * k] - sums[k] / N;
+            M2[k]              = moments[2 * k + 1] + ( nb_owned ? nb_owned * delta * delta : 0. );
+        }
+        ATLAS_TRACE_MPI( ALLREDUCE ) { mpi::comm().allReduceInPlace( M2.data(), M2.size(), eckit::mpi::sum() ); }
+    }
+
+    // Only partitions that contain the global extremum propose their location
+    std::vector<gidx_t> locations;
+    if ( request.loc ) {
+        const gidx_t none = std::numeric_limits<gidx_t>::max();
+        size_t e          = 0;
+        for ( size_t f = 0; f < nb_fields; ++f ) {
+            const StatisticsPartial& p = local[f];
+            for ( size_t k = 0; k < accumulators[f]->size(); ++k ) {
+                if ( request.min ) {
+                    const bool found = p.min_node[k] >= 0 && p.min[k] == extrema[e++];
+                    locations.push_back( found ? glb_idx( p.min_node[k] ) : none );
+                }
+                if ( request.max ) {
+                    const bool found = p.max_node[k] >= 0 && -p.max[k] == extrema[e++];
+                    locations.push_back( found ? glb_idx( p.max_node[k] ) : none );
+                }
+            }
+        }
+        ATLAS_TRACE_MPI( ALLREDUCE ) {
+            mpi::comm().allReduceInPlace( locations.data(), locations.size(), eckit::mpi::min() );
+        }
+    }
+
+    std::vector<Statistics> result( nb_fields );
+    const double N = nb_nodes_global();
+    size_t s       = 0;
+    size_t e       = 0;
+    size_t m       = 0;
+    for ( size_t f = 0; f < nb_fields; ++f ) {
+        Statistics& stats  = result[f];
+        const size_t size  = accumulators[f]->size();
+        stats.name         = fieldset[f].name();
+        stats.levels       = accumulators[f]->levels();
+        stats.variables    = accumulators[f]->variables();
+        stats.N            = nb_nodes_global();
+        if ( selection & Statistics::SUM ) stats.sum.resize( size );
+        if ( selection & Statistics::MEAN ) stats.mean.resize( size );
+        if ( request.sqr ) stats.stddev.resize( size );
+        if ( request.min ) stats.minimum.resize( size );
+        if ( request.max ) stats.maximum.resize( size );
+        if ( request.loc && request.min ) {
+            stats.minimum_glb_idx.resize( size );
+            stats.minimum_level.resize( size );
+        }
+        if ( request.loc && request.max ) {
+            stats.maximum_glb_idx.resize( size );
+            stats.maximum_level.resize( size );
+        }
+        for ( size_t k = 0; k < size; ++k ) {
+            const size_t level = k / stats.variables;
+            if ( request.sum ) {
+                const double sum = sums[s++];
+                if ( stats.sum.size() ) stats.sum[k] = sum;
+                if ( stats.mean.size() ) stats.mean[k] = sum / N;
+            }
+            if ( request.sqr ) {
+                stats.stddev[k] = std::sqrt( std::max( M2[m++] / N, 0. ) );
+            }
+            if ( request.min ) {
+                stats.minimum[k] = extrema[e];
+                if ( request.loc ) {
+                    stats.minimum_glb_idx[k] = locations[e];
+                    stats.minimum_level[k]   = level;
+                }
+                ++e;
+            }
+            if ( request.max ) {
+                stats.maximum[k] = -extrema[e];
+                if ( request.loc ) {
+                    stats.maximum_glb_idx[k] = locations[e];
+                    stats.maximum_level[k]   = level;
+                }
+                ++e;
+            }
+        }
+    }
+    return result;
+}
+
+NodeColumnsStatistics NodeColumns::statistics( const Field& field, unsigned selection ) const {
+    FieldSet fieldset;
+    fieldset.add( field );
+    return statistics( fieldset, selection ).front();
+}
+
 template <typename Value>
 NodeColumns::FieldStatisticsT<Value>::FieldStatisticsT( const NodeColumns* f ) : functionspace( *f ) {}
 
@@ -2158,5 +2611,98 @@ const parallel::Checksum& NodeColumns::checksum() const {
     return functionspace_->checksum();
 }
 
+const std::vector<idx_t>& NodeColumns::interior_nodes( size_t depth ) const {
+    return functionspace_->interior_nodes( depth );
+}
+
+const std::vector<idx_t>& NodeColumns::boundary_nodes( size_t depth ) const {
+    return functionspace_->boundary_nodes( depth );
+}
+
+const std::vector<idx_t>& NodeColumns::interior_edges( size_t depth ) const {
+    return functionspace_->interior_edges( depth );
+}
+
+const std::vector<idx_t>& NodeColumns::boundary_edges( size_t depth ) const {
+    return functionspace_->boundary_edges( depth );
+}
+
+std::vector<NodeColumnsStatistics> NodeColumns::statistics( const FieldSet& fieldset, unsigned selection ) const {
+    return functionspace_->statistics( fieldset, selection );
+}
+
+NodeColumnsStatistics NodeColumns::statistics( const Field& field, unsigned selection ) const {
+    return functionspace_->statistics( field, selection );
+}
+
+// -------------------------------------------------------------------
+
+NodeColumnsStatistics NodeColumnsStatistics::reduce_levels() const {
+    NodeColumnsStatistics column;
+    column.name      = name;
+    column.levels    = 1;
+    column.variables = variables;
+    column.N         = N * levels;
+
+    if ( sum.size() ) { column.sum.assign( variables, 0. ); }
+    if ( mean.size() ) { column.mean.assign( variables, 0. ); }
+    if ( stddev.size() ) { column.stddev.assign( variables, 0. ); }
+    if ( minimum.size() ) { column.minimum.assign( variables, std::numeric_limits<double>::max() ); }
+    if ( maximum.size() ) { column.maximum.assign( variables, -std::numeric_limits<double>::max() ); }
+    if ( minimum_glb_idx.size() ) {
+        column.minimum_glb_idx.assign( variables, std::numeric_limits<gidx_t>::max() );
+        column.minimum_level.assign( variables, 0 );
+    }
+    if ( maximum_glb_idx.size() ) {
+        column.maximum_glb_idx.assign( variables, std::numeric_limits<gidx_t>::max() );
+        column.maximum_level.assign( variables, 0 );
+    }
+
+    for ( size_t l = 0; l < levels; ++l ) {
+        for ( size_t j = 0; j < variables; ++j ) {
+            const size_t k = l * variables + j;
+            if ( sum.size() ) { column.sum[j] += sum[k]; }
+            if ( mean.size() ) { column.mean[j] += mean[k] / levels; }
+            if ( minimum.size() ) {
+                const bool tie = minimum_glb_idx.size() && minimum[k] == column.minimum[j] &&
+                                 minimum_glb_idx[k] < column.minimum_glb_idx[j];
+                if ( minimum[k] < column.minimum[j] || tie ) {
+                    column.minimum[j] = minimum[k];
+                    if ( minimum_glb_idx.size() ) {
+                        column.minimum_glb_idx[j] = minimum_glb_idx[k];
+                        column.minimum_level[j]   = minimum_level[k];
+                    }
+                }
+            }
+            if ( maximum.size() ) {
+                const bool tie = maximum_glb_idx.size() && maximum[k] == column.maximum[j] &&
+                                 maximum_glb_idx[k] < column.maximum_glb_idx[j];
+                if ( maximum[k] > column.maximum[j] || tie ) {
+                    column.maximum[j] = maximum[k];
+                    if ( maximum_glb_idx.size() ) {
+                        column.maximum_glb_idx[j] = maximum_glb_idx[k];
+                        column.maximum_level[j]   = maximum_level[k];
+                    }
+                }
+            }
+        }
+    }
+
+    // Variance over all levels, from the variance and mean of each level which have equal number of values
+    if ( stddev.size() ) {
+        for ( size_t l = 0; l < levels; ++l ) {
+            for ( size_t j = 0; j < variables; ++j ) {
+                const size_t k = l * variables + j;
+                const double deviation = mean[k] - column.mean[j];
+                column.stddev[j] += ( stddev[k] * stddev[k] + deviation * deviation ) / levels;
+            }
+        }
+        for ( size_t j = 0; j < variables; ++j ) {
+            column.stddev[j] = std::sqrt( column.stddev[j] );
+        }
+    }
+    return column;
+}
+
 }  // namespace functionspace
 }  // namespace atlas
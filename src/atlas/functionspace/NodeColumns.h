@@ -10,6 +10,10 @@
 
 #pragma once
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include "eckit/memory/SharedPtr.h"
 
 #include "atlas/field/FieldSet.h"
@@ -42,6 +46,47 @@ class Checksum;
 
 namespace atlas {
 namespace functionspace {
+
+// ----------------------------------------------------------------------------
+
+/// @brief Statistics of a field over the owned nodes, as computed by NodeColumns::statistics()
+///
+/// Statistics are computed in double precision for each vertical level and field-variable separately,
+/// and stored with index [ level * variables + variable ]. Only the requested statistics are filled in.
+struct NodeColumnsStatistics {
+    enum Selection : unsigned
+    {
+        SUM      = 1 << 0,
+        MEAN     = 1 << 1,
+        STDDEV   = 1 << 2,  ///< Implies MEAN
+        MINIMUM  = 1 << 3,
+        MAXIMUM  = 1 << 4,
+        LOCATION = 1 << 5,  ///< Global index and level of MINIMUM and MAXIMUM
+        ALL      = SUM | MEAN | STDDEV | MINIMUM | MAXIMUM | LOCATION
+    };
+
+    std::string name;     ///< Name of the field
+    size_t levels{0};     ///< Number of levels, 1 for fields without levels
+    size_t variables{0};  ///< Number of field-variables, 1 for fields without variables
+    size_t N{0};          ///< Number of values contained in each statistic
+
+    std::vector<double> sum;
+    std::vector<double> mean;
+    std::vector<double> stddev;
+    std::vector<double> minimum;
+    std::vector<double> maximum;
+    std::vector<gidx_t> minimum_glb_idx;
+    std::vector<gidx_t> maximum_glb_idx;
+    std::vector<size_t> minimum_level;
+    std::vector<size_t> maximum_level;
+
+    /// @brief Combine the statistics of all levels, for each field-variable
+    /// @return Statistics with levels == 1, indexed by field-variable
+    NodeColumnsStatistics reduce_levels() const;
+};
+
+// ----------------------------------------------------------------------------
+
 namespace detail {
 
 // ----------------------------------------------------------------------------
@@ -96,6 +141,38 @@ public:
     std::string checksum( const Field& ) const;
     const parallel::Checksum& checksum() const;
 
+    // -- Compute-communication overlap
+
+    /// @brief Owned nodes of which all nodes within given number of edges are owned.
+    /// Stencils of these nodes do not depend on halo data, so they can be computed while a halo exchange is in flight.
+    const std::vector<idx_t>& interior_nodes( size_t depth = 1 ) const;
+
+    /// @brief Owned nodes of which the stencil of given depth contains ghost nodes
+    const std::vector<idx_t>& boundary_nodes( size_t depth = 1 ) const;
+
+    /// @brief Edges of which both nodes are interior nodes for depth-1, i.e. for depth 1 edges between owned nodes
+    const std::vector<idx_t>& interior_edges( size_t depth = 1 ) const;
+
+    /// @brief Remaining edges, which depend on halo data
+    const std::vector<idx_t>& boundary_edges( size_t depth = 1 ) const;
+
+    /// @brief Nodes that are not ghost nodes, i.e. nodes owned by this partition
+    const std::vector<idx_t>& owned_nodes() const;
+
+    /// @brief Compute selected statistics for all fields of a FieldSet in a single pass over the owned nodes
+    ///
+    /// Threads accumulate private partial results which are combined without synchronisation, after which all
+    /// sums are reduced across MPI tasks in one packed reduction, and all extrema in another one.
+    /// For the standard deviation, a second sum reduction combines the squared deviations of each partition
+    /// about the global mean, which avoids cancellation for fields with a large offset.
+    /// @param [in] selection  Combination of NodeColumnsStatistics::Selection flags
+    /// @return Statistics for each field, in order of the FieldSet
+    std::vector<NodeColumnsStatistics> statistics( const FieldSet&,
+                                                   unsigned selection = NodeColumnsStatistics::ALL ) const;
+
+    /// @brief Compute selected statistics for one field, see statistics( const FieldSet&, unsigned )
+    NodeColumnsStatistics statistics( const Field&, unsigned selection = NodeColumnsStatistics::ALL ) const;
+
     /// @brief Compute sum of scalar field
     /// @param [out] sum    Scalar value containing the sum of the full 3D field
     /// @param [out] N      Number of values that are contained in the sum
@@ -264,6 +341,14 @@ private:  // methods
 
     size_t footprint() const;
 
+    struct StencilClassification {
+        std::vector<idx_t> interior_nodes;
+        std::vector<idx_t> boundary_nodes;
+        std::vector<idx_t> interior_edges;
+        std::vector<idx_t> boundary_edges;
+    };
+    const StencilClassification& stencil_classification( size_t depth ) const;
+
 private:                  // data
     Mesh mesh_;           // non-const because functionspace may modify mesh
     mesh::Nodes& nodes_;  // non-const because functionspace may modify mesh
@@ -275,6 +360,9 @@ private:                  // data
     mutable eckit::SharedPtr<parallel::GatherScatter> gather_scatter_;  // without ghost
     mutable eckit::SharedPtr<parallel::HaloExchange> halo_exchange_;
     mutable eckit::SharedPtr<parallel::Checksum> checksum_;
+    mutable std::map<size_t, StencilClassification> stencil_classifications_;
+    mutable std::vector<idx_t> owned_nodes_;
+    mutable bool owned_nodes_computed_{false};
 
 private:
     template <typename Value>
@@ -484,6 +572,31 @@ public:
     std::string checksum( const Field& ) const;
     const parallel::Checksum& checksum() const;
 
+    // -- Compute-communication overlap
+
+    /// @brief Owned nodes of which all nodes within given number of edges are owned.
+    /// Stencils of these nodes do not depend on halo data, so they can be computed while a halo exchange is in flight.
+    const std::vector<idx_t>& interior_nodes( size_t depth = 1 ) const;
+
+    /// @brief Owned nodes of which the stencil of given depth contains ghost nodes
+    const std::vector<idx_t>& boundary_nodes( size_t depth = 1 ) const;
+
+    /// @brief Edges of which both nodes are interior nodes for depth-1, i.e. for depth 1 edges between owned nodes
+    const std::vector<idx_t>& interior_edges( size_t depth = 1 ) const;
+
+    /// @brief Remaining edges, which depend on halo data
+    const std::vector<idx_t>& boundary_edges( size_t depth = 1 ) const;
+
+    /// @brief Compute selected statistics for all fields of a FieldSet in a single pass over the owned nodes,
+    /// with one MPI reduction for all sums and one for all extrema, plus one for the standard deviation
+    /// @param [in] selection  Combination of NodeColumnsStatistics::Selection flags
+    /// @return Statistics for each field, in order of the FieldSet
+    std::vector<NodeColumnsStatistics> statistics( const FieldSet&,
+                                                   unsigned selection = NodeColumnsStatistics::ALL ) const;
+
+    /// @brief Compute selected statistics for one field
+    NodeColumnsStatistics statistics( const Field&, unsigned selection = NodeColumnsStatistics::ALL ) const;
+
     /// @brief Compute sum of scalar field
     /// @param [out] sum    Scalar value containing the sum of the full 3D field
     /// @param [out] N      Number of values that are contained in the sum
@@ -8,19 +8,26 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
+#include <cmath>
+
 #include "eckit/os/BackTrace.h"
 #include "eckit/utils/MD5.h"
+#include "eckit/utils/Translator.h"
 
+#include "atlas/array/Allocator.h"
 #include "atlas/array/MakeView.h"
 #include "atlas/field/FieldSet.h"
 #include "atlas/field/detail/FieldImpl.h"
 #include "atlas/functionspace/Spectral.h"
 #include "atlas/mesh/Mesh.h"
 #include "atlas/option.h"
+#include "atlas/parallel/mpi/Statistics.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/runtime/ErrorHandling.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/trans/Trans.h"
+#include "atlas/util/Checksum.h"
 
 
 #if ATLAS_HAVE_TRANS
@@ -42,39 +49,202 @@ namespace atlas {
 namespace functionspace {
 namespace detail {
 
-#if ATLAS_HAVE_TRANS
+// Spectral coefficients are ordered by zonal wavenumber m = 0..T, then total wavenumber n = m..T,
+// then real and imaginary part, and finally levels (fastest).
+//
+// The native parallelisation distributes the zonal wavenumbers over tasks in a "snake" round-robin
+// (0,1,..,P-1,P-1,..,1,0,0,1,..), which balances the decreasing number of coefficients per m.
+// Each task stores the coefficients of its own zonal wavenumbers contiguously, in increasing m.
 class Spectral::Parallelisation {
 public:
-    Parallelisation( const std::shared_ptr<::Trans_t> other ) : trans_( other ) {}
+    Parallelisation( int truncation ) : truncation_( truncation ) {
+        const size_t nproc  = mpi::comm().size();
+        const size_t mypart = mpi::comm().rank();
+        nb_coefficients_.assign( nproc, 0 );
+        for ( int m = 0; m <= truncation_; ++m ) {
+            size_t owner = zonal_wavenumber_owner( m );
+            nb_coefficients_[owner] += nb_coefficients( m );
+            if ( owner == mypart ) { zonal_wavenumbers_.push_back( m ); }
+        }
+    }
+
+#if ATLAS_HAVE_TRANS
+    Parallelisation( const std::shared_ptr<::Trans_t> other, int truncation ) :
+        truncation_( truncation ),
+        trans_( other ) {
+        // On a single task, the trans library stores all coefficients in the global order
+        if ( mpi::comm().size() == 1 ) {
+            for ( int m = 0; m <= truncation_; ++m ) {
+                zonal_wavenumbers_.push_back( m );
+            }
+        }
+    }
 
-    Parallelisation( int truncation ) {
-        trans_ = std::shared_ptr<::Trans_t>( new ::Trans_t, [](::Trans_t* p ) {
+    static Parallelisation* create_trans( int truncation ) {
+        auto trans = std::shared_ptr<::Trans_t>( new ::Trans_t, [](::Trans_t* p ) {
             TRANS_CHECK(::trans_delete( p ) );
             delete p;
         } );
-        TRANS_CHECK(::trans_new( trans_.get() ) );
-        TRANS_CHECK(::trans_set_trunc( trans_.get(), truncation ) );
+        TRANS_CHECK(::trans_new( trans.get() ) );
+        TRANS_CHECK(::trans_set_trunc( trans.get(), truncation ) );
         TRANS_CHECK(::trans_use_mpi( mpi::comm().size() > 1 ) );
-        TRANS_CHECK(::trans_setup( trans_.get() ) );
+        TRANS_CHECK(::trans_setup( trans.get() ) );
+        return new Parallelisation( trans, truncation );
     }
 
-    int nb_spectral_coefficients_global() const { return trans_->nspec2g; }
-    int nb_spectral_coefficients() const { return trans_->nspec2; }
-
-    std::string distribution() const { return "trans"; }
+    bool native() const { return not trans_; }
+    int nb_spectral_coefficients() const { return native() ? nb_coefficients_[mpi::comm().rank()] : trans_->nspec2; }
     operator ::Trans_t*() const { return trans_.get(); }
-    std::shared_ptr<::Trans_t> trans_;
-};
 #else
-class Spectral::Parallelisation {
-public:
-    Parallelisation( int truncation ) : truncation_( truncation ) {}
+    bool native() const { return true; }
+    int nb_spectral_coefficients() const { return nb_coefficients_[mpi::comm().rank()]; }
+#endif
+
     int nb_spectral_coefficients_global() const { return ( truncation_ + 1 ) * ( truncation_ + 2 ); }
-    int nb_spectral_coefficients() const { return nb_spectral_coefficients_global(); }
+
+    std::string distribution() const {
+        if ( not native() ) { return "trans"; }
+        return mpi::comm().size() == 1 ? "serial" : "zonal_wavenumber";
+    }
+
+    /// Zonal wavenumbers on this task, in storage order. Empty if the trans library distributes them.
+    const std::vector<int>& zonal_wavenumbers() const { return zonal_wavenumbers_; }
+
+    void gather( const Field& loc, Field& glb, size_t root ) const;
+    void scatter( const Field& glb, Field& loc, size_t root ) const;
+    void norm( const Field&, double norm_per_level[], size_t root ) const;
+    util::checksum_t checksum( const Field& ) const;
+
+private:
+    size_t zonal_wavenumber_owner( int m ) const {
+        const size_t nproc = mpi::comm().size();
+        const size_t cycle = m / nproc;
+        const size_t r     = m % nproc;
+        return ( cycle % 2 == 0 ) ? r : nproc - 1 - r;
+    }
+
+    /// Number of coefficients (real and imaginary parts) with zonal wavenumber m
+    size_t nb_coefficients( int m ) const { return 2 * ( truncation_ + 1 - m ); }
+
+    /// Offset of the first coefficient with zonal wavenumber m in a global field
+    size_t global_offset( int m ) const { return 2 * ( m * ( truncation_ + 1 ) - ( m * ( m - 1 ) ) / 2 ); }
+
+    /// Calls copy( offset in buffer ordered by task, offset in global field, size ) for each zonal wavenumber
+    template <typename Copy>
+    void for_each_zonal_wavenumber( const std::vector<int>& displs, Copy copy ) const {
+        std::vector<int> offset( displs );
+        for ( int m = 0; m <= truncation_; ++m ) {
+            size_t owner = zonal_wavenumber_owner( m );
+            copy( offset[owner], global_offset( m ), nb_coefficients( m ) );
+            offset[owner] += nb_coefficients( m );
+        }
+    }
+
     int truncation_;
-    std::string distribution() const { return "serial"; }
-};
+    std::vector<int> zonal_wavenumbers_;
+    std::vector<int> nb_coefficients_;
+#if ATLAS_HAVE_TRANS
+    std::shared_ptr<::Trans_t> trans_;
 #endif
+};
+
+namespace {
+size_t nb_fields( const Field& field ) {
+    return field.rank() > 1 ? field.stride( 0 ) : 1;
+}
+}  // namespace
+
+void Spectral::Parallelisation::gather( const Field& loc, Field& glb, size_t root ) const {
+    const size_t nproc = mpi::comm().size();
+    const size_t nfld  = nb_fields( loc );
+    std::vector<int> counts( nproc );
+    std::vector<int> displs( nproc, 0 );
+    for ( size_t jpart = 0; jpart < nproc; ++jpart ) {
+        counts[jpart] = nb_coefficients_[jpart] * nfld;
+        if ( jpart > 0 ) { displs[jpart] = displs[jpart - 1] + counts[jpart - 1]; }
+    }
+
+    const bool is_root = mpi::comm().rank() == root;
+    array::Arena arena;
+    double* recv = arena.allocate<double>( is_root ? nb_spectral_coefficients_global() * nfld : 0 );
+    ATLAS_TRACE_MPI( GATHER ) {
+        mpi::comm().gatherv( loc.data<double>(), counts[mpi::comm().rank()], recv, counts.data(), displs.data(),
+                             root );
+    }
+    if ( is_root ) {
+        double* g = glb.data<double>();
+        for_each_zonal_wavenumber( displs, [&]( size_t offset, size_t glb_offset, size_t size ) {
+            std::copy( recv + offset, recv + offset + size * nfld, g + glb_offset * nfld );
+        } );
+    }
+}
+
+void Spectral::Parallelisation::scatter( const Field& glb, Field& loc, size_t root ) const {
+    const size_t nproc = mpi::comm().size();
+    const size_t nfld  = nb_fields( loc );
+    std::vector<int> counts( nproc );
+    std::vector<int> displs( nproc, 0 );
+    for ( size_t jpart = 0; jpart < nproc; ++jpart ) {
+        counts[jpart] = nb_coefficients_[jpart] * nfld;
+        if ( jpart > 0 ) { displs[jpart] = displs[jpart - 1] + counts[jpart - 1]; }
+    }
+
+    const bool is_root = mpi::comm().rank() == root;
+    array::Arena arena;
+    double* send = arena.allocate<double>( is_root ? nb_spectral_coefficients_global() * nfld : 0 );
+    if ( is_root ) {
+        const double* g = glb.data<double>();
+        for_each_zonal_wavenumber( displs, [&]( size_t offset, size_t glb_offset, size_t size ) {
+            std::copy( g + glb_offset * nfld, g + ( glb_offset + size ) * nfld, send + offset );
+        } );
+    }
+    ATLAS_TRACE_MPI( SCATTER ) {
+        mpi::comm().scatterv( send, counts.data(), displs.data(), loc.data<double>(), counts[mpi::comm().rank()],
+                              root );
+    }
+}
+
+void Spectral::Parallelisation::norm( const Field& field, double norm_per_level[], size_t root ) const {
+    // Same definition as the trans library: coefficients with m > 0 count twice, for -m
+    const size_t nfld = nb_fields( field );
+    std::vector<double> sum( nfld, 0. );
+    const double* data = field.data<double>();
+    size_t offset      = 0;
+    for ( int m : zonal_wavenumbers_ ) {
+        const double weight = ( m == 0 ) ? 1. : 2.;
+        for ( size_t jc = 0; jc < nb_coefficients( m ); ++jc, ++offset ) {
+            for ( size_t jfld = 0; jfld < nfld; ++jfld ) {
+                const double value = data[offset * nfld + jfld];
+                sum[jfld] += weight * value * value;
+            }
+        }
+    }
+    ATLAS_TRACE_MPI( REDUCE ) { mpi::comm().reduceInPlace( sum.data(), nfld, eckit::mpi::sum(), root ); }
+    if ( mpi::comm().rank() == root ) {
+        for ( size_t jfld = 0; jfld < nfld; ++jfld ) {
+            norm_per_level[jfld] = std::sqrt( sum[jfld] );
+        }
+    }
+}
+
+util::checksum_t Spectral::Parallelisation::checksum( const Field& field ) const {
+    // Each coefficient is hashed with its global index, see parallel::Checksum
+    const size_t nfld  = nb_fields( field );
+    const double* data = field.data<double>();
+    size_t offset      = 0;
+    util::checksum_t local_checksum( 0 );
+    for ( int m : zonal_wavenumbers_ ) {
+        const size_t glb_offset = global_offset( m );
+        for ( size_t jc = 0; jc < nb_coefficients( m ); ++jc, ++offset ) {
+            local_checksum += util::hash( glb_offset + jc, data + offset * nfld, nfld );
+        }
+    }
+    util::checksum_t checksum;
+    ATLAS_TRACE_MPI( ALLREDUCE ) { mpi::comm().allReduce( local_checksum, checksum, eckit::mpi::sum() ); }
+    return checksum;
+}
+
+// ----------------------------------------------------------------------
 
 void Spectral::set_field_metadata( const eckit::Configuration& config, Field& field ) const {
     field.set_functionspace( this );
@@ -115,19 +285,24 @@ Spectral::Spectral( const eckit::Configuration& config ) :
 
 Spectral::Spectral( const int truncation, const eckit::Configuration& config ) :
     truncation_( truncation ),
+#if ATLAS_HAVE_TRANS
+    parallelisation_( Parallelisation::create_trans( truncation_ ) ),
+#else
     parallelisation_( new Parallelisation( truncation_ ) ),
+#endif
     nb_levels_( 0 ) {
     config.get( "levels", nb_levels_ );
 }
 
 Spectral::Spectral( const trans::Trans& trans, const eckit::Configuration& config ) :
     truncation_( trans.truncation() ),
+    nb_levels_( 0 ) {
 #if ATLAS_HAVE_TRANS
-    parallelisation_( new Parallelisation( dynamic_cast<const trans::TransIFS&>( *trans.get() ).trans_ ) ),
-#else
-    parallelisation_( new Parallelisation( truncation_ ) ),
+    if ( auto transIFS = dynamic_cast<const trans::TransIFS*>( trans.get() ) ) {
+        parallelisation_.reset( new Parallelisation( transIFS->trans_, truncation_ ) );
+    }
 #endif
-    nb_levels_( 0 ) {
+    if ( not parallelisation_ ) { parallelisation_.reset( new Parallelisation( truncation_ ) ); }
     config.get( "levels", nb_levels_ );
 }
 
@@ -188,6 +363,13 @@ Field Spectral::createField( const Field& other, const eckit::Configuration& con
     return createField( option::datatype( other.datatype() ) | option::levels( other.levels() ) | config );
 }
 
+const std::vector<int>& Spectral::zonal_wavenumbers() const {
+    if ( not parallelisation_->native() && mpi::comm().size() > 1 ) {
+        throw eckit::NotImplemented( "Zonal wavenumbers are distributed by the trans library", Here() );
+    }
+    return parallelisation_->zonal_wavenumbers();
+}
+
 void Spectral::gather( const FieldSet& local_fieldset, FieldSet& global_fieldset ) const {
     ASSERT( local_fieldset.size() == global_fieldset.size() );
 
@@ -200,12 +382,18 @@ void Spectral::gather( const FieldSet& local_fieldset, FieldSet& global_fieldset
             throw eckit::BadValue( err.str() );
         }
 
-#if ATLAS_HAVE_TRANS
         Field& glb  = global_fieldset[f];
         size_t root = 0;
         glb.metadata().get( "owner", root );
         ASSERT( loc.shape( 0 ) == nb_spectral_coefficients() );
         if ( mpi::comm().rank() == root ) ASSERT( glb.shape( 0 ) == nb_spectral_coefficients_global() );
+
+        if ( parallelisation_->native() ) {
+            parallelisation_->gather( loc, glb, root );
+            continue;
+        }
+
+#if ATLAS_HAVE_TRANS
         std::vector<int> nto( 1, root + 1 );
         if ( loc.rank() > 1 ) {
             nto.resize( loc.stride( 0 ) );
@@ -219,11 +407,6 @@ void Spectral::gather( const FieldSet& local_fieldset, FieldSet& global_fieldset
         args.nto                 = nto.data();
         args.rspec               = loc.data<double>();
         TRANS_CHECK(::trans_gathspec( &args ) );
-#else
-
-        throw eckit::Exception(
-            "Cannot gather spectral fields because Atlas has "
-            "not been compiled with TRANS support." );
 #endif
     }
 }
@@ -248,32 +431,32 @@ void Spectral::scatter( const FieldSet& global_fieldset, FieldSet& local_fieldse
             throw eckit::BadValue( err.str() );
         }
 
-#if ATLAS_HAVE_TRANS
         size_t root = 0;
         glb.metadata().get( "owner", root );
         ASSERT( loc.shape( 0 ) == nb_spectral_coefficients() );
         if ( mpi::comm().rank() == root ) ASSERT( glb.shape( 0 ) == nb_spectral_coefficients_global() );
-        std::vector<int> nfrom( 1, root + 1 );
-        if ( loc.rank() > 1 ) {
-            nfrom.resize( loc.stride( 0 ) );
-            for ( size_t i = 0; i < nfrom.size(); ++i )
-                nfrom[i] = root + 1;
-        }
 
-        struct ::DistSpec_t args = new_distspec( *parallelisation_ );
-        args.nfld                = nfrom.size();
-        args.rspecg              = glb.data<double>();
-        args.nfrom               = nfrom.data();
-        args.rspec               = loc.data<double>();
-        TRANS_CHECK(::trans_distspec( &args ) );
+        if ( parallelisation_->native() ) { parallelisation_->scatter( glb, loc, root ); }
+#if ATLAS_HAVE_TRANS
+        else {
+            std::vector<int> nfrom( 1, root + 1 );
+            if ( loc.rank() > 1 ) {
+                nfrom.resize( loc.stride( 0 ) );
+                for ( size_t i = 0; i < nfrom.size(); ++i )
+                    nfrom[i] = root + 1;
+            }
+
+            struct ::DistSpec_t args = new_distspec( *parallelisation_ );
+            args.nfld                = nfrom.size();
+            args.rspecg              = glb.data<double>();
+            args.nfrom               = nfrom.data();
+            args.rspec               = loc.data<double>();
+            TRANS_CHECK(::trans_distspec( &args ) );
+        }
+#endif
 
         glb.metadata().broadcast( loc.metadata(), root );
         loc.metadata().set( "global", false );
-#else
-        throw eckit::Exception(
-            "Cannot scatter spectral fields because Atlas has "
-            "not been compiled with TRANS support." );
-#endif
     }
 }
 void Spectral::scatter( const Field& global, Field& local ) const {
@@ -286,7 +469,33 @@ void Spectral::scatter( const Field& global, Field& local ) const {
 
 std::string Spectral::checksum( const FieldSet& fieldset ) const {
     eckit::MD5 md5;
-    NOTIMP;
+    for ( size_t f = 0; f < fieldset.size(); ++f ) {
+        const Field& field = fieldset[f];
+        if ( field.datatype() != array::DataType::str<double>() ) {
+            std::stringstream err;
+            err << "Cannot checksum spectral field " << field.name() << " of datatype " << field.datatype().str()
+                << ".";
+            err << "Only " << array::DataType::str<double>() << " supported.";
+            throw eckit::BadValue( err.str() );
+        }
+        util::checksum_t checksum( 0 );
+        if ( parallelisation_->native() ) { checksum = parallelisation_->checksum( field ); }
+        else {
+            // Coefficients distributed by the trans library are hashed in global order on one task
+            const size_t root = 0;
+            Field global      = createField( field, option::global( root ) );
+            gather( field, global );
+            if ( mpi::comm().rank() == root ) {
+                const size_t nfld  = nb_fields( field );
+                const double* data = global.data<double>();
+                for ( size_t jc = 0; jc < nb_spectral_coefficients_global(); ++jc ) {
+                    checksum += util::hash( jc, data + jc * nfld, nfld );
+                }
+            }
+            ATLAS_TRACE_MPI( BROADCAST ) { mpi::comm().broadcast( checksum, root ); }
+        }
+        md5 << eckit::Translator<util::checksum_t, std::string>()( checksum );
+    }
     return md5;
 }
 std::string Spectral::checksum( const Field& field ) const {
@@ -296,49 +505,26 @@ std::string Spectral::checksum( const Field& field ) const {
 }
 
 void Spectral::norm( const Field& field, double& norm, int rank ) const {
-#if ATLAS_HAVE_TRANS
     ASSERT( std::max<int>( 1, field.levels() ) == 1 );
-    struct ::SpecNorm_t args = new_specnorm( *parallelisation_ );
-    args.nfld                = 1;
-    args.rspec               = field.data<double>();
-    args.rnorm               = &norm;
-    args.nmaster             = rank + 1;
-    TRANS_CHECK(::trans_specnorm( &args ) );
-#else
-    throw eckit::Exception(
-        "Cannot compute spectral norms because Atlas has not "
-        "been compiled with TRANS support." );
-#endif
+    this->norm( field, &norm, rank );
 }
 void Spectral::norm( const Field& field, double norm_per_level[], int rank ) const {
+    if ( parallelisation_->native() ) {
+        parallelisation_->norm( field, norm_per_level, rank );
+        return;
+    }
 #if ATLAS_HAVE_TRANS
-    ASSERT( std::max<int>( 1, field.levels() ) == 1 );
     struct ::SpecNorm_t args = new_specnorm( *parallelisation_ );
     args.nfld                = std::max<int>( 1, field.levels() );
     args.rspec               = field.data<double>();
     args.rnorm               = norm_per_level;
     args.nmaster             = rank + 1;
     TRANS_CHECK(::trans_specnorm( &args ) );
-#else
-    throw eckit::Exception(
-        "Cannot compute spectral norms because Atlas has not "
-        "been compiled with TRANS support." );
 #endif
 }
 void Spectral::norm( const Field& field, std::vector<double>& norm_per_level, int rank ) const {
-#if ATLAS_HAVE_TRANS
     norm_per_level.resize( std::max<int>( 1, field.levels() ) );
-    struct ::SpecNorm_t args = new_specnorm( *parallelisation_ );
-    args.nfld                = norm_per_level.size();
-    args.rspec               = field.data<double>();
-    args.rnorm               = norm_per_level.data();
-    args.nmaster             = rank + 1;
-    TRANS_CHECK(::trans_specnorm( &args ) );
-#else
-    throw eckit::Exception(
-        "Cannot compute spectral norms because Atlas has not "
-        "been compiled with TRANS support." );
-#endif
+    norm( field, norm_per_level.data(), rank );
 }
 
 }  // namespace detail
@@ -373,6 +559,10 @@ int Spectral::truncation() const {
     return functionspace_->truncation();
 }
 
+const std::vector<int>& Spectral::zonal_wavenumbers() const {
+    return functionspace_->zonal_wavenumbers();
+}
+
 void Spectral::gather( const FieldSet& local_fieldset, FieldSet& global_fieldset ) const {
     functionspace_->gather( local_fieldset, global_fieldset );
 }
@@ -65,10 +65,18 @@ public:
     void norm( const Field&, std::vector<double>& norm_per_level, int rank = 0 ) const;
 
 public:  // methods
+    /// @brief Number of coefficients stored on this task, less than nb_spectral_coefficients_global() when
+    /// distributed over more than one task
     size_t nb_spectral_coefficients() const;
     size_t nb_spectral_coefficients_global() const;
     int truncation() const { return truncation_; }
 
+    /// @brief Zonal wavenumbers m of the coefficients on this task, in storage order
+    ///
+    /// The coefficients of each m (n = m..truncation, real and imaginary part) are stored contiguously.
+    /// Not available when the trans library distributes the coefficients over more than one task.
+    const std::vector<int>& zonal_wavenumbers() const;
+
 private:  // methods
     array::DataType config_datatype( const eckit::Configuration& ) const;
     std::string config_name( const eckit::Configuration& ) const;
@@ -116,6 +124,7 @@ public:
     size_t nb_spectral_coefficients() const;
     size_t nb_spectral_coefficients_global() const;
     int truncation() const;
+    const std::vector<int>& zonal_wavenumbers() const;
 
 private:
     const detail::Spectral* functionspace_;
@@ -58,15 +58,19 @@ array::LocalView<T, 3> make_leveled_view( const Field& field ) {
 
 template <typename T>
 std::string checksum_3d_field( const parallel::Checksum& checksum, const Field& field ) {
+    if ( field.array().contiguous() ) {
+        // All levels and variables of a point are hashed in place
+        return checksum.execute( field.array().data<T>(), field.stride( 0 ) );
+    }
     array::LocalView<T, 3> values = make_leveled_view<T>( field );
-    array::ArrayT<T> surface_field( values.shape( 0 ), values.shape( 2 ) );
+    array::ArrayT<T> surface_field( values.shape( 0 ), values.shape( 1 ) * values.shape( 2 ) );
     array::ArrayView<T, 2> surface = array::make_view<T, 2>( surface_field );
     const size_t npts              = values.shape( 0 );
-    atlas_omp_for( size_t n = 0; n < npts; ++n ) {
-        for ( size_t j = 0; j < surface.shape( 1 ); ++j ) {
-            surface( n, j ) = 0.;
-            for ( size_t l = 0; l < values.shape( 1 ); ++l )
-                surface( n, j ) += values( n, l, j );
+    atlas_omp_parallel_for( size_t n = 0; n < npts; ++n ) {
+        for ( size_t l = 0; l < values.shape( 1 ); ++l ) {
+            for ( size_t j = 0; j < values.shape( 2 ); ++j ) {
+                surface( n, l * values.shape( 2 ) + j ) = values( n, l, j );
+            }
         }
     }
     return checksum.execute( surface.data(), surface_field.stride( 0 ) );
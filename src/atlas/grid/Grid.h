@@ -99,6 +99,14 @@ public:
 
     Spec spec() const { return grid_->spec(); }
 
+    /// @brief Compute xy coordinates of all grid points, stored in grid order as { x0, y0, x1, y1, ... }
+    /// @param [out] xy  Array of size 2*size()
+    void fill_xy( double xy[] ) const { grid_->fill_xy( xy ); }
+
+    /// @brief Compute lonlat coordinates of all grid points, stored in grid order as { lon0, lat0, lon1, lat1, ... }
+    /// @param [out] lonlat  Array of size 2*size()
+    void fill_lonlat( double lonlat[] ) const { grid_->fill_lonlat( lonlat ); }
+
     const Implementation* get() const { return grid_.get(); }
 
 private:
@@ -214,6 +222,25 @@ public:
 
     PointLonLat lonlat( size_t i, size_t j ) const { return grid_->lonlat( i, j ); }
 
+    using Grid::fill_xy;
+    using Grid::fill_lonlat;
+
+    /// @brief Compute xy coordinates of all points in rows [jbegin,jend), stored in grid order, in parallel
+    void fill_xy( size_t jbegin, size_t jend, double xy[] ) const { grid_->fill_xy( jbegin, jend, xy ); }
+
+    /// @brief Compute lonlat coordinates of all points in rows [jbegin,jend), stored in grid order, in parallel
+    void fill_lonlat( size_t jbegin, size_t jend, double lonlat[] ) const {
+        grid_->fill_lonlat( jbegin, jend, lonlat );
+    }
+
+    /// @brief xy coordinates of all grid points as { x0, y0, x1, y1, ... }, computed on first use and kept
+    /// with the grid, so that it is shared by all copies of this grid
+    const std::vector<double>& cached_xy() const { return grid_->cached_xy(); }
+
+    /// @brief lonlat coordinates of all grid points as { lon0, lat0, lon1, lat1, ... }, computed on first use
+    /// and kept with the grid, so that it is shared by all copies of this grid
+    const std::vector<double>& cached_lonlat() const { return grid_->cached_lonlat(); }
+
     inline bool reduced() const { return grid_->reduced(); }
 
     inline bool regular() const { return not reduced(); }
@@ -10,6 +10,7 @@
 
 #include "Grid.h"
 
+#include <memory>
 #include <vector>
 
 #include "eckit/memory/Factory.h"
@@ -96,6 +97,26 @@ std::string Grid::hash() const {
     return hash_;
 }
 
+void Grid::fill_xy( double xy[] ) const {
+    std::unique_ptr<IteratorXY> it( xy_begin() );
+    PointXY p;
+    size_t c = 0;
+    while ( it->next( p ) ) {
+        xy[c++] = p.x();
+        xy[c++] = p.y();
+    }
+}
+
+void Grid::fill_lonlat( double lonlat[] ) const {
+    std::unique_ptr<IteratorLonLat> it( lonlat_begin() );
+    PointLonLat p;
+    size_t c = 0;
+    while ( it->next( p ) ) {
+        lonlat[c++] = p.lon();
+        lonlat[c++] = p.lat();
+    }
+}
+
 }  // namespace grid
 }  // namespace detail
 }  // namespace grid
@@ -107,6 +107,14 @@ public:  // methods
     virtual IteratorLonLat* lonlat_begin() const                  = 0;
     virtual IteratorLonLat* lonlat_end() const                    = 0;
 
+    /// @brief Compute xy coordinates of all grid points, stored in grid order as { x0, y0, x1, y1, ... }
+    /// @param [out] xy  Array of size 2*size()
+    virtual void fill_xy( double xy[] ) const;
+
+    /// @brief Compute lonlat coordinates of all grid points, stored in grid order as { lon0, lat0, lon1, lat1, ... }
+    /// @param [out] lonlat  Array of size 2*size()
+    virtual void fill_lonlat( double lonlat[] ) const;
+
 protected:  // methods
     /// Fill provided me
     virtual void print( std::ostream& ) const = 0;
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <limits>
 
+#include "eckit/thread/AutoLock.h"
 #include "eckit/types/FloatCompare.h"
 
 #include "atlas/domain/Domain.h"
@@ -20,8 +21,10 @@
 #include "atlas/grid/detail/grid/GridBuilder.h"
 #include "atlas/grid/detail/spacing/CustomSpacing.h"
 #include "atlas/grid/detail/spacing/LinearSpacing.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/ErrorHandling.h"
 #include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
 #include "atlas/util/Point.h"
 #include "atlas/util/UnitSphere.h"
 
@@ -449,6 +452,65 @@ void Structured::computeTruePeriodicity() {
     }
 }
 
+void Structured::fill_xy( double xy[] ) const {
+    fill_xy( 0, ny(), xy );
+}
+
+void Structured::fill_lonlat( double lonlat[] ) const {
+    fill_lonlat( 0, ny(), lonlat );
+}
+
+void Structured::fill_xy( size_t jbegin, size_t jend, double xy[] ) const {
+    ASSERT( jbegin <= jend && jend <= ny() );
+    std::vector<size_t> offset( jend - jbegin + 1, 0 );
+    for ( size_t j = jbegin; j < jend; ++j ) {
+        offset[j - jbegin + 1] = offset[j - jbegin] + 2 * nx( j );
+    }
+    atlas_omp_parallel_for( size_t j = jbegin; j < jend; ++j ) {
+        double* crd = xy + offset[j - jbegin];
+        for ( size_t i = 0; i < nx( j ); ++i ) {
+            crd[2 * i]     = x( i, j );
+            crd[2 * i + 1] = y( j );
+        }
+    }
+}
+
+void Structured::fill_lonlat( size_t jbegin, size_t jend, double lonlat[] ) const {
+    ASSERT( jbegin <= jend && jend <= ny() );
+    std::vector<size_t> offset( jend - jbegin + 1, 0 );
+    for ( size_t j = jbegin; j < jend; ++j ) {
+        offset[j - jbegin + 1] = offset[j - jbegin] + 2 * nx( j );
+    }
+    atlas_omp_parallel_for( size_t j = jbegin; j < jend; ++j ) {
+        double* crd = lonlat + offset[j - jbegin];
+        for ( size_t i = 0; i < nx( j ); ++i ) {
+            crd[2 * i]     = x( i, j );
+            crd[2 * i + 1] = y( j );
+            projection_.xy2lonlat( crd + 2 * i );
+        }
+    }
+}
+
+const std::vector<double>& Structured::cached_xy() const {
+    eckit::AutoLock<eckit::Mutex> lock( cache_mutex_ );
+    if ( cached_xy_.empty() && size() ) {
+        ATLAS_TRACE( "Structured::cached_xy" );
+        cached_xy_.resize( 2 * size() );
+        fill_xy( cached_xy_.data() );
+    }
+    return cached_xy_;
+}
+
+const std::vector<double>& Structured::cached_lonlat() const {
+    eckit::AutoLock<eckit::Mutex> lock( cache_mutex_ );
+    if ( cached_lonlat_.empty() && size() ) {
+        ATLAS_TRACE( "Structured::cached_lonlat" );
+        cached_lonlat_.resize( 2 * size() );
+        fill_lonlat( cached_lonlat_.data() );
+    }
+    return cached_lonlat_;
+}
+
 void Structured::print( std::ostream& os ) const {
     os << "Structured(Name:" << name() << ")";
 }
@@ -14,6 +14,7 @@
 #include <memory>
 
 #include "eckit/memory/Builder.h"
+#include "eckit/thread/Mutex.h"
 #include "eckit/utils/Hash.h"
 
 #include "atlas/grid/Spacing.h"
@@ -354,6 +355,27 @@ public:
         return new IteratorXYPredicated( *this, p, false );
     }
 
+    virtual void fill_xy( double xy[] ) const;
+    virtual void fill_lonlat( double lonlat[] ) const;
+
+    /// @brief Compute xy coordinates of all points in rows [jbegin,jend), stored in grid order as { x0, y0, ... }
+    /// Rows are computed in parallel.
+    /// @param [out] xy  Array of size 2 * (number of points in rows [jbegin,jend))
+    void fill_xy( size_t jbegin, size_t jend, double xy[] ) const;
+
+    /// @brief Compute lonlat coordinates of all points in rows [jbegin,jend), stored in grid order as
+    /// { lon0, lat0, ... }. Rows are computed in parallel.
+    /// @param [out] lonlat  Array of size 2 * (number of points in rows [jbegin,jend))
+    void fill_lonlat( size_t jbegin, size_t jend, double lonlat[] ) const;
+
+    /// @brief xy coordinates of all grid points as { x0, y0, x1, y1, ... }, computed on first use
+    /// and kept for the lifetime of the grid
+    const std::vector<double>& cached_xy() const;
+
+    /// @brief lonlat coordinates of all grid points as { lon0, lat0, lon1, lat1, ... }, computed on first use
+    /// and kept for the lifetime of the grid
+    const std::vector<double>& cached_lonlat() const;
+
 protected:  // methods
     virtual void print( std::ostream& ) const;
 
@@ -398,6 +420,9 @@ private:
     XSpace xspace_;
     YSpace yspace_;
     mutable std::string type_;
+    mutable std::vector<double> cached_xy_;
+    mutable std::vector<double> cached_lonlat_;
+    mutable eckit::Mutex cache_mutex_;
 };
 
 extern "C" {
@@ -48,15 +48,16 @@ void MatchingMeshPartitionerLonLatPolygon::partition( const Grid& grid, int part
 
     {
         eckit::ProgressTimer timer( "Partitioning", grid.size(), "point", double( 10 ), atlas::Log::info() );
-        size_t i = 0;
+        std::vector<double> lonlat( 2 * grid.size() );
+        grid.fill_lonlat( lonlat.data() );
 
-        for ( const PointXY Pxy : grid.xy() ) {
+        for ( size_t i = 0; i < grid.size(); ++i ) {
             ++timer;
-            const PointLonLat P  = grid.projection().lonlat( Pxy );
+            const PointLonLat P( lonlat[2 * i], lonlat[2 * i + 1] );
             const bool atThePole = ( includesNorthPole && P.lat() >= poly.coordinatesMax().lat() ) ||
                                    ( includesSouthPole && P.lat() < poly.coordinatesMin().lat() );
 
-            partitioning[i++] = atThePole || poly.contains( P ) ? mpi_rank : -1;
+            partitioning[i] = atThePole || poly.contains( P ) ? mpi_rank : -1;
         }
     }
 
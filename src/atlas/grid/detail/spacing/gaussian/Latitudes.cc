@@ -11,15 +11,18 @@
 /// @author Willem Deconinck
 /// @date Jan 2014
 
+#include <cmath>
 #include <limits>
+#include <sstream>
+#include <vector>
 
+#include "eckit/exception/Exceptions.h"
 #include "eckit/memory/ScopedPtr.h"
 
-#include "atlas/array.h"
-#include "atlas/array/MakeView.h"
 #include "atlas/grid/detail/spacing/gaussian/Latitudes.h"
 #include "atlas/grid/detail/spacing/gaussian/N.h"
 #include "atlas/library/config.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/util/Constants.h"
 #include "atlas/util/CoordinateEnums.h"
@@ -28,10 +31,6 @@ using eckit::ConcreteBuilderT0;
 using eckit::Factory;
 using eckit::ScopedPtr;
 
-using atlas::array::Array;
-using atlas::array::ArrayView;
-using atlas::array::make_view;
-
 namespace atlas {
 namespace grid {
 namespace spacing {
@@ -39,6 +38,7 @@ namespace gaussian {
 
 //-----------------------------------------------------------------------------
 
+void compute_gaussian_latitudes_npole_equator( const size_t N, double lat[] );
 void compute_gaussian_quadrature_npole_equator( const size_t N, double lat[], double weights[] );
 
 //-----------------------------------------------------------------------------
@@ -52,8 +52,7 @@ void gaussian_latitudes_npole_equator( const size_t N, double lats[] ) {
         gl->assign( lats, N );
     }
     else {
-        std::vector<double> weights( N );
-        compute_gaussian_quadrature_npole_equator( N, lats, weights.data() );
+        compute_gaussian_latitudes_npole_equator( N, lats );
     }
 }
 
@@ -165,7 +164,7 @@ void legpol_weight( const int kn, const double pfn[], const double px, double& p
 
 //-----------------------------------------------------------------------------
 
-void legpol_quadrature( const int kn, const double pfn[], double& pl, double& pw, int& kiter, double& pmod ) {
+bool legpol_quadrature( const int kn, const double pfn[], double& pl, double& pw, int& kiter, double& pmod ) {
     //**** *GAWL * - Routine to perform the Newton loop
 
     //     Purpose.
@@ -184,6 +183,7 @@ void legpol_quadrature( const int kn, const double pfn[], double& pl, double& pw
     // KN     Truncation                                (in)
     // KITER  Number of iterations                      (out)
     // PMOD   Last modification                         (inout)
+    // Returns false when the Newton loop did not converge
 
     int iflag, itemax;
 
@@ -214,75 +214,192 @@ void legpol_quadrature( const int kn, const double pfn[], double& pl, double& pw
         }
         if ( std::abs( pmod ) <= zeps * 1000. ) iflag = 1;
     }
-    if ( iflag != 1 ) {
-        std::stringstream s;
-        s << "Could not converge gaussian latitude to accuracy [" << zeps * 1000 << "]\n";
-        s << "after " << itemax << " iterations. Consequently also failed to compute quadrature weight.";
-        throw eckit::Exception( s.str(), Here() );
-    }
+    if ( iflag != 1 ) { return false; }
 
     pl = zxn;
     pw = zw;
+    return true;
 }
 
 //-----------------------------------------------------------------------------
 
+// Asymptotic approximation of the Gauss-Legendre nodes, following I. Bogaert, "Iteration-free computation of
+// Gauss-Legendre quadrature nodes and weights", SIAM J. Sci. Comput. 36 (2014). Returns the colatitude
+// in radians of root k = 1, 2, ..., n/2 of the Legendre polynomial of degree n > 100, counted from the North pole.
+// The error is of the order of machine precision, so that no Newton polishing is required.
+
+// Zeros of the Bessel function J0
+const double bessel_j0_zeros[20] = {
+    2.40482555769577276862163187933,  5.52007811028631064959660411281,  8.65372791291101221695419871266,
+    11.7915344390142816137430449119,  14.9309177084877859477625939974,  18.0710639679109225431478829756,
+    21.2116366298792589590783933505,  24.3524715307493027370579447632,  27.4934791320402547958772882346,
+    30.6346064684319751175495789269,  33.7758202135735686842385463467,  36.9170983536640439797694930633,
+    40.0584257646282392947993073740,  43.1997917131767303575240727287,  46.3411883716618140186857888791,
+    49.4826098973978171736027615332,  52.6240518411149960292512853804,  55.7655107550199793116834927735,
+    58.9069839260809421328344066346,  62.0484691902271698828525002646};
+
+double bessel_j0_zero( const size_t k ) {
+    if ( k <= 20 ) { return bessel_j0_zeros[k - 1]; }
+    // McMahon's asymptotic expansion
+    double z        = M_PI * ( k - 0.25 );
+    const double r  = 1. / z;
+    const double r2 = r * r;
+    z += r * ( 0.125 +
+               r2 * ( -0.807291666666666666666666666667e-1 +
+                      r2 * ( 0.246028645833333333333333333333 +
+                             r2 * ( -1.82443876720610119047619047619 +
+                                    r2 * ( 25.3364147973439050099206349206 +
+                                           r2 * ( -567.644412135183381139802038240 +
+                                                  r2 * ( 18690.4765282320653831636345064 +
+                                                         r2 * ( -8.49353580299148769921876983660e5 +
+                                                                5.09225462402226769498681286758e7 * r2 ) ) ) ) ) ) ) );
+    return z;
+}
+
+double asymptotic_colatitude( const size_t n, const size_t k ) {
+    const double w     = 1. / ( n + 0.5 );
+    const double nu    = bessel_j0_zero( k );
+    const double theta = w * nu;
+    const double x     = theta * theta;
+
+    // Chebyshev interpolants of the expansion coefficients
+    const double SF1T = ( ( ( ( ( -1.29052996274280508473467968379e-12 * x + 2.40724685864330121825976175184e-10 ) * x -
+                                3.13148654635992041468855740012e-8 ) *
+                                  x +
+                              0.275573168962061235623801563453e-5 ) *
+                                x -
+                            0.148809523713909147898955880165e-3 ) *
+                              x +
+                          0.416666666665193394525296923981e-2 ) *
+                            x -
+                        0.416666666666662959639712457549e-1;
+    const double SF2T = ( ( ( ( ( +2.20639421781871003734786884322e-9 * x - 7.53036771373769326811030753538e-8 ) * x +
+                                0.161969259453836261731700382098e-5 ) *
+                                  x -
+                              0.253300326008232025914059965302e-4 ) *
+                                x +
+                            0.282116886057560434805998583817e-3 ) *
+                              x -
+                          0.209022248387852902722635654229e-2 ) *
+                            x +
+                        0.815972221772932265640401128517e-2;
+    const double SF3T = ( ( ( ( ( -2.97058225375526229899781956673e-8 * x + 5.55845330223796209655886325712e-7 ) * x -
+                                0.567797841356833081642185432056e-5 ) *
+                                  x +
+                              0.418498100329504574443885193835e-4 ) *
+                                x -
+                            0.251395293283965914823026348764e-3 ) *
+                              x +
+                          0.128654198542845137196151147483e-2 ) *
+                            x -
+                        0.416012165620204364833694266818e-2;
+
+    const double WInvSinc = w * w * nu / std::sin( theta );
+    const double WIS2     = WInvSinc * WInvSinc;
+
+    return w * ( nu + theta * WInvSinc * ( SF1T + WIS2 * ( SF2T + WIS2 * SF3T ) ) );
+}
+
+// Below this degree the asymptotic expansion is not accurate to machine precision, and Newton iterations are used
+constexpr size_t asymptotic_min_degree = 101;
+
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+
 }  //  anonymous namespace
 
 //-----------------------------------------------------------------------------
 
-void compute_gaussian_quadrature_npole_equator( const size_t N, double lats[], double weights[] ) {
+void compute_gaussian_latitudes_npole_equator( const size_t N, double lats[] ) {
+    const size_t kdgl = 2 * N;
+    if ( kdgl < asymptotic_min_degree ) {
+        std::vector<double> weights( N );
+        compute_gaussian_quadrature_npole_equator( N, lats, weights.data() );
+        return;
+    }
+
     Log::debug() << "Atlas computing Gaussian latitudes for N " << N << "\n";
 
-    // Compute first guess for colatitudes in radians
-    double z;
-    for ( size_t i = 0; i < N; ++i ) {
-        z       = ( 4. * ( i + 1. ) - 1. ) * M_PI / ( 4. * 2. * N + 2. );
-        lats[i] = ( z + 1. / ( tan( z ) * ( 8. * ( 2. * N ) * ( 2. * N ) ) ) );
+    const double pole = 90.;
+    atlas_omp_parallel_for( size_t jgl = 0; jgl < N; ++jgl ) {
+        lats[jgl] = pole - asymptotic_colatitude( kdgl, jgl + 1 ) * util::Constants::radiansToDegrees();
     }
+}
 
-    int kdgl = 2 * N;
-    array::ArrayT<double> zfn_( kdgl + 1, kdgl + 1 );
-    ArrayView<double, 2> zfn = make_view<double, 2>( zfn_ );
+void compute_gaussian_quadrature_npole_equator( const size_t N, double lats[], double weights[] ) {
+    Log::debug() << "Atlas computing Gaussian latitudes for N " << N << "\n";
 
-    int iodd;
+    const int kdgl = 2 * N;
 
-    // Belousov, Swarztrauber use zfn(0,0)=std::sqrt(2.)
-    // IFS normalisation chosen to be 0.5*Integral(Pnm**2) = 1
-    zfn( 0, 0 ) = 2.;
-    for ( int jn = 1; jn <= kdgl; ++jn ) {
-        double zfnn = zfn( 0, 0 );
-        for ( int jgl = 1; jgl <= jn; ++jgl ) {
-            zfnn *= std::sqrt( 1. - 0.25 / ( static_cast<double>( jgl * jgl ) ) );
-        }
-        iodd          = jn % 2;
-        zfn( jn, jn ) = zfnn;
-        for ( int jgl = 2; jgl <= jn - iodd; jgl += 2 ) {
-            zfn( jn, jn - jgl ) = zfn( jn, jn - jgl + 2 ) * static_cast<double>( ( jgl - 1 ) * ( 2 * jn - jgl + 2 ) ) /
-                                  static_cast<double>( jgl * ( 2 * jn - jgl + 1 ) );
-        }
-    }
+    std::vector<double> zfn( kdgl + 1 );
+    legendre_fourier_coefficients( kdgl, zfn.data() );
 
-    iodd   = kdgl % 2;
-    int ik = iodd;
+    int iodd = kdgl % 2;
+    int ik   = iodd;
 
     std::vector<double> zzfn( N + 1 );
-    std::vector<double> zmod( kdgl );
-    std::vector<int> iter( kdgl );
-
     for ( int jgl = iodd; jgl <= kdgl; jgl += 2 ) {
-        zzfn[ik] = zfn( kdgl, jgl );
+        zzfn[ik] = zfn[jgl];
         ++ik;
     }
 
     const double pole = 90.;
+
+    if ( size_t( kdgl ) >= asymptotic_min_degree ) {
+        atlas_omp_parallel_for( size_t jgl = 0; jgl < N; ++jgl ) {
+            const double colat = asymptotic_colatitude( kdgl, jgl + 1 );
+            legpol_weight( kdgl, zzfn.data(), colat, weights[jgl] );
+            lats[jgl] = pole - colat * util::Constants::radiansToDegrees();
+        }
+        return;
+    }
+
+    int failures = 0;
+    atlas_omp_pragma( omp parallel for reduction(+:failures) )
     for ( size_t jgl = 0; jgl < N; ++jgl ) {
+        // Compute first guess for colatitude in radians
+        const double z = ( 4. * ( jgl + 1. ) - 1. ) * M_PI / ( 4. * 2. * N + 2. );
+        lats[jgl]      = ( z + 1. / ( tan( z ) * ( 8. * ( 2. * N ) * ( 2. * N ) ) ) );
+
         // refine colat first guess here via Newton's method
-        legpol_quadrature( kdgl, zzfn.data(), lats[jgl], weights[jgl], iter[jgl], zmod[jgl] );
+        int iter;
+        double zmod;
+        if ( !legpol_quadrature( kdgl, zzfn.data(), lats[jgl], weights[jgl], iter, zmod ) ) { ++failures; }
 
         // Convert colat to lat, in degrees
         lats[jgl] = pole - lats[jgl] * util::Constants::radiansToDegrees();
     }
+    if ( failures ) {
+        std::stringstream s;
+        s << "Could not converge gaussian latitude to accuracy [" << std::numeric_limits<double>::epsilon() * 1000
+          << "]\n";
+        s << "after 20 iterations. Consequently also failed to compute quadrature weight.";
+        throw eckit::Exception( s.str(), Here() );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void legendre_fourier_coefficients( const size_t n, double zfn[] ) {
+    // Belousov, Swarztrauber use zfn(0,0)=std::sqrt(2.)
+    // IFS normalisation chosen to be 0.5*Integral(Pnm**2) = 1
+    double zfnn = 2.;
+    for ( size_t jgl = 1; jgl <= n; ++jgl ) {
+        zfnn *= std::sqrt( 1. - 0.25 / ( static_cast<double>( jgl ) * static_cast<double>( jgl ) ) );
+    }
+
+    const size_t iodd = n % 2;
+    for ( size_t jk = 0; jk < n; ++jk ) {
+        zfn[jk] = 0.;
+    }
+    zfn[n] = zfnn;
+    for ( size_t jgl = 2; jgl <= n - iodd; jgl += 2 ) {
+        const double zfjn = ( ( jgl - 1. ) * ( 2. * n - jgl + 2. ) );  // new factor numerator
+        const double zfjd = ( jgl * ( 2. * n - jgl + 1. ) );           // new factor denominator
+
+        zfn[n - jgl] = zfn[n - jgl + 2] * zfjn / zfjd;
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -56,6 +56,16 @@ void gaussian_latitudes_npole_spole( const size_t N, double latitudes[] );
  */
 void gaussian_quadrature_npole_spole( const size_t N, double latitudes[], double weights[] );
 
+/**
+ * @brief Compute the Fourier coefficients of the normalised Legendre polynomial
+ * of degree n, such that P_n(cos(theta)) = sum_k coefficients[k] * cos(k*theta)
+ * @param n            [in]  Degree of the Legendre polynomial
+ * @param coefficients [out] Coefficients indexed by wavenumber k (size n+1).
+ * Coefficients with k of different parity than n are zero.
+ * @note Requires O(n) memory, and O(n) operations
+ */
+void legendre_fourier_coefficients( const size_t n, double coefficients[] );
+
 }  // namespace gaussian
 }  // namespace spacing
 }  // namespace grid
@@ -22,6 +22,7 @@
 
 #include "atlas/field/Field.h"
 #include "atlas/field/FieldSet.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
 
@@ -29,6 +30,7 @@
 #include "FiniteElement.h"
 #include "KNearestNeighbours.h"
 #include "NearestNeighbour.h"
+#include "StructuredInterpolation.h"
 
 namespace atlas {
 namespace interpolation {
@@ -55,9 +57,67 @@ struct force_link {
         load_builder<method::FiniteElement>();
         load_builder<method::KNearestNeighbours>();
         load_builder<method::NearestNeighbour>();
+        load_builder<method::StructuredBilinear>();
+        load_builder<method::StructuredBicubic>();
     }
 };
 
+// Apply the interpolation matrix to fields of rank 1 or 2, (point) or (point,level), with arbitrary strides.
+// Data is accessed in place, so level-major and point-major layouts need no staging copies.
+void interpolate_strided( const eckit::linalg::SparseMatrix& matrix, const Field& src, Field& tgt ) {
+    ASSERT( src.rank() <= 2 );
+    ASSERT( src.rank() == tgt.rank() );
+    ASSERT( matrix.cols() == src.shape( 0 ) );
+    ASSERT( matrix.rows() == tgt.shape( 0 ) );
+
+    const size_t nb_levels = src.rank() > 1 ? src.shape( 1 ) : 1;
+    ASSERT( ( tgt.rank() > 1 ? tgt.shape( 1 ) : 1 ) == nb_levels );
+
+    const size_t src_point_stride = src.stride( 0 );
+    const size_t tgt_point_stride = tgt.stride( 0 );
+    const size_t src_level_stride = src.rank() > 1 ? src.stride( 1 ) : 0;
+    const size_t tgt_level_stride = tgt.rank() > 1 ? tgt.stride( 1 ) : 0;
+
+    const double* src_data = src.data<double>();
+    double* tgt_data       = tgt.data<double>();
+
+    const auto outer     = matrix.outer();
+    const auto inner     = matrix.inner();
+    const auto weights   = matrix.data();
+    const size_t nb_rows = matrix.rows();
+
+    if ( nb_levels == 1 || tgt_level_stride == 1 ) {
+        // levels of a point are contiguous in the target
+        atlas_omp_parallel_for( size_t r = 0; r < nb_rows; ++r ) {
+            double* y = tgt_data + r * tgt_point_stride;
+            for ( size_t l = 0; l < nb_levels; ++l ) {
+                y[l * tgt_level_stride] = 0.;
+            }
+            for ( auto k = outer[r]; k < outer[r + 1]; ++k ) {
+                const double w  = weights[k];
+                const double* x = src_data + inner[k] * src_point_stride;
+                for ( size_t l = 0; l < nb_levels; ++l ) {
+                    y[l * tgt_level_stride] += w * x[l * src_level_stride];
+                }
+            }
+        }
+    }
+    else {
+        // points of a level are contiguous in the target
+        for ( size_t l = 0; l < nb_levels; ++l ) {
+            const double* x = src_data + l * src_level_stride;
+            double* y       = tgt_data + l * tgt_level_stride;
+            atlas_omp_parallel_for( size_t r = 0; r < nb_rows; ++r ) {
+                double sum = 0.;
+                for ( auto k = outer[r]; k < outer[r + 1]; ++k ) {
+                    sum += weights[k] * x[inner[k] * src_point_stride];
+                }
+                y[r * tgt_point_stride] = sum;
+            }
+        }
+    }
+}
+
 }  // namespace
 
 MethodFactory::MethodFactory( const std::string& name ) : name_( name ) {
@@ -103,20 +163,23 @@ void Method::execute( const FieldSet& fieldsSource, FieldSet& fieldsTarget ) con
     for ( size_t i = 0; i < fieldsSource.size(); ++i ) {
         Log::debug() << "Method::execute() on field " << ( i + 1 ) << '/' << N << "..." << std::endl;
 
-        const Field& src = fieldsSource[i];
-        Field& tgt       = fieldsTarget[i];
-
-        eckit::linalg::Vector v_src( const_cast<double*>( src.data<double>() ), src.shape( 0 ) );
-        eckit::linalg::Vector v_tgt( tgt.data<double>(), tgt.shape( 0 ) );
-
-        eckit::linalg::LinearAlgebra::backend().spmv( matrix_, v_src, v_tgt );
+        Field tgt = fieldsTarget[i];
+        Method::execute( fieldsSource[i], tgt );
     }
 }
 
 void Method::execute( const Field& fieldSource, Field& fieldTarget ) const {
     ATLAS_TRACE( "atlas::interpolation::method::Method::execute()" );
 
-    eckit::linalg::Vector v_src( const_cast<Field&>( fieldSource ).data<double>(), fieldSource.shape( 0 ) ),
+    const bool contiguous = fieldSource.rank() == 1 && fieldSource.stride( 0 ) == 1 && fieldTarget.rank() == 1 &&
+                            fieldTarget.stride( 0 ) == 1;
+    if ( not contiguous ) {
+        interpolate_strided( matrix_, fieldSource, fieldTarget );
+        return;
+    }
+
+    // eckit::linalg::Vector only wraps non-const data, the source is not modified
+    eckit::linalg::Vector v_src( const_cast<double*>( fieldSource.data<double>() ), fieldSource.shape( 0 ) ),
         v_tgt( fieldTarget.data<double>(), fieldTarget.shape( 0 ) );
 
     eckit::linalg::LinearAlgebra::backend().spmv( matrix_, v_src, v_tgt );
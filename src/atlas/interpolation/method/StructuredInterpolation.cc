@@ -0,0 +1,451 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include "atlas/interpolation/method/StructuredInterpolation.h"
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/log/Plural.h"
+
+#include "atlas/array/ArrayView.h"
+#include "atlas/array/MakeView.h"
+#include "atlas/field/Field.h"
+#include "atlas/field/FieldSet.h"
+#include "atlas/functionspace/NodeColumns.h"
+#include "atlas/functionspace/PointCloud.h"
+#include "atlas/mesh/Nodes.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/CoordinateEnums.h"
+
+namespace atlas {
+namespace interpolation {
+namespace method {
+
+namespace {
+
+MethodBuilder<StructuredBilinear> __builder_bilinear( "structured-bilinear" );
+MethodBuilder<StructuredBicubic> __builder_bicubic( "structured-bicubic" );
+
+static const size_t max_width = 4;
+
+// Rows of a StructuredColumns partition including its halo, indexed from j_begin_halo().
+// Within each row, x(i) = x0 + i * dx for i in [ibegin,iend).
+struct Rows {
+    Rows( const functionspace::StructuredColumns& fs ) {
+        auto xy = array::make_view<double, 2>( fs.xy() );
+
+        jbegin = fs.j_begin_halo();
+        size   = fs.j_end_halo() - jbegin;
+        period = fs.grid().domain().global() ? 360. : 0.;
+        y.resize( size );
+        x0.resize( size );
+        dx.resize( size );
+        ibegin.resize( size );
+        iend.resize( size );
+        for ( idx_t r = 0; r < size; ++r ) {
+            const idx_t j = jbegin + r;
+            ibegin[r]     = fs.i_begin_halo( j );
+            iend[r]       = fs.i_end_halo( j );
+            const idx_t n = fs.index( ibegin[r], j );
+            y[r]          = xy( n, YY );
+            dx[r]         = ( iend[r] - ibegin[r] > 1 ) ? xy( fs.index( ibegin[r] + 1, j ), XX ) - xy( n, XX ) : 0.;
+            x0[r]         = xy( n, XX ) - ibegin[r] * dx[r];
+        }
+    }
+
+    // Row r such that y[r] >= y > y[r+1], or -1 if y is outside the rows (latitudes are decreasing)
+    idx_t find_row( double yp ) const {
+        if ( size < 2 || yp > y[0] || yp < y[size - 1] ) { return -1; }
+        idx_t lo = 0;
+        idx_t hi = size - 1;
+        while ( hi - lo > 1 ) {
+            const idx_t mid = ( lo + hi ) / 2;
+            if ( y[mid] >= yp ) { lo = mid; }
+            else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    // Column i in row r such that x(i) <= x < x(i+1), with x wrapped into the row for periodic rows;
+    // the fraction of the interval is returned in t
+    bool find_column( idx_t r, double xp, idx_t& i, double& t ) const {
+        if ( dx[r] <= 0. ) { return false; }
+        if ( period > 0. ) {
+            const double xmin = x0[r] + ibegin[r] * dx[r];
+            xp                = xmin + std::fmod( std::fmod( xp - xmin, period ) + period, period );
+        }
+        const double s = ( xp - x0[r] ) / dx[r];
+        i              = static_cast<idx_t>( std::floor( s ) );
+        t              = s - i;
+        return true;
+    }
+
+    idx_t jbegin;
+    idx_t size;
+    double period;
+    std::vector<double> y;
+    std::vector<double> x0;
+    std::vector<double> dx;
+    std::vector<idx_t> ibegin;
+    std::vector<idx_t> iend;
+};
+
+// Lagrange weights on equidistant nodes, for fraction t of the central interval
+inline void equidistant_weights( size_t width, double t, double w[] ) {
+    if ( width == 2 ) {
+        w[0] = 1. - t;
+        w[1] = t;
+    }
+    else {
+        w[0] = -t * ( t - 1. ) * ( t - 2. ) / 6.;
+        w[1] = ( t + 1. ) * ( t - 1. ) * ( t - 2. ) / 2.;
+        w[2] = -( t + 1. ) * t * ( t - 2. ) / 2.;
+        w[3] = ( t + 1. ) * t * ( t - 1. ) / 6.;
+    }
+}
+
+// Lagrange weights on arbitrary nodes
+inline void lagrange_weights( size_t width, const double nodes[], double x, double w[] ) {
+    for ( size_t k = 0; k < width; ++k ) {
+        double wk = 1.;
+        for ( size_t l = 0; l < width; ++l ) {
+            if ( l != k ) { wk *= ( x - nodes[l] ) / ( nodes[k] - nodes[l] ); }
+        }
+        w[k] = wk;
+    }
+}
+
+}  // namespace
+
+// Stencil of a target point within the rows of the source partition and halo
+struct StructuredInterpolation::Stencil {
+    Stencil( const functionspace::StructuredColumns& fs, const Rows& rows, size_t width ) :
+        fs_( fs ),
+        rows_( rows ),
+        projection_( fs.grid().projection() ),
+        width_( width ),
+        offset_( idx_t( width - 1 ) / 2 ) {}
+
+    // Writes width*width triplets of the given row, or returns false if the stencil is not within the rows
+    bool operator()( double lon, double lat, size_t row, Triplet* triplet ) const {
+        double xy[2] = {lon, lat};
+        projection_.lonlat2xy( xy );
+
+        const idx_t r = rows_.find_row( xy[YY] ) - offset_;
+        if ( r < 0 || r + idx_t( width_ ) > rows_.size ) { return false; }
+
+        double wy[max_width];
+        lagrange_weights( width_, rows_.y.data() + r, xy[YY], wy );
+
+        for ( size_t k = 0; k < width_; ++k ) {
+            idx_t i;
+            double t;
+            if ( !rows_.find_column( r + k, xy[XX], i, t ) ) { return false; }
+            i -= offset_;
+            if ( i < rows_.ibegin[r + k] || i + idx_t( width_ ) > rows_.iend[r + k] ) { return false; }
+
+            double wx[max_width];
+            equidistant_weights( width_, t, wx );
+
+            const idx_t j = rows_.jbegin + r + k;
+            for ( size_t l = 0; l < width_; ++l ) {
+                *triplet++ = Triplet( row, size_t( fs_.index( i + l, j ) ), wy[k] * wx[l] );
+            }
+        }
+        return true;
+    }
+
+    const functionspace::StructuredColumns& fs_;
+    const Rows& rows_;
+    const Projection& projection_;
+    const size_t width_;
+    const idx_t offset_;
+};
+
+void StructuredInterpolation::setup( const FunctionSpace& source, const FunctionSpace& target ) {
+    ATLAS_TRACE( "atlas::interpolation::method::StructuredInterpolation::setup()" );
+
+    source_ = functionspace::StructuredColumns( source );
+    ASSERT( source_ );
+
+    const idx_t halo = source_.j_begin() - source_.j_begin_halo();
+    if ( halo < idx_t( width_ / 2 ) ) {
+        std::stringstream msg;
+        msg << "StructuredColumns source requires a halo of at least " << width_ / 2 << " for this interpolation";
+        throw eckit::BadParameter( msg.str(), Here() );
+    }
+
+    std::vector<double> lonlat;
+    std::vector<bool> skip;
+
+    if ( functionspace::StructuredColumns tgt = target ) {
+        const Projection& projection = tgt.grid().projection();
+        auto xy                      = array::make_view<double, 2>( tgt.xy() );
+        lonlat.resize( 2 * tgt.size() );
+        skip.assign( tgt.size(), false );
+        for ( size_t n = 0; n < tgt.size(); ++n ) {
+            lonlat[2 * n + 0] = xy( n, XX );
+            lonlat[2 * n + 1] = xy( n, YY );
+            projection.xy2lonlat( lonlat.data() + 2 * n );
+            skip[n] = ( n >= tgt.sizeOwned() );
+        }
+    }
+    else if ( functionspace::NodeColumns tgt = target ) {
+        auto ll    = array::make_view<double, 2>( tgt.nodes().lonlat() );
+        auto ghost = array::make_view<int, 1>( tgt.nodes().ghost() );
+        lonlat.resize( 2 * ll.shape( 0 ) );
+        skip.resize( ll.shape( 0 ) );
+        for ( size_t n = 0; n < ll.shape( 0 ); ++n ) {
+            lonlat[2 * n + 0] = ll( n, LON );
+            lonlat[2 * n + 1] = ll( n, LAT );
+            skip[n]           = ghost( n );
+        }
+    }
+    else if ( functionspace::PointCloud tgt = target ) {
+        auto ll    = array::make_view<double, 2>( tgt.lonlat() );
+        auto ghost = array::make_view<int, 1>( tgt.ghost() );
+        lonlat.resize( 2 * tgt.size() );
+        skip.resize( tgt.size() );
+        for ( size_t n = 0; n < tgt.size(); ++n ) {
+            lonlat[2 * n + 0] = ll( n, LON );
+            lonlat[2 * n + 1] = ll( n, LAT );
+            skip[n]           = ghost( n );
+        }
+    }
+    else {
+        NOTIMP;
+    }
+
+    setup( lonlat, skip );
+}
+
+void StructuredInterpolation::setup( const std::vector<double>& lonlat, const std::vector<bool>& skip ) {
+    const size_t out_npts = lonlat.size() / 2;
+    const size_t inp_npts = source_.size();
+    const Rows rows( source_ );
+    const Stencil stencil( source_, rows, width_ );
+    const size_t stencil_size = width_ * width_;
+
+    std::vector<size_t> points;
+    points.reserve( out_npts );
+    for ( size_t ip = 0; ip < out_npts; ++ip ) {
+        if ( skip.empty() || !skip[ip] ) { points.push_back( ip ); }
+    }
+
+    // Every point owns a block of triplets, so weights are written in place without synchronisation
+    std::vector<Triplet> weights_triplets( points.size() * stencil_size );
+    std::vector<char> failed( points.size(), 0 );
+
+    ATLAS_TRACE_SCOPE( "Computing interpolation weights" ) {
+        atlas_omp_parallel_for( size_t p = 0; p < points.size(); ++p ) {
+            const size_t ip  = points[p];
+            Triplet* triplet = weights_triplets.data() + p * stencil_size;
+            failed[p]        = !stencil( lonlat[2 * ip + 0], lonlat[2 * ip + 1], ip, triplet );
+        }
+    }
+
+    std::vector<size_t> failures;
+    for ( size_t p = 0; p < points.size(); ++p ) {
+        if ( failed[p] ) { failures.push_back( points[p] ); }
+    }
+    if ( failures.size() ) {
+        // Rows of points interpolated on other tasks stay empty
+        size_t n = 0;
+        for ( size_t p = 0; p < points.size(); ++p ) {
+            if ( !failed[p] ) {
+                const auto block = weights_triplets.begin() + p * stencil_size;
+                std::copy( block, block + stencil_size, weights_triplets.begin() + n * stencil_size );
+                ++n;
+            }
+        }
+        weights_triplets.resize( n * stencil_size );
+    }
+
+    setup_remote( lonlat, failures, stencil );
+
+    // fill sparse matrix and return
+    Matrix A( out_npts, inp_npts, weights_triplets );
+    matrix_.swap( A );
+}
+
+void StructuredInterpolation::setup_remote( const std::vector<double>& lonlat, const std::vector<size_t>& failures,
+                                            const Stencil& stencil ) {
+    const auto& comm          = mpi::comm();
+    const size_t nproc        = comm.size();
+    const int rank            = int( comm.rank() );
+    const size_t stencil_size = width_ * width_;
+
+    size_t nb_failures = failures.size();
+    ATLAS_TRACE_MPI( ALLREDUCE ) { comm.allReduceInPlace( nb_failures, eckit::mpi::sum() ); }
+    remote_ = ( nb_failures > 0 );
+    if ( not remote_ ) { return; }
+
+    ATLAS_TRACE( "Redistributing points outside the source partition" );
+
+    // Every task receives the points that other tasks could not interpolate
+    std::vector<double> failed_lonlat;
+    failed_lonlat.reserve( 2 * failures.size() );
+    for ( size_t ip : failures ) {
+        failed_lonlat.push_back( lonlat[2 * ip + 0] );
+        failed_lonlat.push_back( lonlat[2 * ip + 1] );
+    }
+    eckit::mpi::Buffer<double> recv_lonlat( nproc );
+    ATLAS_TRACE_MPI( ALLGATHER ) { comm.allGatherv( failed_lonlat.begin(), failed_lonlat.end(), recv_lonlat ); }
+    const size_t nb_gathered = recv_lonlat.buffer.size() / 2;
+    ASSERT( nb_gathered == nb_failures );
+
+    // The lowest task with a full stencil for a point interpolates it
+    std::vector<Triplet> gathered_triplets( nb_gathered * stencil_size );
+    std::vector<int> server( nb_gathered );
+    atlas_omp_parallel_for( size_t g = 0; g < nb_gathered; ++g ) {
+        const bool found = stencil( recv_lonlat.buffer[2 * g + 0], recv_lonlat.buffer[2 * g + 1], g,
+                                    gathered_triplets.data() + g * stencil_size );
+        server[g] = found ? rank : int( nproc );
+    }
+    ATLAS_TRACE_MPI( ALLREDUCE ) { comm.allReduceInPlace( server.data(), server.size(), eckit::mpi::min() ); }
+
+    // Points found by no task make every task throw, each listing its own
+    const size_t first = recv_lonlat.displs[rank] / 2;
+    if ( std::count( server.begin(), server.end(), int( nproc ) ) ) {
+        std::vector<size_t> unresolved;
+        for ( size_t f = 0; f < failures.size(); ++f ) {
+            if ( server[first + f] == int( nproc ) ) { unresolved.push_back( failures[f] ); }
+        }
+        std::ostringstream msg;
+        msg << "Rank " << rank << " failed to find stencils for " << eckit::Plural( unresolved.size(), "point" )
+            << " outside the source partitions and halos:\n";
+        for ( size_t ip : unresolved ) {
+            msg << "\t(lon,lat) = (" << lonlat[2 * ip + 0] << "," << lonlat[2 * ip + 1] << ")\n";
+        }
+        if ( unresolved.size() ) { Log::error() << msg.str() << std::endl; }
+        throw eckit::SeriousBug( msg.str() );
+    }
+
+    // Points served by this task, ordered by requesting task
+    std::vector<Triplet> remote_triplets;
+    remote_send_counts_.assign( nproc, 0 );
+    size_t nb_served = 0;
+    for ( size_t p = 0; p < nproc; ++p ) {
+        const size_t begin = recv_lonlat.displs[p] / 2;
+        const size_t end   = begin + recv_lonlat.counts[p] / 2;
+        for ( size_t g = begin; g < end; ++g ) {
+            if ( server[g] == rank ) {
+                for ( size_t s = 0; s < stencil_size; ++s ) {
+                    const Triplet& t = gathered_triplets[g * stencil_size + s];
+                    remote_triplets.emplace_back( nb_served, t.col(), t.value() );
+                }
+                ++nb_served;
+                ++remote_send_counts_[p];
+            }
+        }
+    }
+    Matrix A( nb_served, source_.size(), remote_triplets );
+    remote_matrix_.swap( A );
+
+    // Points of this task received from each serving task, in the order they are sent
+    remote_points_.clear();
+    remote_recv_counts_.assign( nproc, 0 );
+    for ( size_t p = 0; p < nproc; ++p ) {
+        for ( size_t f = 0; f < failures.size(); ++f ) {
+            if ( server[first + f] == int( p ) ) {
+                remote_points_.push_back( failures[f] );
+                ++remote_recv_counts_[p];
+            }
+        }
+    }
+}
+
+void StructuredInterpolation::execute_remote( const Field& source, Field& target ) const {
+    if ( not remote_ ) { return; }
+    ATLAS_TRACE( "atlas::interpolation::method::StructuredInterpolation::execute_remote()" );
+
+    ASSERT( source.rank() <= 2 );
+    ASSERT( source.rank() == target.rank() );
+
+    const size_t nb_levels        = source.rank() > 1 ? source.shape( 1 ) : 1;
+    const size_t src_point_stride = source.stride( 0 );
+    const size_t src_level_stride = source.rank() > 1 ? source.stride( 1 ) : 0;
+    const size_t tgt_point_stride = target.stride( 0 );
+    const size_t tgt_level_stride = target.rank() > 1 ? target.stride( 1 ) : 0;
+
+    const double* src_data = source.data<double>();
+    double* tgt_data       = target.data<double>();
+
+    // Interpolate the points requested by other tasks
+    const size_t nb_served = remote_matrix_.rows();
+    std::vector<double> send( nb_served * nb_levels, 0. );
+    if ( nb_served ) {
+        const auto outer   = remote_matrix_.outer();
+        const auto inner   = remote_matrix_.inner();
+        const auto weights = remote_matrix_.data();
+        atlas_omp_parallel_for( size_t r = 0; r < nb_served; ++r ) {
+            double* y = send.data() + r * nb_levels;
+            for ( auto k = outer[r]; k < outer[r + 1]; ++k ) {
+                const double w  = weights[k];
+                const double* x = src_data + inner[k] * src_point_stride;
+                for ( size_t l = 0; l < nb_levels; ++l ) {
+                    y[l] += w * x[l * src_level_stride];
+                }
+            }
+        }
+    }
+
+    const size_t nproc = remote_send_counts_.size();
+    std::vector<int> sendcounts( nproc ), senddispls( nproc ), recvcounts( nproc ), recvdispls( nproc );
+    for ( size_t p = 0; p < nproc; ++p ) {
+        sendcounts[p] = remote_send_counts_[p] * int( nb_levels );
+        recvcounts[p] = remote_recv_counts_[p] * int( nb_levels );
+        senddispls[p] = p ? senddispls[p - 1] + sendcounts[p - 1] : 0;
+        recvdispls[p] = p ? recvdispls[p - 1] + recvcounts[p - 1] : 0;
+    }
+    std::vector<double> recv( remote_points_.size() * nb_levels );
+    ATLAS_TRACE_MPI( ALLTOALL ) {
+        mpi::comm().allToAllv( send.data(), sendcounts.data(), senddispls.data(), recv.data(), recvcounts.data(),
+                               recvdispls.data() );
+    }
+
+    for ( size_t r = 0; r < remote_points_.size(); ++r ) {
+        double* y = tgt_data + remote_points_[r] * tgt_point_stride;
+        for ( size_t l = 0; l < nb_levels; ++l ) {
+            y[l * tgt_level_stride] = recv[r * nb_levels + l];
+        }
+    }
+}
+
+void StructuredInterpolation::execute( const FieldSet& source, FieldSet& target ) const {
+    ATLAS_TRACE( "atlas::interpolation::method::StructuredInterpolation::execute()" );
+    FieldSet halo( source );
+    source_.haloExchange( halo );
+    Method::execute( source, target );
+    for ( size_t i = 0; i < source.size(); ++i ) {
+        Field tgt( target[i] );
+        execute_remote( source[i], tgt );
+    }
+}
+
+void StructuredInterpolation::execute( const Field& source, Field& target ) const {
+    ATLAS_TRACE( "atlas::interpolation::method::StructuredInterpolation::execute()" );
+    Field halo( source );
+    source_.haloExchange( halo );
+    Method::execute( source, target );
+    execute_remote( source, target );
+}
+
+}  // namespace method
+}  // namespace interpolation
+}  // namespace atlas
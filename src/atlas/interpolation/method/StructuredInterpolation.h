@@ -0,0 +1,85 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include "atlas/interpolation/method/Method.h"
+
+#include <vector>
+
+#include "atlas/functionspace/StructuredColumns.h"
+
+namespace atlas {
+namespace interpolation {
+namespace method {
+
+/**
+ * @brief Interpolation from a StructuredColumns source using its row layout, without building a mesh
+ *
+ * The stencil containing a target point is found by bisection over the latitudes of the
+ * source partition (including its halo), followed by arithmetic on the regular spacing of each row.
+ * The source halo should be at least 1 for linear and 2 for cubic stencils, and is exchanged before each
+ * execution. Target points of which the stencil is not within the local source partition and halo are
+ * interpolated on the lowest task that contains their stencil, and their values are sent back on each execution.
+ */
+class StructuredInterpolation : public Method {
+public:
+    virtual ~StructuredInterpolation() {}
+
+    virtual void setup( const FunctionSpace& source, const FunctionSpace& target ) override;
+
+    virtual void execute( const FieldSet& source, FieldSet& target ) const override;
+    virtual void execute( const Field& source, Field& target ) const override;
+
+protected:
+    /// @param width number of source points of the stencil in each direction (2: linear, 4: cubic)
+    StructuredInterpolation( const Config& config, size_t width ) : Method( config ), width_( width ) {}
+
+    /**
+     * @brief Compute the interpolation weights
+     * @param lonlat interleaved (lon,lat) coordinates of the target points
+     * @param skip target points without weights (ghost or halo points), may be empty
+     */
+    void setup( const std::vector<double>& lonlat, const std::vector<bool>& skip );
+
+private:
+    struct Stencil;
+
+    /// @brief Assign the target points that failed locally to tasks that contain their stencil (collective)
+    void setup_remote( const std::vector<double>& lonlat, const std::vector<size_t>& failures, const Stencil& );
+
+    /// @brief Interpolate the points requested by other tasks and receive the remotely interpolated points
+    void execute_remote( const Field& source, Field& target ) const;
+
+protected:
+    functionspace::StructuredColumns source_;
+    size_t width_;
+
+private:
+    bool remote_{false};                   // some target points, on any task, are interpolated remotely
+    Matrix remote_matrix_;                 // weights of the points interpolated for other tasks
+    std::vector<int> remote_send_counts_;  // number of points interpolated for each task
+    std::vector<int> remote_recv_counts_;  // number of points interpolated by each task
+    std::vector<size_t> remote_points_;    // target points interpolated remotely, in order of reception
+};
+
+class StructuredBilinear : public StructuredInterpolation {
+public:
+    StructuredBilinear( const Config& config ) : StructuredInterpolation( config, 2 ) {}
+};
+
+class StructuredBicubic : public StructuredInterpolation {
+public:
+    StructuredBicubic( const Config& config ) : StructuredInterpolation( config, 4 ) {}
+};
+
+}  // namespace method
+}  // namespace interpolation
+}  // namespace atlas
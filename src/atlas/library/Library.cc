@@ -18,6 +18,7 @@
 #include "eckit/runtime/Main.h"
 #include "eckit/utils/Translator.h"
 
+#include "atlas/array/Allocator.h"
 #include "atlas/library/Library.h"
 #include "atlas/library/config.h"
 #include "atlas/library/git_sha1.h"
@@ -74,7 +75,8 @@ Library::Library() :
     info_( getEnv( "ATLAS_INFO", true ) ),
     trace_( getEnv( "ATLAS_TRACE", false ) ),
     trace_report_( getEnv( "ATLAS_TRACE_REPORT", false ) ),
-    trace_barriers_( getEnv( "ATLAS_TRACE_BARRIERS", false ) ) {}
+    trace_barriers_( getEnv( "ATLAS_TRACE_BARRIERS", false ) ),
+    trace_counters_( getEnv( "ATLAS_TRACE_COUNTERS", false ) ) {}
 
 Library& Library::instance() {
     return libatlas;
@@ -119,6 +121,7 @@ void Library::initialise( const eckit::Parametrisation& config ) {
     if ( config.has( "trace" ) ) {
         config.get( "trace.barriers", trace_barriers_ );
         config.get( "trace.report", trace_report_ );
+        config.get( "trace.counters", trace_counters_ );
     }
 
     if ( not debug_ ) debug_channel_.reset();
@@ -142,6 +145,7 @@ void Library::initialise( const eckit::Parametrisation& config ) {
         out << "  log.debug       [" << str( debug() ) << "] \n";
         out << "  trace.barriers  [" << str( traceBarriers() ) << "] \n";
         out << "  trace.report    [" << str( trace_report_ ) << "] \n";
+        out << "  trace.counters  [" << str( traceCounters() ) << "] \n";
         out << " \n";
         out << atlas::Library::instance().information();
         out << std::flush;
@@ -153,7 +157,9 @@ void Library::initialise() {
 }
 
 void Library::finalise() {
-    if ( ATLAS_HAVE_TRACE && trace_report_ ) { Log::info() << atlas::Trace::report() << std::endl; }
+    if ( ATLAS_HAVE_TRACE && trace_report_ ) {
+        Log::info() << atlas::Trace::report() << array::Allocator::report() << std::endl;
+    }
 
     // Make sure that these specialised channels that wrap Log::info() are
     // destroyed before eckit::Log::info gets destroyed.
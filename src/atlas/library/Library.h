@@ -57,6 +57,8 @@ public:
 
     bool traceBarriers() const { return trace_barriers_; }
 
+    bool traceCounters() const { return trace_counters_; }
+
 protected:
     virtual const void* addr() const override;
 
@@ -65,6 +67,7 @@ protected:
     bool debug_{false};
     bool trace_barriers_{false};
     bool trace_report_{false};
+    bool trace_counters_{false};
     mutable std::unique_ptr<eckit::Channel> info_channel_;
     mutable std::unique_ptr<eckit::Channel> trace_channel_;
     mutable std::unique_ptr<eckit::Channel> debug_channel_;
@@ -130,6 +130,7 @@ void IrregularConnectivityImpl::clear() {
         data_[_counts_] = nullptr;
         // std::for_each(data_.begin(), data_.end(), [](array::Array* a){ a=0;});
     }
+    rows_    = 0;
     maxcols_ = 0;
     mincols_ = std::numeric_limits<size_t>::max();
     on_update();
@@ -197,6 +198,15 @@ void IrregularConnectivityImpl::add( size_t rows, size_t cols, const idx_t value
 
 //------------------------------------------------------------------------------------------------------
 
+void IrregularConnectivityImpl::reserve( size_t rows, size_t values ) {
+    if ( !owns_ ) throw eckit::AssertionFailed( "HybridConnectivity must be owned to be resized directly" );
+    data_[_displs_]->reserve( rows + 1 );
+    data_[_counts_]->reserve( rows + 1 );
+    data_[_values_]->reserve( values );
+}
+
+//------------------------------------------------------------------------------------------------------
+
 void IrregularConnectivityImpl::add( const BlockConnectivityImpl& block ) {
     if ( !owns_ ) throw eckit::AssertionFailed( "HybridConnectivity must be owned to be resized directly" );
     bool fortran_array  = FORTRAN_BASE;
@@ -810,6 +820,13 @@ void BlockConnectivityImpl::add( size_t rows, size_t cols, const idx_t values[],
 
 //------------------------------------------------------------------------------------------------------
 
+void BlockConnectivityImpl::reserve( size_t rows ) {
+    if ( !owns_ ) throw eckit::AssertionFailed( "BlockConnectivity must be owned to be resized directly" );
+    if ( cols_ != 0 ) { values_->reserve( rows ); }
+}
+
+//------------------------------------------------------------------------------------------------------
+
 size_t BlockConnectivityImpl::footprint() const {
     size_t size = sizeof( *this );
     if ( owns() ) size += values_->footprint();
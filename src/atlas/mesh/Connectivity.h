@@ -273,6 +273,11 @@ public:
     /// @note Can only be used when data is owned.
     virtual void insert( size_t position, size_t rows, const size_t cols[] );
 
+    /// @brief Reserve storage for a total of given rows and values, so that add() and insert()
+    /// do not reallocate until these are exceeded
+    /// @note Can only be used when data is owned.
+    void reserve( size_t rows, size_t values );
+
     virtual void clear();
 
     virtual size_t footprint() const;
@@ -563,6 +568,11 @@ public:
     /// @note Can only be used when data is owned.
     void add( size_t rows, size_t cols, const idx_t values[], bool fortran_array = false );
 
+    /// @brief Reserve storage for a total of given rows, so that add() does not reallocate
+    /// until these are exceeded. Has no effect before the number of columns is known.
+    /// @note Can only be used when data is owned.
+    void reserve( size_t rows );
+
     void cloneToDevice();
     void cloneFromDevice();
     void syncHostDevice() const;
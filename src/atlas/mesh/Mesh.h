@@ -42,6 +42,11 @@ namespace atlas {
 namespace meshgenerator {
 class MeshGeneratorImpl;
 }
+namespace output {
+namespace detail {
+class MeshSnapshotIO;
+}
+}  // namespace output
 }  // namespace atlas
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -134,6 +139,7 @@ private:  // methods
     }
 
     friend class meshgenerator::MeshGeneratorImpl;
+    friend class output::detail::MeshSnapshotIO;
     void setProjection( const Projection& p ) { impl_->setProjection( p ); }
     void setGrid( const Grid& p ) { impl_->setGrid( p ); }
 
@@ -90,6 +90,12 @@ Field& Nodes::field( const std::string& name ) {
     return const_cast<Field&>( static_cast<const Nodes*>( this )->field( name ) );
 }
 
+void Nodes::reserve( size_t size ) {
+    for ( FieldMap::iterator it = fields_.begin(); it != fields_.end(); ++it ) {
+        it->second.array().reserve( size );
+    }
+}
+
 void Nodes::resize( size_t size ) {
     size_t previous_size = size_;
     size_                = size;
@@ -109,6 +109,10 @@ public:  // methods
 
     void resize( size_t );
 
+    /// @brief Reserve storage in all fields for given number of nodes, so that resize() does
+    /// not reallocate until it is exceeded
+    void reserve( size_t );
+
     void remove_field( const std::string& name );
 
     Connectivity& add( mesh::Connectivity* );
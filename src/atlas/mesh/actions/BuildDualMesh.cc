@@ -27,6 +27,7 @@
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/actions/BuildDualMesh.h"
 #include "atlas/parallel/Checksum.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/ErrorHandling.h"
 #include "atlas/runtime/Trace.h"
 #include "atlas/util/CoordinateEnums.h"
@@ -80,6 +81,43 @@ inline double sqr( double a ) {
     return a * a;
 }
 
+/// Edges connected to only one cell, for each node, in increasing edge order
+class NodeToBoundaryEdges {
+public:
+    NodeToBoundaryEdges( const mesh::HybridElements& edges, size_t nb_nodes ) : begin_( nb_nodes + 1, 0 ) {
+        const mesh::HybridElements::Connectivity& edge_node_connectivity = edges.node_connectivity();
+        const mesh::HybridElements::Connectivity& edge_cell_connectivity = edges.cell_connectivity();
+        const size_t nb_edges                                            = edges.size();
+        auto is_bdry_edge = [&]( size_t jedge ) {
+            return edge_cell_connectivity( jedge, 0 ) != edge_cell_connectivity.missing_value() &&
+                   edge_cell_connectivity( jedge, 1 ) == edge_cell_connectivity.missing_value();
+        };
+        for ( size_t jedge = 0; jedge < nb_edges; ++jedge ) {
+            if ( is_bdry_edge( jedge ) ) {
+                ++begin_[edge_node_connectivity( jedge, 0 ) + 1];
+                ++begin_[edge_node_connectivity( jedge, 1 ) + 1];
+            }
+        }
+        for ( size_t jnode = 0; jnode < nb_nodes; ++jnode ) {
+            begin_[jnode + 1] += begin_[jnode];
+        }
+        edges_.resize( begin_[nb_nodes] );
+        std::vector<size_t> end( begin_.begin(), begin_.end() - 1 );
+        for ( size_t jedge = 0; jedge < nb_edges; ++jedge ) {
+            if ( is_bdry_edge( jedge ) ) {
+                edges_[end[edge_node_connectivity( jedge, 0 )]++] = jedge;
+                edges_[end[edge_node_connectivity( jedge, 1 )]++] = jedge;
+            }
+        }
+    }
+    size_t size( size_t node ) const { return begin_[node + 1] - begin_[node]; }
+    idx_t operator()( size_t node, size_t j ) const { return edges_[begin_[node] + j]; }
+
+private:
+    std::vector<size_t> begin_;
+    std::vector<idx_t> edges_;
+};
+
 }  // namespace
 
 array::Array* build_centroids_xy( const mesh::HybridElements&, const Field& xy );
@@ -141,7 +179,7 @@ array::Array* build_centroids_xy( const mesh::HybridElements& elements, const Fi
     array::ArrayView<double, 2> centroids = array::make_view<double, 2>( *array_centroids );
     size_t nb_elems                       = elements.size();
     const mesh::HybridElements::Connectivity& elem_nodes = elements.node_connectivity();
-    for ( size_t e = 0; e < nb_elems; ++e ) {
+    atlas_omp_parallel_for( size_t e = 0; e < nb_elems; ++e ) {
         centroids( e, XX )               = 0.;
         centroids( e, YY )               = 0.;
         const size_t nb_nodes_per_elem   = elem_nodes.cols( e );
@@ -170,32 +208,72 @@ void add_median_dual_volume_contribution_cells( const mesh::HybridElements& cell
     auto patch = array::make_view<int, 1>( cells.field( "patch" ) );
 
     // special ordering for bit-identical results
-    size_t nb_cells = cells.size();
+    const size_t nb_cells = cells.size();
     std::vector<Node> ordering( nb_cells );
-    for ( size_t jcell = 0; jcell < nb_cells; ++jcell )
+    atlas_omp_parallel_for( size_t jcell = 0; jcell < nb_cells; ++jcell ) {
         ordering[jcell] =
             Node( util::unique_lonlat( cell_centroids( jcell, XX ), cell_centroids( jcell, YY ) ), jcell );
+    }
     std::sort( ordering.data(), ordering.data() + nb_cells );
 
+    // Contributions are stored in above order of cells, and summed per node in that same order,
+    // so that results do not depend on the number of threads.
+    std::vector<size_t> contribution_begin( nb_cells + 1, 0 );
     for ( size_t jcell = 0; jcell < nb_cells; ++jcell ) {
+        idx_t icell = ordering[jcell].i;
+        contribution_begin[jcell + 1] =
+            contribution_begin[jcell] + ( patch( icell ) ? 0 : 2 * cell_edge_connectivity.cols( icell ) );
+    }
+    const size_t nb_contributions = contribution_begin[nb_cells];
+    std::vector<idx_t> contribution_node( nb_contributions );
+    std::vector<double> contribution_area( nb_contributions );
+
+    atlas_omp_parallel_for( size_t jcell = 0; jcell < nb_cells; ++jcell ) {
         idx_t icell = ordering[jcell].i;
         if ( patch( icell ) ) continue;
         double x0 = cell_centroids( icell, XX );
         double y0 = cell_centroids( icell, YY );
 
+        size_t c = contribution_begin[jcell];
         for ( size_t jedge = 0; jedge < cell_edge_connectivity.cols( icell ); ++jedge ) {
             idx_t iedge = cell_edge_connectivity( icell, jedge );
             double x1   = edge_centroids( iedge, XX );
             double y1   = edge_centroids( iedge, YY );
             for ( size_t jnode = 0; jnode < 2; ++jnode ) {
-                idx_t inode       = edge_node_connectivity( iedge, jnode );
-                double x2         = xy( inode, XX );
-                double y2         = xy( inode, YY );
-                double triag_area = std::abs( x0 * ( y1 - y2 ) + x1 * ( y2 - y0 ) + x2 * ( y0 - y1 ) ) * 0.5;
-                dual_volumes( inode ) += triag_area;
+                idx_t inode          = edge_node_connectivity( iedge, jnode );
+                double x2            = xy( inode, XX );
+                double y2            = xy( inode, YY );
+                contribution_node[c] = inode;
+                contribution_area[c] = std::abs( x0 * ( y1 - y2 ) + x1 * ( y2 - y0 ) + x2 * ( y0 - y1 ) ) * 0.5;
+                ++c;
             }
         }
     }
+
+    // Group contributions by node, keeping their order
+    const size_t nb_nodes = nodes.size();
+    std::vector<size_t> node_begin( nb_nodes + 1, 0 );
+    for ( size_t c = 0; c < nb_contributions; ++c ) {
+        ++node_begin[contribution_node[c] + 1];
+    }
+    for ( size_t jnode = 0; jnode < nb_nodes; ++jnode ) {
+        node_begin[jnode + 1] += node_begin[jnode];
+    }
+    std::vector<size_t> node_contributions( nb_contributions );
+    {
+        std::vector<size_t> node_end( node_begin.begin(), node_begin.end() - 1 );
+        for ( size_t c = 0; c < nb_contributions; ++c ) {
+            node_contributions[node_end[contribution_node[c]]++] = c;
+        }
+    }
+
+    atlas_omp_parallel_for( size_t jnode = 0; jnode < nb_nodes; ++jnode ) {
+        double dual_volume = dual_volumes( jnode );
+        for ( size_t j = node_begin[jnode]; j < node_begin[jnode + 1]; ++j ) {
+            dual_volume += contribution_area[node_contributions[j]];
+        }
+        dual_volumes( jnode ) = dual_volume;
+    }
 }
 
 void add_median_dual_volume_contribution_poles( const mesh::HybridElements& edges, const mesh::Nodes& nodes,
@@ -208,29 +286,19 @@ void add_median_dual_volume_contribution_poles( const mesh::HybridElements& edge
     const mesh::HybridElements::Connectivity& edge_node_connectivity = edges.node_connectivity();
     const mesh::HybridElements::Connectivity& edge_cell_connectivity = edges.cell_connectivity();
 
-    const size_t nb_edges = edges.size();
-    std::map<idx_t, std::vector<idx_t>> node_to_bdry_edge;
-    for ( size_t jedge = 0; jedge < nb_edges; ++jedge ) {
-        if ( edge_cell_connectivity( jedge, 0 ) != edge_cell_connectivity.missing_value() &&
-             edge_cell_connectivity( jedge, 1 ) == edge_cell_connectivity.missing_value() ) {
-            node_to_bdry_edge[edge_node_connectivity( jedge, 0 )].push_back( jedge );
-            node_to_bdry_edge[edge_node_connectivity( jedge, 1 )].push_back( jedge );
-        }
-    }
+    const NodeToBoundaryEdges node_to_bdry_edge( edges, nodes.size() );
 
     const double tol = 1.e-6;
     double min[2], max[2];
     global_bounding_box( nodes, min, max );
 
-    std::map<idx_t, std::vector<idx_t>>::iterator it;
-    for ( it = node_to_bdry_edge.begin(); it != node_to_bdry_edge.end(); ++it ) {
-        const size_t jnode             = ( *it ).first;
-        std::vector<idx_t>& bdry_edges = ( *it ).second;
-        const double x0                = xy( jnode, XX );
-        const double y0                = xy( jnode, YY );
+    const size_t nb_nodes = nodes.size();
+    atlas_omp_parallel_for( size_t jnode = 0; jnode < nb_nodes; ++jnode ) {
+        const double x0 = xy( jnode, XX );
+        const double y0 = xy( jnode, YY );
         double x1, y1, y2;
-        for ( size_t jedge = 0; jedge < bdry_edges.size(); ++jedge ) {
-            const size_t iedge = bdry_edges[jedge];
+        for ( size_t jedge = 0; jedge < node_to_bdry_edge.size( jnode ); ++jedge ) {
+            const size_t iedge = node_to_bdry_edge( jnode, jedge );
             x1                 = edge_centroids( iedge, XX );
             y1                 = edge_centroids( iedge, YY );
 
@@ -262,7 +330,6 @@ void build_dual_normals( Mesh& mesh ) {
     global_bounding_box( nodes, min, max );
     double tol = 1.e-6;
 
-    double xl, yl, xr, yr;
     array::ArrayView<double, 2> edge_centroids = array::make_view<double, 2>( edges.field( "centroids_xy" ) );
     array::ArrayView<double, 2> dual_normals   = array::make_view<double, 2>(
         edges.add( Field( "dual_normals", array::make_datatype<double>(), array::make_shape( nb_edges, 2 ) ) ) );
@@ -270,26 +337,18 @@ void build_dual_normals( Mesh& mesh ) {
     const mesh::HybridElements::Connectivity& edge_node_connectivity = edges.node_connectivity();
     const mesh::HybridElements::Connectivity& edge_cell_connectivity = edges.cell_connectivity();
 
-    std::map<idx_t, std::vector<idx_t>> node_to_bdry_edge;
-    for ( size_t jedge = 0; jedge < nb_edges; ++jedge ) {
-        if ( edge_cell_connectivity( jedge, 0 ) != edge_cell_connectivity.missing_value() &&
-             edge_cell_connectivity( jedge, 1 ) == edge_cell_connectivity.missing_value() ) {
-            node_to_bdry_edge[edge_node_connectivity( jedge, 0 )].push_back( jedge );
-            node_to_bdry_edge[edge_node_connectivity( jedge, 1 )].push_back( jedge );
-        }
-    }
+    const NodeToBoundaryEdges node_to_bdry_edge( edges, nodes.size() );
 
-    for ( size_t edge = 0; edge < nb_edges; ++edge ) {
+    atlas_omp_parallel_for( size_t edge = 0; edge < nb_edges; ++edge ) {
         if ( edge_cell_connectivity( edge, 0 ) == edge_cell_connectivity.missing_value() ) {
             // this is a pole edge
             // only compute for one node
             for ( size_t n = 0; n < 2; ++n ) {
-                idx_t node                     = edge_node_connectivity( edge, n );
-                std::vector<idx_t>& bdry_edges = node_to_bdry_edge[node];
+                idx_t node = edge_node_connectivity( edge, n );
                 double x[2];
                 size_t cnt = 0;
-                for ( size_t jedge = 0; jedge < bdry_edges.size(); ++jedge ) {
-                    idx_t bdry_edge = bdry_edges[jedge];
+                for ( size_t jedge = 0; jedge < node_to_bdry_edge.size( node ); ++jedge ) {
+                    idx_t bdry_edge = node_to_bdry_edge( node, jedge );
                     if ( std::abs( edge_centroids( bdry_edge, YY ) - max[YY] ) < tol ) {
                         edge_centroids( edge, YY ) = 90.;
                         x[cnt]                     = edge_centroids( bdry_edge, XX );
@@ -315,6 +374,7 @@ void build_dual_normals( Mesh& mesh ) {
             }
         }
         else {
+            double xl, yl, xr, yr;
             idx_t left_elem  = edge_cell_connectivity( edge, 0 );
             idx_t right_elem = edge_cell_connectivity( edge, 1 );
             xl               = elem_centroids( left_elem, XX );
@@ -350,7 +410,7 @@ void make_dual_normals_outward( Mesh& mesh ) {
     array::ArrayView<double, 2> dual_normals = array::make_view<double, 2>( edges.field( "dual_normals" ) );
     const size_t nb_edges                    = edges.size();
 
-    for ( size_t edge = 0; edge < nb_edges; ++edge ) {
+    atlas_omp_parallel_for( size_t edge = 0; edge < nb_edges; ++edge ) {
         if ( edge_cell_connectivity( edge, 0 ) != edge_cell_connectivity.missing_value() ) {
             // Make normal point from node 1 to node 2
             const size_t ip1 = edge_node_connectivity( edge, 0 );
@@ -9,6 +9,7 @@
  */
 
 #include "atlas/mesh/actions/BuildEdges.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <limits>
@@ -27,6 +28,7 @@
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/detail/AccumulateFacets.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/ErrorHandling.h"
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/LonLatMicroDeg.h"
@@ -45,16 +47,32 @@ namespace actions {
 //----------------------------------------------------------------------------------------------------------------------
 
 namespace {  // anonymous
-struct Sort {
-    Sort() {}
-    Sort( gidx_t gid, int idx ) {
-        g = gid;
-        i = idx;
+std::vector<gidx_t> compute_edge_uids( Mesh& mesh ) {
+    ATLAS_TRACE();
+    const size_t nb_edges                                = mesh.edges().size();
+    const mesh::HybridElements::Connectivity& edge_nodes = mesh.edges().node_connectivity();
+    const UniqueLonLat compute_uid( mesh );
+    std::vector<gidx_t> edge_uid( nb_edges );
+    compute_uid( edge_nodes, 0, nb_edges, edge_uid.data() );
+    return edge_uid;
+}
+
+// Order the first "size" edges in given row by unique edge index, and by edge index if equal.
+// Rows contain only a handful of edges, so insertion sort is used.
+template <typename Connectivity>
+void sort_row( Connectivity& connectivity, size_t row, size_t size, const std::vector<gidx_t>& edge_uid ) {
+    auto less = [&]( idx_t a, idx_t b ) {
+        return edge_uid[a] < edge_uid[b] || ( edge_uid[a] == edge_uid[b] && a < b );
+    };
+    for ( size_t j = 1; j < size; ++j ) {
+        const idx_t edge = connectivity( row, j );
+        size_t i         = j;
+        for ( ; i > 0 && less( edge, connectivity( row, i - 1 ) ); --i ) {
+            connectivity.set( row, i, connectivity( row, i - 1 ) );
+        }
+        connectivity.set( row, i, edge );
     }
-    gidx_t g;
-    int i;
-    bool operator<( const Sort& other ) const { return ( g < other.g ); }
-};
+}
 }  // anonymous namespace
 
 void build_element_to_edge_connectivity( Mesh& mesh ) {
@@ -83,36 +101,32 @@ void build_element_to_edge_connectivity( Mesh& mesh ) {
             new array::ArrayView<int, 1>( array::make_view<int, 1>( mesh.edges().field( "is_pole_edge" ) ) ) );
     }
 
-    // Sort edges for bit-reproducibility
-    std::vector<Sort> edge_sort;
-    edge_sort.reserve( nb_edges );
-    {
-        UniqueLonLat compute_uid( mesh );
-
-        for ( size_t jedge = 0; jedge < nb_edges; ++jedge )
-            edge_sort.emplace_back( Sort( compute_uid( edge_node_connectivity.row( jedge ) ), jedge ) );
-
-        std::sort( edge_sort.data(), edge_sort.data() + nb_edges );
-    }
-
-    // Fill in cell_edge_connectivity
+    // Fill in cell_edge_connectivity in order of edges
     std::vector<size_t> edge_cnt( mesh.cells().size() );
     for ( size_t jedge = 0; jedge < nb_edges; ++jedge ) {
-        int iedge = edge_sort[jedge].i;
         for ( size_t j = 0; j < 2; ++j ) {
-            idx_t elem = edge_cell_connectivity( iedge, j );
+            idx_t elem = edge_cell_connectivity( jedge, j );
 
             if ( elem != edge_cell_connectivity.missing_value() ) {
-                cell_edge_connectivity.set( elem, edge_cnt[elem]++, iedge );
+                cell_edge_connectivity.set( elem, edge_cnt[elem]++, jedge );
             }
             else {
-                if ( !( has_pole_edges && ( *is_pole_edge )( iedge ) ) ) {
+                if ( !( has_pole_edges && ( *is_pole_edge )( jedge ) ) ) {
                     if ( j == 0 ) throw eckit::SeriousBug( "edge has no element connected", Here() );
                 }
             }
         }
     }
 
+    // Sort edges of each cell for bit-reproducibility
+    {
+        const std::vector<gidx_t> edge_uid = compute_edge_uids( mesh );
+        const size_t nb_cells              = mesh.cells().size();
+        atlas_omp_parallel_for( size_t jcell = 0; jcell < nb_cells; ++jcell ) {
+            sort_row( cell_edge_connectivity, jcell, edge_cnt[jcell], edge_uid );
+        }
+    }
+
     // Verify that all edges have been found
     for ( size_t jcell = 0; jcell < mesh.cells().size(); ++jcell ) {
         // If this is a patched element (over the pole), there were no edges
@@ -154,19 +168,19 @@ void build_node_to_edge_connectivity( Mesh& mesh ) {
     for ( size_t jnode = 0; jnode < nodes.size(); ++jnode )
         to_edge_size[jnode] = 0;
 
-    UniqueLonLat compute_uid( mesh );
-    std::vector<Sort> edge_sort( nb_edges );
-    for ( size_t jedge = 0; jedge < nb_edges; ++jedge )
-        edge_sort[jedge] = Sort( compute_uid( edge_node_connectivity.row( jedge ) ), jedge );
-    std::stable_sort( edge_sort.data(), edge_sort.data() + nb_edges );
-
     for ( size_t jedge = 0; jedge < nb_edges; ++jedge ) {
-        size_t iedge = edge_sort[jedge].i;
         for ( size_t j = 0; j < 2; ++j ) {
-            idx_t node = edge_node_connectivity( iedge, j );
-            node_to_edge.set( node, to_edge_size[node]++, iedge );
+            idx_t node = edge_node_connectivity( jedge, j );
+            node_to_edge.set( node, to_edge_size[node]++, jedge );
         }
     }
+
+    // Sort edges of each node for bit-reproducibility
+    const std::vector<gidx_t> edge_uid = compute_edge_uids( mesh );
+    const size_t nb_nodes              = nodes.size();
+    atlas_omp_parallel_for( size_t jnode = 0; jnode < nb_nodes; ++jnode ) {
+        sort_row( node_to_edge, jnode, to_edge_size[jnode], edge_uid );
+    }
 }
 
 void accumulate_pole_edges( mesh::Nodes& nodes, std::vector<idx_t>& pole_edge_nodes, size_t& nb_pole_edges ) {
@@ -281,8 +295,6 @@ void build_edges( Mesh& mesh ) {
     mesh::Nodes& nodes            = mesh.nodes();
     array::ArrayView<int, 1> part = array::make_view<int, 1>( nodes.partition() );
 
-    size_t nb_nodes = nodes.size();
-
     // storage for edge-to-node-connectivity shape=(nb_edges,2)
     std::vector<idx_t> edge_nodes_data;
     std::vector<idx_t> edge_to_elem_data;
@@ -299,38 +311,42 @@ void build_edges( Mesh& mesh ) {
 
     UniqueLonLat compute_uid( mesh );
 
+    // Every node and cell is compared by several edges, so compute their unique ids only once
+    std::vector<uidx_t> node_uid( nodes.size() );
+    std::vector<uidx_t> cell_uid( mesh.cells().size() );
+    compute_uid( 0, nodes.size(), node_uid.data() );
+    compute_uid( cell_nodes, 0, mesh.cells().size(), cell_uid.data() );
+
     array::IndexView<idx_t, 1> edge_ridx     = array::make_indexview<idx_t, 1>( mesh.edges().remote_index() );
     array::ArrayView<int, 1> edge_part       = array::make_view<int, 1>( mesh.edges().partition() );
     array::ArrayView<gidx_t, 1> edge_glb_idx = array::make_view<gidx_t, 1>( mesh.edges().global_index() );
 
     ASSERT( cell_nodes.missing_value() == missing_value );
-    for ( size_t edge = 0; edge < nb_edges; ++edge ) {
+    atlas_omp_parallel_for( size_t edge = 0; edge < nb_edges; ++edge ) {
         const int ip1 = edge_nodes( edge, 0 );
         const int ip2 = edge_nodes( edge, 1 );
-        if ( compute_uid( ip1 ) > compute_uid( ip2 ) ) {
+        if ( node_uid[ip1] > node_uid[ip2] ) {
             idx_t swapped[2] = {ip2, ip1};
             edge_nodes.set( edge, swapped );
         }
 
-        ASSERT( size_t( edge_nodes( edge, 0 ) ) < nb_nodes );
-        ASSERT( size_t( edge_nodes( edge, 1 ) ) < nb_nodes );
-        edge_glb_idx( edge ) = compute_uid( edge_nodes.row( edge ) );
-        edge_part( edge )    = std::min( part( edge_nodes( edge, 0 ) ), part( edge_nodes( edge, 1 ) ) );
-        edge_ridx( edge )    = edge;
+        edge_part( edge ) = std::min( part( edge_nodes( edge, 0 ) ), part( edge_nodes( edge, 1 ) ) );
+        edge_ridx( edge ) = edge;
 
         const idx_t e1 = edge_to_elem_data[2 * edge + 0];
         const idx_t e2 = edge_to_elem_data[2 * edge + 1];
 
-        ASSERT( e1 != cell_nodes.missing_value() );
         if ( e2 == cell_nodes.missing_value() ) {
             // do nothing
         }
-        else if ( compute_uid( cell_nodes.row( e1 ) ) > compute_uid( cell_nodes.row( e2 ) ) ) {
+        else if ( cell_uid[e1] > cell_uid[e2] ) {
             edge_to_elem_data[edge * 2 + 0] = e2;
             edge_to_elem_data[edge * 2 + 1] = e1;
         }
     }
 
+    compute_uid( edge_nodes, 0, nb_edges, edge_glb_idx.data() );
+
     mesh.edges().cell_connectivity().add( nb_edges, 2, edge_to_elem_data.data() );
 
     build_element_to_edge_connectivity( mesh );
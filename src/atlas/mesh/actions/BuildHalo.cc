@@ -410,10 +410,12 @@ void build_lookup_uid2node( Mesh& mesh, Uid2Node& uid2node ) {
     size_t nb_nodes                     = nodes.size();
 
     UniqueLonLat compute_uid( mesh );
+    std::vector<uid_t> node_uid( nb_nodes );
+    compute_uid( 0, nb_nodes, node_uid.data() );
 
     uid2node.clear();
     for ( size_t jnode = 0; jnode < nb_nodes; ++jnode ) {
-        uid_t uid     = compute_uid( jnode );
+        uid_t uid     = node_uid[jnode];
         bool inserted = uid2node.insert( std::make_pair( uid, jnode ) ).second;
         if ( not inserted ) {
             int other = uid2node[uid];
@@ -707,8 +709,6 @@ public:
                 buf.node_xy[p][jnode * 2 + XX] = xy( node, XX );
                 buf.node_xy[p][jnode * 2 + YY] = xy( node, YY );
                 transform( &buf.node_xy[p][jnode * 2], -1 );
-                // Global index of node is based on UID of destination
-                buf.node_glb_idx[p][jnode] = util::unique_lonlat( &buf.node_xy[p][jnode * 2] );
                 Topology::set( buf.node_flags[p][jnode], newflags );
             }
             else {
@@ -717,6 +717,8 @@ public:
                 ASSERT( false );
             }
         }
+        // Global index of node is based on UID of destination
+        util::unique_lonlat_points( buf.node_xy[p].data(), nb_nodes, buf.node_glb_idx[p].data() );
 
         size_t nb_elems = elems.size();
 
@@ -731,24 +733,25 @@ public:
         buf.elem_type[p].resize( nb_elems );
         buf.elem_nodes_id[p].resize( nb_elem_nodes );
         buf.elem_nodes_displs[p].resize( nb_elems );
+        std::vector<double> crds( nb_elem_nodes * 2 );
         size_t jelemnode( 0 );
         for ( size_t jelem = 0; jelem < nb_elems; ++jelem ) {
             buf.elem_nodes_displs[p][jelem] = jelemnode;
             size_t ielem                    = elems[jelem];
             buf.elem_part[p][jelem]         = elem_part( ielem );
             buf.elem_type[p][jelem]         = mesh.cells().type_idx( ielem );
-            std::vector<double> crds( elem_nodes->cols( ielem ) * 2 );
-            for ( size_t jnode = 0; jnode < elem_nodes->cols( ielem ); ++jnode ) {
-                double crd[] = {xy( ( *elem_nodes )( ielem, jnode ), XX ), xy( ( *elem_nodes )( ielem, jnode ), YY )};
+            double* elem_crds               = &crds[jelemnode * 2];
+            for ( size_t jnode = 0; jnode < elem_nodes->cols( ielem ); ++jnode, ++jelemnode ) {
+                double* crd = &crds[jelemnode * 2];
+                crd[XX]     = xy( ( *elem_nodes )( ielem, jnode ), XX );
+                crd[YY]     = xy( ( *elem_nodes )( ielem, jnode ), YY );
                 transform( crd, -1 );
-                buf.elem_nodes_id[p][jelemnode++] = util::unique_lonlat( crd );
-                crds[jnode * 2 + XX]              = crd[XX];
-                crds[jnode * 2 + YY]              = crd[YY];
             }
             // Global index of element is based on UID of destination
 
-            buf.elem_glb_idx[p][jelem] = -util::unique_lonlat( crds.data(), elem_nodes->cols( ielem ) );
+            buf.elem_glb_idx[p][jelem] = -util::unique_lonlat( elem_crds, elem_nodes->cols( ielem ) );
         }
+        util::unique_lonlat_points( crds.data(), nb_elem_nodes, buf.elem_nodes_id[p].data() );
     }
 
     void add_nodes( Buffers& buf, bool periodic ) {
@@ -765,9 +768,7 @@ public:
         std::set<uid_t> new_node_uid;
         {
             ATLAS_TRACE( "compute node_uid" );
-            for ( int jnode = 0; jnode < nb_nodes; ++jnode ) {
-                node_uid[jnode] = compute_uid( jnode );
-            }
+            compute_uid( 0, nb_nodes, node_uid.data() );
             std::sort( node_uid.begin(), node_uid.end() );
         }
         auto node_already_exists = [&node_uid, &new_node_uid]( uid_t uid ) {
@@ -788,10 +789,12 @@ public:
         }
 
         int nb_new_nodes = 0;
+        std::vector<uid_t> recv_node_uid;
         for ( size_t jpart = 0; jpart < mpi_size; ++jpart ) {
-            for ( size_t n = 0; n < buf.node_glb_idx[jpart].size(); ++n ) {
-                double crd[] = {buf.node_xy[jpart][n * 2 + XX], buf.node_xy[jpart][n * 2 + YY]};
-                if ( not node_already_exists( util::unique_lonlat( crd ) ) ) { rfn_idx[jpart].push_back( n ); }
+            recv_node_uid.resize( buf.node_glb_idx[jpart].size() );
+            util::unique_lonlat_points( buf.node_xy[jpart].data(), recv_node_uid.size(), recv_node_uid.data() );
+            for ( size_t n = 0; n < recv_node_uid.size(); ++n ) {
+                if ( not node_already_exists( recv_node_uid[n] ) ) { rfn_idx[jpart].push_back( n ); }
             }
             nb_new_nodes += rfn_idx[jpart].size();
         }
@@ -862,8 +865,10 @@ public:
         std::set<uid_t> new_elem_uid;
         {
             ATLAS_TRACE( "compute elem_uid" );
+            std::vector<uid_t> elem_centroid_uid( nb_elems );
+            compute_uid( *elem_nodes, 0, nb_elems, elem_centroid_uid.data() );
             for ( int jelem = 0; jelem < nb_elems; ++jelem ) {
-                elem_uid[jelem * 2 + 0] = -compute_uid( elem_nodes->row( jelem ) );
+                elem_uid[jelem * 2 + 0] = -elem_centroid_uid[jelem];
                 elem_uid[jelem * 2 + 1] = cell_gidx( jelem );
             }
             std::sort( elem_uid.begin(), elem_uid.end() );
@@ -1053,8 +1058,12 @@ void increase_halo_interior( BuildHaloHelper& helper ) {
     // 2) Communicate uid of these boundary nodes to other partitions
 
     std::vector<uid_t> send_bdry_nodes_uid( bdry_nodes.size() );
-    for ( size_t jnode = 0; jnode < bdry_nodes.size(); ++jnode )
-        send_bdry_nodes_uid[jnode] = helper.compute_uid( bdry_nodes[jnode] );
+    std::vector<double> bdry_nodes_xy( 2 * bdry_nodes.size() );
+    for ( size_t jnode = 0; jnode < bdry_nodes.size(); ++jnode ) {
+        bdry_nodes_xy[2 * jnode + XX] = helper.xy( bdry_nodes[jnode], XX );
+        bdry_nodes_xy[2 * jnode + YY] = helper.xy( bdry_nodes[jnode], YY );
+    }
+    util::unique_lonlat_points( bdry_nodes_xy.data(), bdry_nodes.size(), send_bdry_nodes_uid.data() );
 
     size_t mpi_size = mpi::comm().size();
     atlas::mpi::Buffer<uid_t, 1> recv_bdry_nodes_uid_from_parts( mpi_size );
@@ -1149,13 +1158,14 @@ void increase_halo_periodic( BuildHaloHelper& helper, const PeriodicPoints& peri
     // partitions
 
     std::vector<uid_t> send_bdry_nodes_uid( bdry_nodes.size() );
+    std::vector<double> bdry_nodes_xy( 2 * bdry_nodes.size() );
     for ( size_t jnode = 0; jnode < bdry_nodes.size(); ++jnode ) {
-        double crd[] = {helper.xy( bdry_nodes[jnode], XX ), helper.xy( bdry_nodes[jnode], YY )};
+        double* crd = &bdry_nodes_xy[2 * jnode];
+        crd[XX]     = helper.xy( bdry_nodes[jnode], XX );
+        crd[YY]     = helper.xy( bdry_nodes[jnode], YY );
         transform( crd, +1 );
-        // Log::info() << " crd  " << crd[0] << "  " << crd[1] <<  "       uid " <<
-        // util::unique_lonlat(crd) << std::endl;
-        send_bdry_nodes_uid[jnode] = util::unique_lonlat( crd );
     }
+    util::unique_lonlat_points( bdry_nodes_xy.data(), bdry_nodes.size(), send_bdry_nodes_uid.data() );
 
     size_t mpi_size = mpi::comm().size();
     atlas::mpi::Buffer<uid_t, 1> recv_bdry_nodes_uid_from_parts( mpi_size );
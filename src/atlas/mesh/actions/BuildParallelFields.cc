@@ -117,6 +117,7 @@ void build_edges_parallel_fields( Mesh& mesh ) {
     ATLAS_TRACE();
     build_edges_partition( mesh );
     build_edges_remote_idx( mesh );
+    mesh.edges().metadata().set( "parallel", true );
     /*
  * We turn following off. It is expensive and we don't really care about a nice
  * contiguous
@@ -23,6 +23,7 @@
 #include "atlas/runtime/ErrorHandling.h"
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/LonLatMicroDeg.h"
+#include "atlas/util/Unique.h"
 
 using Topology = atlas::mesh::Nodes::Topology;
 using atlas::mesh::detail::PeriodicTransform;
@@ -65,7 +66,6 @@ void build_periodic_boundaries( Mesh& mesh ) {
                 Topology::set( flags( jnode ), Topology::PERIODIC );
                 if ( part( jnode ) == mypart ) {
                     LonLatMicroDeg ll( xy( jnode, XX ), xy( jnode, YY ) );
-                    master_lookup[ll.unique()] = jnode;
                     master_nodes.push_back( ll.lon() );
                     master_nodes.push_back( ll.lat() );
                     master_nodes.push_back( jnode );
@@ -76,7 +76,6 @@ void build_periodic_boundaries( Mesh& mesh ) {
                 Topology::set( flags( jnode ), Topology::GHOST );
                 ghost( jnode ) = 1;
                 LonLatMicroDeg ll( xy( jnode, XX ), xy( jnode, YY ) );
-                slave_lookup[ll.unique()] = jnode;
                 slave_nodes.push_back( ll.lon() );
                 slave_nodes.push_back( ll.lat() );
                 slave_nodes.push_back( jnode );
@@ -84,6 +83,20 @@ void build_periodic_boundaries( Mesh& mesh ) {
             }
         }
 
+        // master_nodes and slave_nodes store (lon,lat,jnode) triplets in microdegrees
+        {
+            std::vector<uid_t> uid( master_nodes.size() / 3 );
+            util::unique_lonlat_microdeg_points( master_nodes.data(), uid.size(), uid.data(), 3 );
+            for ( size_t n = 0; n < uid.size(); ++n ) {
+                master_lookup[uid[n]] = master_nodes[3 * n + 2];
+            }
+            uid.resize( slave_nodes.size() / 3 );
+            util::unique_lonlat_microdeg_points( slave_nodes.data(), uid.size(), uid.data(), 3 );
+            for ( size_t n = 0; n < uid.size(); ++n ) {
+                slave_lookup[uid[n]] = slave_nodes[3 * n + 2];
+            }
+        }
+
         std::vector<std::vector<int>> found_master( mpi::comm().size() );
         std::vector<std::vector<int>> send_slave_idx( mpi::comm().size() );
 
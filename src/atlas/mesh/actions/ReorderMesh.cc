@@ -0,0 +1,516 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "atlas/array.h"
+#include "atlas/array/ArrayView.h"
+#include "atlas/array/IndexView.h"
+#include "atlas/field/Field.h"
+#include "atlas/library/config.h"
+#include "atlas/mesh/Connectivity.h"
+#include "atlas/mesh/Elements.h"
+#include "atlas/mesh/HybridElements.h"
+#include "atlas/mesh/Mesh.h"
+#include "atlas/mesh/Nodes.h"
+#include "atlas/mesh/actions/ReorderMesh.h"
+#include "atlas/parallel/HaloExchange.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/ErrorHandling.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/Earth.h"
+#include "atlas/util/Point.h"
+
+#if ATLAS_HAVE_FORTRAN
+#define REMOTE_IDX_BASE 1
+#else
+#define REMOTE_IDX_BASE 0
+#endif
+
+namespace atlas {
+namespace mesh {
+namespace actions {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+namespace {
+
+// Throughout, "order" maps a new index to the old index, and "perm" maps an old index to the new index.
+
+std::vector<idx_t> inverse( const std::vector<idx_t>& order ) {
+    std::vector<idx_t> perm( order.size() );
+    atlas_omp_parallel_for( size_t i = 0; i < order.size(); ++i ) { perm[order[i]] = i; }
+    return perm;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+// Number of bits per coordinate of the space-filling curves, such that the key of 3 coordinates fits in 64 bits
+constexpr int sfc_bits = 21;
+
+uint64_t interleave( const uint32_t X[3] ) {
+    uint64_t key = 0;
+    for ( int b = sfc_bits - 1; b >= 0; --b ) {
+        for ( int i = 0; i < 3; ++i ) {
+            key = ( key << 1 ) | ( ( X[i] >> b ) & 1u );
+        }
+    }
+    return key;
+}
+
+uint64_t morton_key( uint32_t X[3] ) {
+    return interleave( X );
+}
+
+// Hilbert index, following J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707 (2004):
+// the coordinates are transformed in place to the "transposed" Hilbert index, which is then interleaved.
+uint64_t hilbert_key( uint32_t X[3] ) {
+    constexpr int n  = 3;
+    const uint32_t M = 1u << ( sfc_bits - 1 );
+    uint32_t t;
+
+    // Inverse undo
+    for ( uint32_t Q = M; Q > 1; Q >>= 1 ) {
+        const uint32_t P = Q - 1;
+        for ( int i = 0; i < n; ++i ) {
+            if ( X[i] & Q ) { X[0] ^= P; }
+            else {
+                t = ( X[0] ^ X[i] ) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+        }
+    }
+
+    // Gray encode
+    for ( int i = 1; i < n; ++i ) {
+        X[i] ^= X[i - 1];
+    }
+    t = 0;
+    for ( uint32_t Q = M; Q > 1; Q >>= 1 ) {
+        if ( X[n - 1] & Q ) { t ^= Q - 1; }
+    }
+    for ( int i = 0; i < n; ++i ) {
+        X[i] ^= t;
+    }
+    return interleave( X );
+}
+
+// Keys of the nodes along a space-filling curve through the bounding box of their (x,y,z) coordinates
+std::vector<uint64_t> space_filling_curve_keys( const mesh::Nodes& nodes, bool hilbert ) {
+    const size_t nb_nodes = nodes.size();
+    auto lonlat           = array::make_view<double, 2>( nodes.lonlat() );
+
+    std::vector<double> xyz( 3 * nb_nodes );
+    atlas_omp_parallel_for( size_t n = 0; n < nb_nodes; ++n ) {
+        const PointLonLat p1( lonlat( n, 0 ), lonlat( n, 1 ) );
+        PointXYZ p2;
+        util::Earth::convertSphericalToCartesian( p1, p2 );
+        xyz[3 * n + 0] = p2.x();
+        xyz[3 * n + 1] = p2.y();
+        xyz[3 * n + 2] = p2.z();
+    }
+
+    double min[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                     std::numeric_limits<double>::max()};
+    double max[3] = {-std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(),
+                     -std::numeric_limits<double>::max()};
+    for ( size_t n = 0; n < nb_nodes; ++n ) {
+        for ( int d = 0; d < 3; ++d ) {
+            min[d] = std::min( min[d], xyz[3 * n + d] );
+            max[d] = std::max( max[d], xyz[3 * n + d] );
+        }
+    }
+
+    // Same scale in all directions, so that the curve does not favour the direction of smallest extent
+    double extent = 0.;
+    for ( int d = 0; d < 3; ++d ) {
+        extent = std::max( extent, max[d] - min[d] );
+    }
+    const double scale = extent > 0. ? double( ( 1u << sfc_bits ) - 1 ) / extent : 0.;
+
+    std::vector<uint64_t> keys( nb_nodes );
+    atlas_omp_parallel_for( size_t n = 0; n < nb_nodes; ++n ) {
+        uint32_t X[3];
+        for ( int d = 0; d < 3; ++d ) {
+            X[d] = static_cast<uint32_t>( ( xyz[3 * n + d] - min[d] ) * scale );
+        }
+        keys[n] = hilbert ? hilbert_key( X ) : morton_key( X );
+    }
+    return keys;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+// Boundaries of the ranges of nodes that are reordered independently: one range per halo level.
+// The end of halo level 0 is not stored in the metadata; the last node referenced by a cell of
+// halo 0 is used instead, which may keep a few trailing nodes of halo 0 in the range of halo 1.
+std::vector<size_t> node_blocks( const Mesh& mesh ) {
+    std::vector<size_t> blocks( 1, 0 );
+
+    int halo = 0;
+    mesh.metadata().get( "halo", halo );
+    if ( halo > 0 && mesh.cells().has_field( "halo" ) ) {
+        const mesh::HybridElements::Connectivity& cell_nodes = mesh.cells().node_connectivity();
+        auto cell_halo                                       = array::make_view<int, 1>( mesh.cells().halo() );
+        idx_t end                                            = 0;
+        for ( size_t c = 0; c < mesh.cells().size(); ++c ) {
+            if ( cell_halo( c ) == 0 ) {
+                for ( size_t j = 0; j < cell_nodes.cols( c ); ++j ) {
+                    end = std::max( end, cell_nodes( c, j ) + 1 );
+                }
+            }
+        }
+        blocks.push_back( end );
+    }
+    for ( int h = 1; h <= halo; ++h ) {
+        std::stringstream ss;
+        ss << "nb_nodes_including_halo[" << h << "]";
+        size_t end;
+        if ( mesh.metadata().get( ss.str(), end ) ) { blocks.push_back( end ); }
+    }
+    blocks.push_back( mesh.nodes().size() );
+    for ( size_t b = 1; b < blocks.size(); ++b ) {
+        ASSERT( blocks[b - 1] <= blocks[b] );
+    }
+    return blocks;
+}
+
+std::vector<idx_t> space_filling_curve_order( const Mesh& mesh, bool hilbert ) {
+    const std::vector<uint64_t> keys = space_filling_curve_keys( mesh.nodes(), hilbert );
+    const std::vector<size_t> blocks = node_blocks( mesh );
+
+    std::vector<idx_t> order( mesh.nodes().size() );
+    for ( size_t n = 0; n < order.size(); ++n ) {
+        order[n] = n;
+    }
+    for ( size_t b = 1; b < blocks.size(); ++b ) {
+        std::sort( order.begin() + blocks[b - 1], order.begin() + blocks[b], [&keys]( idx_t n1, idx_t n2 ) {
+            return keys[n1] != keys[n2] ? keys[n1] < keys[n2] : n1 < n2;
+        } );
+    }
+    return order;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+// Node to node adjacency in compressed row format, from the edges if present, or else from the cell boundaries
+void node_graph( const Mesh& mesh, std::vector<size_t>& displs, std::vector<idx_t>& neighbours ) {
+    const size_t nb_nodes = mesh.nodes().size();
+
+    std::vector<idx_t> pairs;
+    if ( mesh.edges().size() ) {
+        const mesh::HybridElements::Connectivity& edge_nodes = mesh.edges().node_connectivity();
+        pairs.reserve( 2 * mesh.edges().size() );
+        for ( size_t e = 0; e < mesh.edges().size(); ++e ) {
+            pairs.push_back( edge_nodes( e, 0 ) );
+            pairs.push_back( edge_nodes( e, 1 ) );
+        }
+    }
+    else {
+        const mesh::HybridElements::Connectivity& cell_nodes = mesh.cells().node_connectivity();
+        for ( size_t c = 0; c < mesh.cells().size(); ++c ) {
+            const size_t nb_cell_nodes = cell_nodes.cols( c );
+            for ( size_t j = 0; j < nb_cell_nodes; ++j ) {
+                pairs.push_back( cell_nodes( c, j ) );
+                pairs.push_back( cell_nodes( c, ( j + 1 ) % nb_cell_nodes ) );
+            }
+        }
+    }
+
+    displs.assign( nb_nodes + 1, 0 );
+    for ( size_t p = 0; p < pairs.size(); p += 2 ) {
+        ++displs[pairs[p] + 1];
+        ++displs[pairs[p + 1] + 1];
+    }
+    for ( size_t n = 0; n < nb_nodes; ++n ) {
+        displs[n + 1] += displs[n];
+    }
+    neighbours.resize( displs[nb_nodes] );
+    std::vector<size_t> pos( displs.begin(), displs.end() - 1 );
+    for ( size_t p = 0; p < pairs.size(); p += 2 ) {
+        neighbours[pos[pairs[p]]++]     = pairs[p + 1];
+        neighbours[pos[pairs[p + 1]]++] = pairs[p];
+    }
+
+    // Remove duplicates: interior cell boundaries are visited from both sides
+    std::vector<size_t> counts( nb_nodes );
+    atlas_omp_parallel_for( size_t n = 0; n < nb_nodes; ++n ) {
+        auto begin = neighbours.begin() + displs[n];
+        std::sort( begin, neighbours.begin() + displs[n + 1] );
+        counts[n] = std::unique( begin, neighbours.begin() + displs[n + 1] ) - begin;
+    }
+    size_t c = 0;
+    for ( size_t n = 0; n < nb_nodes; ++n ) {
+        const size_t begin = displs[n];
+        displs[n]          = c;
+        for ( size_t j = 0; j < counts[n]; ++j ) {
+            neighbours[c++] = neighbours[begin + j];
+        }
+    }
+    displs[nb_nodes] = c;
+    neighbours.resize( c );
+}
+
+std::vector<idx_t> reverse_cuthill_mckee_order( const Mesh& mesh ) {
+    std::vector<size_t> displs;
+    std::vector<idx_t> neighbours;
+    node_graph( mesh, displs, neighbours );
+
+    const std::vector<size_t> blocks = node_blocks( mesh );
+    const size_t nb_nodes            = mesh.nodes().size();
+
+    auto degree    = [&displs]( idx_t n ) { return displs[n + 1] - displs[n]; };
+    auto by_degree = [&degree]( idx_t n1, idx_t n2 ) {
+        return degree( n1 ) != degree( n2 ) ? degree( n1 ) < degree( n2 ) : n1 < n2;
+    };
+
+    std::vector<idx_t> order( nb_nodes );
+    std::vector<char> visited( nb_nodes, 0 );
+    std::vector<idx_t> candidates;
+    for ( size_t b = 1; b < blocks.size(); ++b ) {
+        const idx_t begin = blocks[b - 1];
+        const idx_t end   = blocks[b];
+
+        // Breadth-first traversals of the block, starting from unvisited nodes of lowest degree
+        candidates.resize( end - begin );
+        for ( idx_t n = begin; n < end; ++n ) {
+            candidates[n - begin] = n;
+        }
+        std::sort( candidates.begin(), candidates.end(), by_degree );
+
+        size_t next = begin;
+        for ( idx_t start : candidates ) {
+            if ( visited[start] ) continue;
+            visited[start] = 1;
+            order[next++]  = start;
+            for ( size_t head = next - 1; head < next; ++head ) {
+                const idx_t n      = order[head];
+                const size_t first = next;
+                for ( size_t j = displs[n]; j < displs[n + 1]; ++j ) {
+                    const idx_t m = neighbours[j];
+                    if ( m >= begin && m < end && !visited[m] ) {
+                        visited[m]    = 1;
+                        order[next++] = m;
+                    }
+                }
+                std::sort( order.begin() + first, order.begin() + next, by_degree );
+            }
+        }
+        ASSERT( next == size_t( end ) );
+        std::reverse( order.begin() + begin, order.begin() + end );
+    }
+    return order;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+// Elements are ordered by the lowest new index of their nodes, within each element type and halo level
+std::vector<idx_t> element_order( const mesh::HybridElements& elements, const std::vector<idx_t>& node_perm ) {
+    const size_t nb_elements                        = elements.size();
+    const mesh::HybridElements::Connectivity& nodes = elements.node_connectivity();
+    const idx_t missing                             = nodes.missing_value();
+
+    std::vector<idx_t> key( nb_elements );
+    atlas_omp_parallel_for( size_t e = 0; e < nb_elements; ++e ) {
+        idx_t k = std::numeric_limits<idx_t>::max();
+        for ( size_t j = 0; j < nodes.cols( e ); ++j ) {
+            const idx_t n = nodes( e, j );
+            if ( n != missing ) { k = std::min( k, node_perm[n] ); }
+        }
+        key[e] = k;
+    }
+
+    std::vector<int> halo( nb_elements, 0 );
+    if ( elements.has_field( "halo" ) ) {
+        auto elem_halo = array::make_view<int, 1>( elements.halo() );
+        for ( size_t e = 0; e < nb_elements; ++e ) {
+            halo[e] = elem_halo( e );
+        }
+    }
+
+    std::vector<idx_t> order( nb_elements );
+    for ( size_t e = 0; e < nb_elements; ++e ) {
+        order[e] = e;
+    }
+    for ( size_t t = 0; t < elements.nb_types(); ++t ) {
+        std::sort( order.begin() + elements.elements( t ).begin(), order.begin() + elements.elements( t ).end(),
+                   [&]( idx_t e1, idx_t e2 ) {
+                       if ( halo[e1] != halo[e2] ) return halo[e1] < halo[e2];
+                       if ( key[e1] != key[e2] ) return key[e1] < key[e2];
+                       return e1 < e2;
+                   } );
+    }
+    return order;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+void permute_rows( array::Array& array, const std::vector<idx_t>& order ) {
+    const size_t rows = order.size();
+    ASSERT( array.shape( 0 ) == rows );
+    const size_t row_bytes = array.stride( 0 ) * array.sizeof_data();
+    char* data             = static_cast<char*>( array.storage() );
+    const std::vector<char> copy( data, data + rows * row_bytes );
+    atlas_omp_parallel_for( size_t i = 0; i < rows; ++i ) {
+        std::memcpy( data + i * row_bytes, copy.data() + order[i] * row_bytes, row_bytes );
+    }
+}
+
+// Permute the rows of a connectivity table, and renumber its values.
+// An empty order or perm leaves the rows or values respectively unchanged.
+void permute_connectivity( mesh::IrregularConnectivityImpl& connectivity, const std::vector<idx_t>& order,
+                           const std::vector<idx_t>& perm ) {
+    const size_t rows = connectivity.rows();
+    if ( rows == 0 ) return;
+    if ( order.size() ) ASSERT( order.size() == rows );
+
+    const idx_t missing = connectivity.missing_value();
+    std::vector<size_t> counts( rows );
+    std::vector<size_t> displs( rows + 1, 0 );
+    for ( size_t i = 0; i < rows; ++i ) {
+        counts[i]     = connectivity.cols( i );
+        displs[i + 1] = displs[i] + counts[i];
+    }
+    std::vector<idx_t> values( displs[rows] );
+    atlas_omp_parallel_for( size_t i = 0; i < rows; ++i ) {
+        for ( size_t j = 0; j < counts[i]; ++j ) {
+            const idx_t v         = connectivity( i, j );
+            values[displs[i] + j] = ( perm.empty() || v == missing ) ? v : perm[v];
+        }
+    }
+
+    auto old_row = [&order]( size_t i ) -> size_t { return order.empty() ? i : order[i]; };
+
+    bool same_shape = true;
+    for ( size_t i = 0; i < rows; ++i ) {
+        if ( counts[old_row( i )] != counts[i] ) {
+            same_shape = false;
+            break;
+        }
+    }
+    if ( !same_shape ) {
+        // Only rows of different length within an element type would require rebuilding the blocks
+        ASSERT( dynamic_cast<mesh::MultiBlockConnectivityImpl*>( &connectivity ) == nullptr );
+        std::vector<size_t> new_counts( rows );
+        for ( size_t i = 0; i < rows; ++i ) {
+            new_counts[i] = counts[old_row( i )];
+        }
+        connectivity.clear();
+        connectivity.add( rows, new_counts.data() );
+    }
+
+    atlas_omp_parallel_for( size_t i = 0; i < rows; ++i ) { connectivity.set( i, values.data() + displs[old_row( i )] ); }
+}
+
+// Set remote indices to the new local indices at the owners, before the rows are permuted
+void renumber_remote_index( Field& partition, Field& remote_index, const std::vector<idx_t>& perm ) {
+    const size_t size = perm.size();
+
+    parallel::HaloExchange halo_exchange;
+    halo_exchange.setup( array::make_view<int, 1>( partition ).data(),
+                         array::make_view<int, 1>( remote_index ).data(), REMOTE_IDX_BASE, size );
+
+    array::ArrayT<int> new_index( size );
+    auto new_idx = array::make_view<int, 1>( new_index );
+    atlas_omp_parallel_for( size_t i = 0; i < size; ++i ) { new_idx( i ) = perm[i]; }
+    halo_exchange.execute<int, 1>( new_index );
+
+    auto ridx = array::make_indexview<int, 1>( remote_index );
+    atlas_omp_parallel_for( size_t i = 0; i < size; ++i ) { ridx( i ) = new_idx( i ); }
+}
+
+// Without parallel fields every row is its own owner, so remote indices are the new local indices
+void reset_remote_index( Field& remote_index ) {
+    const size_t size = remote_index.shape( 0 );
+    auto ridx         = array::make_indexview<int, 1>( remote_index );
+    atlas_omp_parallel_for( size_t i = 0; i < size; ++i ) { ridx( i ) = i; }
+}
+
+void permute_nodes( mesh::Nodes& nodes, const std::vector<idx_t>& order, const std::vector<idx_t>& perm,
+                    const std::vector<idx_t>& edge_perm, const std::vector<idx_t>& cell_perm ) {
+    bool parallel = false;
+    nodes.metadata().get( "parallel", parallel );
+    if ( parallel ) { renumber_remote_index( nodes.partition(), nodes.remote_index(), perm ); }
+
+    for ( size_t f = 0; f < nodes.nb_fields(); ++f ) {
+        permute_rows( nodes.field( f ).array(), order );
+    }
+    if ( not parallel ) { reset_remote_index( nodes.remote_index() ); }
+    permute_connectivity( nodes.edge_connectivity(), order, edge_perm );
+    permute_connectivity( nodes.cell_connectivity(), order, cell_perm );
+}
+
+void permute_elements( mesh::HybridElements& elements, const std::vector<idx_t>& order,
+                       const std::vector<idx_t>& perm, const std::vector<idx_t>& node_perm,
+                       const std::vector<idx_t>& edge_perm, const std::vector<idx_t>& cell_perm ) {
+    bool parallel = false;
+    elements.metadata().get( "parallel", parallel );
+    if ( parallel ) { renumber_remote_index( elements.partition(), elements.remote_index(), perm ); }
+
+    for ( size_t f = 0; f < elements.nb_fields(); ++f ) {
+        permute_rows( elements.field( f ).array(), order );
+    }
+    if ( not parallel ) { reset_remote_index( elements.remote_index() ); }
+    permute_connectivity( elements.node_connectivity(), order, node_perm );
+    permute_connectivity( elements.edge_connectivity(), order, edge_perm );
+    permute_connectivity( elements.cell_connectivity(), order, cell_perm );
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+
+ReorderMesh::ReorderMesh( const std::string& type ) : type_( type ) {
+    if ( type_ != "hilbert" && type_ != "morton" && type_ != "reverse_cuthill_mckee" ) {
+        throw eckit::BadParameter( "Unknown mesh reordering \"" + type_ +
+                                       "\". Possible values: hilbert, morton, reverse_cuthill_mckee",
+                                   Here() );
+    }
+}
+
+void ReorderMesh::operator()( Mesh& mesh ) const {
+    ATLAS_TRACE( "ReorderMesh(" + type_ + ")" );
+
+    std::vector<idx_t> node_order;
+    ATLAS_TRACE_SCOPE( "node order" ) {
+        node_order = ( type_ == "reverse_cuthill_mckee" ) ? reverse_cuthill_mckee_order( mesh )
+                                                          : space_filling_curve_order( mesh, type_ == "hilbert" );
+    }
+    const std::vector<idx_t> node_perm  = inverse( node_order );
+    const std::vector<idx_t> edge_order = element_order( mesh.edges(), node_perm );
+    const std::vector<idx_t> edge_perm  = inverse( edge_order );
+    const std::vector<idx_t> cell_order = element_order( mesh.cells(), node_perm );
+    const std::vector<idx_t> cell_perm  = inverse( cell_order );
+
+    ATLAS_TRACE_SCOPE( "permute" ) {
+        permute_nodes( mesh.nodes(), node_order, node_perm, edge_perm, cell_perm );
+        permute_elements( mesh.edges(), edge_order, edge_perm, node_perm, edge_perm, cell_perm );
+        permute_elements( mesh.cells(), cell_order, cell_perm, node_perm, edge_perm, cell_perm );
+    }
+
+    mesh.get()->resetPolygons();
+}
+
+void reorder_mesh( Mesh& mesh, const std::string& type ) {
+    ReorderMesh reorder( type );
+    reorder( mesh );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace actions
+}  // namespace mesh
+}  // namespace atlas
@@ -0,0 +1,55 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <string>
+
+namespace atlas {
+class Mesh;
+}  // namespace atlas
+
+namespace atlas {
+namespace mesh {
+namespace actions {
+
+//----------------------------------------------------------------------------------------------------------------------
+
+/// @brief Renumber nodes, edges and cells of a mesh to improve memory locality
+///
+/// Nodes are sorted along a space-filling curve through their (x,y,z) coordinates on the sphere
+/// (type "hilbert" or "morton"), or by Reverse Cuthill-McKee on the node graph (type "reverse_cuthill_mckee").
+/// Edges and cells follow the new node numbering, so that elements sharing nodes are stored close together.
+///
+/// Nodes are only reordered within each halo level, and elements within each element type and halo level,
+/// so that the metadata "nb_nodes_including_halo[#]" and the element type blocks remain valid.
+/// All fields, connectivities, remote indices and the partition polygons of the mesh are updated consistently.
+/// Remote indices of ghost nodes (and of ghost edges after build_edges_parallel_fields) are exchanged with
+/// their owners, so this action must be called collectively by all MPI tasks.
+///
+/// @note Apply this action before any halo exchange, gather/scatter or numerical method (e.g. fvm::Method)
+///       is set up on the mesh, as these cache local indices.
+class ReorderMesh {
+public:
+    explicit ReorderMesh( const std::string& type = "hilbert" );
+
+    void operator()( Mesh& ) const;
+
+private:
+    std::string type_;
+};
+
+void reorder_mesh( Mesh& mesh, const std::string& type = "hilbert" );
+
+//----------------------------------------------------------------------------------------------------------------------
+
+}  // namespace actions
+}  // namespace mesh
+}  // namespace atlas
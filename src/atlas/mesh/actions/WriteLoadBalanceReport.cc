@@ -11,6 +11,7 @@
 #include <fstream>
 #include <iomanip>
 
+#include "eckit/config/Configuration.h"
 #include "eckit/filesystem/PathName.h"
 
 #include "atlas/mesh/HybridElements.h"
@@ -20,6 +21,8 @@
 #include "atlas/mesh/actions/WriteLoadBalanceReport.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/runtime/ErrorHandling.h"
+#include "atlas/runtime/trace/Timings.h"
+#include "atlas/util/Config.h"
 
 using atlas::mesh::IsGhostNode;
 
@@ -28,18 +31,61 @@ namespace mesh {
 namespace actions {
 
 void write_load_balance_report( const Mesh& mesh, const std::string& filename ) {
+    write_load_balance_report( mesh, filename, util::NoConfig() );
+}
+
+void write_load_balance_report( const Mesh& mesh, const std::string& filename, const eckit::Configuration& config ) {
     std::ofstream ofs;
     if ( mpi::comm().rank() == 0 ) {
         eckit::PathName path( filename );
         ofs.open( path.localPath(), std::ofstream::out );
     }
 
-    write_load_balance_report( mesh, ofs );
+    write_load_balance_report( mesh, ofs, config );
 
     if ( mpi::comm().rank() == 0 ) { ofs.close(); }
 }
 
+namespace {
+void write_timings_report( std::ostream& ofs, const eckit::Configuration& config ) {
+    using runtime::trace::Timings;
+    std::vector<Timings::Aggregated> timers = Timings::aggregate( config );
+
+    if ( mpi::comm().rank() == 0 ) {
+        int idt = 12;
+        ofs << "#----------------------------------------------------\n";
+        ofs << "# TIMERS (accumulated time per task, reduced over tasks)\n";
+        ofs << std::setw( 6 ) << "# id";
+        ofs << std::setw( idt ) << "count";
+        ofs << std::setw( idt ) << "tasks";
+        ofs << std::setw( idt ) << "min(s)";
+        ofs << std::setw( idt ) << "avg(s)";
+        ofs << std::setw( idt ) << "max(s)";
+        ofs << std::setw( idt ) << "imbalance";
+        ofs << std::setw( idt ) << "slowest";
+        ofs << "  title\n";
+        for ( size_t j = 0; j < timers.size(); ++j ) {
+            const auto& t = timers[j];
+            if ( t.excluded ) continue;
+            ofs << std::setw( 6 ) << j;
+            ofs << std::setw( idt ) << t.count;
+            ofs << std::setw( idt ) << t.ntasks;
+            ofs << std::setw( idt ) << std::fixed << std::setprecision( 5 ) << t.min;
+            ofs << std::setw( idt ) << std::fixed << std::setprecision( 5 ) << t.avg;
+            ofs << std::setw( idt ) << std::fixed << std::setprecision( 5 ) << t.max;
+            ofs << std::setw( idt ) << std::fixed << std::setprecision( 2 ) << t.imbalance();
+            ofs << std::setw( idt ) << t.slowest;
+            ofs << "  " << std::string( 2 * ( t.nest - 1 ), ' ' ) << t.title << "\n";
+        }
+    }
+}
+}  // namespace
+
 void write_load_balance_report( const Mesh& mesh, std::ostream& ofs ) {
+    write_load_balance_report( mesh, ofs, util::NoConfig() );
+}
+
+void write_load_balance_report( const Mesh& mesh, std::ostream& ofs, const eckit::Configuration& config ) {
     size_t npart = mpi::comm().size();
     size_t root  = 0;
 
@@ -202,6 +248,8 @@ void write_load_balance_report( const Mesh& mesh, std::ostream& ofs ) {
             ofs << "\n";
         }
     }
+
+    if ( config.getBool( "timings", false ) ) { write_timings_report( ofs, config ); }
 }
 
 // ------------------------------------------------------------------
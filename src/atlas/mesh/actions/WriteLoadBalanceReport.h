@@ -10,6 +10,13 @@
 
 #pragma once
 
+#include <iosfwd>
+#include <string>
+
+namespace eckit {
+class Configuration;
+}
+
 namespace atlas {
 class Mesh;
 namespace mesh {
@@ -18,6 +25,12 @@ namespace actions {
 void write_load_balance_report( const Mesh& mesh, std::ostream& ofs );
 void write_load_balance_report( const Mesh& mesh, const std::string& filename );
 
+/// Configuration options:
+///  - timings : append trace timers reduced over all MPI tasks, with load imbalance (default false)
+///  - depth, exclude : filter timers, as in atlas::Trace::report()
+void write_load_balance_report( const Mesh& mesh, std::ostream& ofs, const eckit::Configuration& );
+void write_load_balance_report( const Mesh& mesh, const std::string& filename, const eckit::Configuration& );
+
 // ------------------------------------------------------------------
 // C wrapper interfaces to C++ routines
 
@@ -8,113 +8,160 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
+
 #include "eckit/exception/Exceptions.h"
 
 #include "atlas/mesh/Elements.h"
 #include "atlas/mesh/HybridElements.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/mesh/detail/AccumulateFacets.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Trace.h"
 
 namespace atlas {
 namespace mesh {
 namespace detail {
 
+namespace {
+constexpr size_t nb_nodes_in_facet = 2;
+
+const int quadrilateral_facets[4][nb_nodes_in_facet] = {{0, 1}, {1, 2}, {2, 3}, {3, 0}};
+const int triangle_facets[3][nb_nodes_in_facet]      = {{0, 1}, {1, 2}, {2, 0}};
+}  // namespace
+
+/*
+ * Every facet of every (non-patch) element is a "slot", numbered by element type, element and
+ * facet within the element. This is the order in which facets are visited, and facets are numbered
+ * by the slot in which they first occur. Slots are paired by their sorted node tuple (a,b) with a<=b:
+ * slots are bucketed by node a (a direct-address hash, counted in O(N) without sorting), and
+ * within each bucket -- containing only the few facets around node a -- the slots with equal
+ * node b are matched. Buckets are independent, so matching is done in parallel, as are the
+ * extraction of slots and the filling of the output. The result is identical to a serial search.
+ */
 void accumulate_facets( const mesh::HybridElements& cells, const mesh::Nodes& nodes,
                         std::vector<idx_t>& facet_nodes_data,  // shape(nb_facets,nb_nodes_per_facet)
                         std::vector<idx_t>& connectivity_facet_to_elem, size_t& nb_facets, size_t& nb_inner_facets,
                         idx_t& missing_value ) {
     ATLAS_TRACE();
     missing_value = -1;
-    std::vector<std::vector<idx_t>> node_to_facet( nodes.size() );
-    for ( size_t j = 0; j < node_to_facet.size(); ++j ) {
-        node_to_facet[j].reserve( 6 );
-    }
-    nb_facets       = 0;
-    nb_inner_facets = 0;
-    if ( connectivity_facet_to_elem.size() == 0 ) { connectivity_facet_to_elem.reserve( 6 * cells.size() ); }
-    if ( facet_nodes_data.size() == 0 ) { facet_nodes_data.reserve( 6 * cells.size() ); }
-    for ( size_t t = 0; t < cells.nb_types(); ++t ) {
-        const mesh::Elements& elements            = cells.elements( t );
-        const mesh::BlockConnectivity& elem_nodes = elements.node_connectivity();
-        auto patch                                = elements.view<int, 1>( elements.field( "patch" ) );
 
-        size_t nb_elems          = elements.size();
-        size_t nb_nodes_in_facet = 2;
-
-        std::vector<std::vector<int>> facet_node_numbering;
-        size_t nb_facets_in_elem;
+    // Slot numbering
+    std::vector<size_t> slot_begin( cells.nb_types() + 1, 0 );
+    std::vector<size_t> nb_facets_in_elem( cells.nb_types() );
+    std::vector<const int ( * )[nb_nodes_in_facet]> facet_node_numbering( cells.nb_types() );
+    for ( size_t t = 0; t < cells.nb_types(); ++t ) {
+        const mesh::Elements& elements = cells.elements( t );
         if ( elements.name() == "Quadrilateral" ) {
-            nb_facets_in_elem = 4;
-            facet_node_numbering.resize( nb_facets_in_elem, std::vector<int>( nb_nodes_in_facet ) );
-            facet_node_numbering[0][0] = 0;
-            facet_node_numbering[0][1] = 1;
-            facet_node_numbering[1][0] = 1;
-            facet_node_numbering[1][1] = 2;
-            facet_node_numbering[2][0] = 2;
-            facet_node_numbering[2][1] = 3;
-            facet_node_numbering[3][0] = 3;
-            facet_node_numbering[3][1] = 0;
+            nb_facets_in_elem[t]    = 4;
+            facet_node_numbering[t] = quadrilateral_facets;
         }
         else if ( elements.name() == "Triangle" ) {
-            nb_facets_in_elem = 3;
-            facet_node_numbering.resize( nb_facets_in_elem, std::vector<int>( nb_nodes_in_facet ) );
-            facet_node_numbering[0][0] = 0;
-            facet_node_numbering[0][1] = 1;
-            facet_node_numbering[1][0] = 1;
-            facet_node_numbering[1][1] = 2;
-            facet_node_numbering[2][0] = 2;
-            facet_node_numbering[2][1] = 0;
+            nb_facets_in_elem[t]    = 3;
+            facet_node_numbering[t] = triangle_facets;
         }
         else {
             throw eckit::BadParameter( elements.name() + " is not \"Quadrilateral\" or \"Triangle\"", Here() );
         }
+        slot_begin[t + 1] = slot_begin[t] + nb_facets_in_elem[t] * elements.size();
+    }
+    const size_t nb_slots = slot_begin.back();
 
-        std::vector<idx_t> facet_nodes( nb_nodes_in_facet );
+    // Nodes of each slot, in orientation of its element. Slots of patch elements are marked missing.
+    std::vector<idx_t> slot_nodes( nb_nodes_in_facet * nb_slots );
+    std::vector<idx_t> slot_elem( nb_slots );
+    ATLAS_TRACE_SCOPE( "extract facets" ) {
+        for ( size_t t = 0; t < cells.nb_types(); ++t ) {
+            const mesh::Elements& elements            = cells.elements( t );
+            const mesh::BlockConnectivity& elem_nodes = elements.node_connectivity();
+            const auto patch                          = elements.view<int, 1>( elements.field( "patch" ) );
+            const size_t nb_elems                     = elements.size();
+            const size_t nf                           = nb_facets_in_elem[t];
+            const auto numbering                      = facet_node_numbering[t];
+            atlas_omp_parallel_for( size_t e = 0; e < nb_elems; ++e ) {
+                for ( size_t f = 0; f < nf; ++f ) {
+                    const size_t slot = slot_begin[t] + e * nf + f;
+                    slot_elem[slot]   = elements.begin() + e;
+                    for ( size_t n = 0; n < nb_nodes_in_facet; ++n ) {
+                        slot_nodes[nb_nodes_in_facet * slot + n] =
+                            patch( e ) ? missing_value : elem_nodes( e, numbering[f][n] );
+                    }
+                }
+            }
+        }
+    }
 
-        for ( size_t e = 0; e < nb_elems; ++e ) {
-            if ( patch( e ) ) continue;
-            for ( size_t f = 0; f < nb_facets_in_elem; ++f ) {
-                bool found_face = false;
+    auto key_a = [&]( size_t slot ) {
+        return std::min( slot_nodes[nb_nodes_in_facet * slot], slot_nodes[nb_nodes_in_facet * slot + 1] );
+    };
+    auto key_b = [&]( size_t slot ) {
+        return std::max( slot_nodes[nb_nodes_in_facet * slot], slot_nodes[nb_nodes_in_facet * slot + 1] );
+    };
 
-                for ( size_t jnode = 0; jnode < nb_nodes_in_facet; ++jnode ) {
-                    facet_nodes[jnode] = elem_nodes( e, facet_node_numbering[f][jnode] );
-                }
+    // Bucket slots by their smallest node, keeping slot order within each bucket
+    std::vector<size_t> bucket_begin( nodes.size() + 1, 0 );
+    std::vector<size_t> bucket;
+    ATLAS_TRACE_SCOPE( "bucket facets" ) {
+        for ( size_t slot = 0; slot < nb_slots; ++slot ) {
+            if ( slot_nodes[nb_nodes_in_facet * slot] != missing_value ) { ++bucket_begin[key_a( slot ) + 1]; }
+        }
+        for ( size_t jnode = 0; jnode < nodes.size(); ++jnode ) {
+            bucket_begin[jnode + 1] += bucket_begin[jnode];
+        }
+        bucket.resize( bucket_begin.back() );
+        std::vector<size_t> bucket_end( bucket_begin.begin(), bucket_begin.end() - 1 );
+        for ( size_t slot = 0; slot < nb_slots; ++slot ) {
+            if ( slot_nodes[nb_nodes_in_facet * slot] != missing_value ) {
+                bucket[bucket_end[key_a( slot )]++] = slot;
+            }
+        }
+    }
 
-                int node = facet_nodes[0];
-                for ( size_t jface = 0; jface < node_to_facet[node].size(); ++jface ) {
-                    int face                = node_to_facet[node][jface];
-                    size_t nb_matched_nodes = 0;
-                    if ( nb_nodes_in_facet > 1 )  // 2D or 3D
-                    {
-                        for ( size_t jnode = 0; jnode < nb_nodes_in_facet; ++jnode ) {
-                            size_t other_node = facet_nodes[jnode];
-                            for ( size_t iface = 0; iface < node_to_facet[other_node].size(); ++iface ) {
-                                if ( node_to_facet[facet_nodes[jnode]][iface] == face ) {
-                                    ++nb_matched_nodes;
-                                    break;
-                                }
-                            }
-                        }
-                        if ( nb_matched_nodes == nb_nodes_in_facet ) {
-                            connectivity_facet_to_elem[2 * face + 1] = e + elements.begin();
-                            ++nb_inner_facets;
-                            found_face = true;
-                            break;
-                        }
+    // For each slot the slot where its facet first occurs, and for each first occurrence
+    // the last slot sharing its facet
+    std::vector<size_t> owner( nb_slots, nb_slots );
+    std::vector<size_t> partner( nb_slots, nb_slots );
+    ATLAS_TRACE_SCOPE( "pair facets" ) {
+        const size_t nb_buckets = nodes.size();
+        atlas_omp_parallel_for( size_t jnode = 0; jnode < nb_buckets; ++jnode ) {
+            for ( size_t i = bucket_begin[jnode]; i < bucket_begin[jnode + 1]; ++i ) {
+                const size_t slot = bucket[i];
+                owner[slot]       = slot;
+                for ( size_t k = bucket_begin[jnode]; k < i; ++k ) {
+                    if ( owner[bucket[k]] == bucket[k] && key_b( bucket[k] ) == key_b( slot ) ) {
+                        owner[slot]        = bucket[k];
+                        partner[bucket[k]] = slot;
+                        break;
                     }
                 }
+            }
+        }
+    }
 
-                if ( found_face == false ) {
-                    connectivity_facet_to_elem.emplace_back( elements.begin() + e );
-                    // if 2nd element stays missing_value, it is a bdry face
-                    connectivity_facet_to_elem.emplace_back( missing_value );
-                    for ( size_t n = 0; n < nb_nodes_in_facet; ++n ) {
-                        node_to_facet[facet_nodes[n]].emplace_back( nb_facets );
-                        facet_nodes_data.emplace_back( facet_nodes[n] );
-                    }
-                    ++nb_facets;
+    // Number facets in order of first occurrence
+    std::vector<size_t> facet( nb_slots, nb_slots );
+    nb_facets       = 0;
+    nb_inner_facets = 0;
+    for ( size_t slot = 0; slot < nb_slots; ++slot ) {
+        if ( owner[slot] == slot ) { facet[slot] = nb_facets++; }
+        else if ( owner[slot] != nb_slots ) {
+            ++nb_inner_facets;
+        }
+    }
+
+    ATLAS_TRACE_SCOPE( "fill facets" ) {
+        facet_nodes_data.resize( nb_nodes_in_facet * nb_facets );
+        connectivity_facet_to_elem.resize( 2 * nb_facets );
+        atlas_omp_parallel_for( size_t slot = 0; slot < nb_slots; ++slot ) {
+            if ( facet[slot] != nb_slots ) {
+                const size_t jface = facet[slot];
+                for ( size_t n = 0; n < nb_nodes_in_facet; ++n ) {
+                    facet_nodes_data[nb_nodes_in_facet * jface + n] = slot_nodes[nb_nodes_in_facet * slot + n];
                 }
+                connectivity_facet_to_elem[2 * jface + 0] = slot_elem[slot];
+                // if 2nd element stays missing_value, it is a bdry face
+                connectivity_facet_to_elem[2 * jface + 1] =
+                    partner[slot] != nb_slots ? slot_elem[partner[slot]] : missing_value;
             }
         }
     }
@@ -151,6 +151,10 @@ const PartitionPolygon& MeshImpl::polygon( size_t halo ) const {
     return *polygons_[halo];
 }
 
+void MeshImpl::resetPolygons() {
+    polygons_.clear();
+}
+
 void MeshImpl::attachObserver( MeshObserver& observer ) const {
     if ( std::find( mesh_observers_.begin(), mesh_observers_.end(), &observer ) == mesh_observers_.end() ) {
         mesh_observers_.push_back( &observer );
@@ -104,6 +104,9 @@ public:  // methods
 
     const PartitionPolygon& polygon( size_t halo = 0 ) const;
 
+    /// @brief Discard cached partition polygons, e.g. when nodes have been renumbered
+    void resetPolygons();
+
     const Grid& grid() const { return *grid_; }
 
     void attachObserver( MeshObserver& ) const;
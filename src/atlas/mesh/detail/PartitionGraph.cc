@@ -8,7 +8,10 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <iomanip>
+#include <limits>
+#include <sstream>
 
 #include "eckit/exception/Exceptions.h"
 #include "eckit/log/Bytes.h"
@@ -21,6 +24,7 @@
 #include "atlas/mesh/detail/MeshImpl.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/runtime/Log.h"
+#include "atlas/runtime/Trace.h"
 #include "atlas/util/Unique.h"
 
 namespace atlas {
@@ -29,75 +33,118 @@ namespace detail {
 
 //----------------------------------------------------------------------------------------------------------------------
 
+namespace {
+bool overlap( const double a[], const double b[], double tol ) {
+    return a[0] <= b[1] + tol && b[0] <= a[1] + tol && a[2] <= b[3] + tol && b[2] <= a[3] + tol;
+}
+}  // namespace
+
+/*
+ * Partitions are neighbours when their polygons share a vertex. Only the bounding boxes of the
+ * polygons, in (lon,lat) normalised to [0,360), are gathered on all tasks. The unique ids of the
+ * polygon vertices are then exchanged only with tasks whose bounding box overlaps, and compared locally.
+ * As overlap of bounding boxes is symmetric, so is the resulting graph, without further communication.
+ * Only the neighbours of this task's partition are stored.
+ */
 PartitionGraph* build_partition_graph( const MeshImpl& mesh ) {
+    ATLAS_TRACE();
     const eckit::mpi::Comm& comm = mpi::comm();
-    const int mpi_size           = int( comm.size() );
+    const size_t mpi_size        = comm.size();
+    const size_t mpi_rank        = comm.rank();
 
     const util::Polygon& poly = mesh.polygon();
 
-    std::vector<double> polygon;
-    polygon.reserve( poly.size() * 2 );
-
     auto xy = array::make_view<double, 2>( mesh.nodes().xy() );
 
+    std::vector<double> lonlat;
+    lonlat.reserve( 2 * poly.size() );
+    double bbox[4] = {std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(),
+                      std::numeric_limits<double>::max(), -std::numeric_limits<double>::max()};
     for ( idx_t node : poly ) {
-        polygon.push_back( xy( node, XX ) );
-        polygon.push_back( xy( node, YY ) );
+        PointLonLat pll = PointXY( xy( node, XX ), xy( node, YY ) );
+        if ( eckit::types::is_strictly_greater( 0., pll.lon() ) ) { pll.lon() += 360.; }
+        if ( eckit::types::is_approximately_greater_or_equal( pll.lon(), 360. ) ) { pll.lon() -= 360.; }
+        lonlat.push_back( pll.lon() );
+        lonlat.push_back( pll.lat() );
+        bbox[0] = std::min( bbox[0], pll.lon() );
+        bbox[1] = std::max( bbox[1], pll.lon() );
+        bbox[2] = std::min( bbox[2], pll.lat() );
+        bbox[3] = std::max( bbox[3], pll.lat() );
     }
-    ASSERT( polygon.size() >= 4 );
+    std::vector<uidx_t> uids( poly.size() );
+    util::unique_lonlat_points( lonlat.data(), uids.size(), uids.data() );
+    ASSERT( uids.size() >= 2 );
+    std::sort( uids.begin(), uids.end() );
 
-    eckit::mpi::Buffer<double> recv_polygons( mpi_size );
-    comm.allGatherv( polygon.begin(), polygon.end(), recv_polygons );
+    eckit::mpi::Buffer<double> recv_bbox( mpi_size );
+    ATLAS_TRACE_MPI( ALLGATHER ) { comm.allGatherv( bbox, bbox + 4, recv_bbox ); }
 
-    using PolygonXY = std::vector<PointXY>;
-    std::vector<PolygonXY> polygons( mpi_size );
+    // Vertices are compared with micro-degree precision
+    const double tol = 1.e-3;
+    std::vector<size_t> candidates;
     for ( size_t p = 0; p < mpi_size; ++p ) {
-        for ( size_t j = 0; j < recv_polygons.counts[p] / 2; ++j ) {
-            PointXY pxy( *( recv_polygons.begin() + recv_polygons.displs[p] + 2 * j + XX ),
-                         *( recv_polygons.begin() + recv_polygons.displs[p] + 2 * j + YY ) );
-            polygons[p].push_back( pxy );
+        if ( p != mpi_rank && overlap( bbox, recv_bbox.buffer.data() + recv_bbox.displs[p], tol ) ) {
+            candidates.push_back( p );
         }
     }
 
-    std::map<uidx_t, std::set<size_t>> uid_2_parts;
-    size_t jpart = 0;
-    for ( const PolygonXY& _polygon : polygons ) {
-        for ( const PointXY& pxy : _polygon ) {
-            PointLonLat pll = pxy;
-            if ( eckit::types::is_strictly_greater( 0., pll.lon() ) ) { pll.lon() += 360.; }
-            if ( eckit::types::is_approximately_greater_or_equal( pll.lon(), 360. ) ) { pll.lon() -= 360.; }
-            uidx_t uid = util::unique_lonlat( pll.data() );
-            uid_2_parts[uid].insert( jpart );
+    const int tag = 0;
+    std::vector<eckit::mpi::Request> send_requests( candidates.size() );
+    std::vector<eckit::mpi::Request> recv_requests( candidates.size() );
+    std::vector<size_t> recv_size( candidates.size() );
+    const size_t send_size = uids.size();
+    ATLAS_TRACE_MPI( ISEND ) {
+        for ( size_t j = 0; j < candidates.size(); ++j ) {
+            send_requests[j] = comm.iSend( send_size, candidates[j], tag );
         }
-        ++jpart;
     }
-    std::vector<std::set<size_t>> graph( mpi_size );
-    for ( const auto& u2p : uid_2_parts ) {
-        const std::set<size_t>& parts = u2p.second;
-        for ( size_t jpart : parts ) {
-            for ( size_t ipart : parts ) {
-                if ( jpart != ipart ) { graph[jpart].insert( ipart ); }
-            }
+    ATLAS_TRACE_MPI( IRECEIVE ) {
+        for ( size_t j = 0; j < candidates.size(); ++j ) {
+            recv_requests[j] = comm.iReceive( recv_size[j], candidates[j], tag );
+        }
+    }
+    ATLAS_TRACE_MPI( WAIT ) {
+        for ( size_t j = 0; j < candidates.size(); ++j ) {
+            comm.wait( recv_requests[j] );
+            comm.wait( send_requests[j] );
+        }
+    }
+
+    std::vector<std::vector<uidx_t>> recv_uids( candidates.size() );
+    ATLAS_TRACE_MPI( ISEND ) {
+        for ( size_t j = 0; j < candidates.size(); ++j ) {
+            send_requests[j] = comm.iSend( uids.data(), uids.size(), candidates[j], tag );
+        }
+    }
+    ATLAS_TRACE_MPI( IRECEIVE ) {
+        for ( size_t j = 0; j < candidates.size(); ++j ) {
+            recv_uids[j].resize( recv_size[j] );
+            recv_requests[j] = comm.iReceive( recv_uids[j].data(), recv_uids[j].size(), candidates[j], tag );
         }
     }
 
-    std::vector<size_t> counts( mpi_size );
-    std::vector<size_t> displs( mpi_size );
-    size_t values_size = 0;
-    for ( size_t jpart = 0; jpart < mpi_size; ++jpart ) {
-        counts[jpart] = graph[jpart].size();
-        displs[jpart] = values_size;
-        values_size += counts[jpart];
+    PartitionGraph::Neighbours neighbours;
+    for ( size_t j = 0; j < candidates.size(); ++j ) {
+        ATLAS_TRACE_MPI( WAIT ) { comm.wait( recv_requests[j] ); }
+        for ( uidx_t uid : recv_uids[j] ) {
+            if ( std::binary_search( uids.begin(), uids.end(), uid ) ) {
+                neighbours.push_back( candidates[j] );
+                break;
+            }
+        }
     }
-    std::vector<size_t> values;
-    values.reserve( values_size );
-    for ( const std::set<size_t>& graph_node : graph ) {
-        for ( size_t v : graph_node ) {
-            values.push_back( v );
+    ATLAS_TRACE_MPI( WAIT ) {
+        for ( size_t j = 0; j < candidates.size(); ++j ) {
+            comm.wait( send_requests[j] );
         }
     }
 
-    return new PartitionGraph( values.data(), mpi_size, displs.data(), counts.data() );
+    size_t maximum_nearest_neighbours;
+    ATLAS_TRACE_MPI( ALLREDUCE ) {
+        comm.allReduce( neighbours.size(), maximum_nearest_neighbours, eckit::mpi::max() );
+    }
+
+    return new PartitionGraph( mpi_rank, mpi_size, neighbours, maximum_nearest_neighbours );
 }
 
 size_t PartitionGraph::footprint() const {
@@ -109,16 +156,45 @@ size_t PartitionGraph::footprint() const {
 }
 
 size_t PartitionGraph::size() const {
-    return displs_.size();
+    return size_;
+}
+
+bool PartitionGraph::distributed() const {
+    return distributed_;
 }
 
 PartitionGraph::Neighbours PartitionGraph::nearestNeighbours( const size_t partition ) const {
-    return Neighbours( values_.data() + displs_[partition], values_.data() + displs_[partition] + counts_[partition] );
+    size_t row = partition;
+    if ( distributed_ ) {
+        if ( partition != partition_ ) {
+            std::stringstream msg;
+            msg << "Distributed partition graph only contains neighbours of partition " << partition_
+                << ", not of partition " << partition;
+            throw eckit::BadParameter( msg.str(), Here() );
+        }
+        row = 0;
+    }
+    return Neighbours( values_.data() + displs_[row], values_.data() + displs_[row] + counts_[row] );
 }
 
-PartitionGraph::PartitionGraph() {}
+PartitionGraph::PartitionGraph() : size_( 0 ), partition_( 0 ), distributed_( false ), maximum_nearest_neighbours_( 0 ) {}
+
+PartitionGraph::PartitionGraph( size_t partition, size_t nb_partitions, const Neighbours& neighbours,
+                                size_t maximum_nearest_neighbours ) :
+    counts_( 1, neighbours.size() ),
+    displs_( 1, 0 ),
+    values_( neighbours ),
+    size_( nb_partitions ),
+    partition_( partition ),
+    distributed_( true ),
+    maximum_nearest_neighbours_( maximum_nearest_neighbours ) {
+    std::sort( values_.begin(), values_.end() );
+}
 
-PartitionGraph::PartitionGraph( size_t values[], size_t rows, size_t displs[], size_t counts[] ) {
+PartitionGraph::PartitionGraph( size_t values[], size_t rows, size_t displs[], size_t counts[] ) :
+    size_( rows ),
+    partition_( 0 ),
+    distributed_( false ) {
     displs_.assign( displs, displs + rows );
     counts_.assign( counts, counts + rows );
     values_.assign( values, values + displs[rows - 1] + counts[rows - 1] );
@@ -151,6 +227,7 @@ size_t PartitionGraph::maximumNearestNeighbours() const {
 
 void PartitionGraph::print( std::ostream& os ) const {
     for ( size_t jpart = 0; jpart < size(); ++jpart ) {
+        if ( distributed_ && jpart != partition_ ) continue;
         Log::info() << std::setw( 3 ) << jpart << " : ";
         for ( size_t v : nearestNeighbours( jpart ) ) {
             Log::info() << std::setw( 3 ) << v << " ";
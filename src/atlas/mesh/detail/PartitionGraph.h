@@ -11,6 +11,7 @@
 #pragma once
 
 #include <iosfwd>
+#include <vector>
 
 #include "eckit/memory/Owned.h"
 #include "eckit/memory/SharedPtr.h"
@@ -32,8 +33,16 @@ public:
 public:
     PartitionGraph();
     PartitionGraph( size_t values[], size_t rows, size_t displs[], size_t counts[] );
+
+    /// @brief Distributed graph, containing only the neighbours of given partition out of nb_partitions
+    PartitionGraph( size_t partition, size_t nb_partitions, const Neighbours& neighbours,
+                    size_t maximum_nearest_neighbours );
+
     size_t footprint() const;
     size_t size() const;
+    bool distributed() const;
+
+    /// @note For a distributed graph, only neighbours of its own partition are available
     Neighbours nearestNeighbours( const size_t partition ) const;
     size_t maximumNearestNeighbours() const;
     operator bool() const;
@@ -46,6 +55,9 @@ private:
     std::vector<size_t> counts_;
     std::vector<size_t> displs_;
     std::vector<size_t> values_;
+    size_t size_;
+    size_t partition_;
+    bool distributed_;
     size_t maximum_nearest_neighbours_;
 };
 
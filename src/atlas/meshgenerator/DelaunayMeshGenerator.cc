@@ -8,6 +8,8 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <vector>
+
 #include "eckit/utils/Hash.h"
 
 #include "atlas/array/ArrayView.h"
@@ -80,16 +82,15 @@ void DelaunayMeshGenerator::createNodes( const Grid& grid, Mesh& mesh ) const {
 
     array::ArrayView<double, 2> xy     = array::make_view<double, 2>( mesh.nodes().xy() );
     array::ArrayView<double, 2> lonlat = array::make_view<double, 2>( mesh.nodes().lonlat() );
-    size_t jnode( 0 );
-    Projection projection = grid.projection();
-    PointLonLat Pll;
-    for ( PointXY Pxy : grid.xy() ) {
-        xy( jnode, XX )      = Pxy.x();
-        xy( jnode, YY )      = Pxy.y();
-        Pll                  = projection.lonlat( Pxy );
-        lonlat( jnode, LON ) = Pll.lon();
-        lonlat( jnode, LAT ) = Pll.lat();
-        ++jnode;
+    std::vector<double> grid_xy( 2 * nb_nodes );
+    std::vector<double> grid_lonlat( 2 * nb_nodes );
+    grid.fill_xy( grid_xy.data() );
+    grid.fill_lonlat( grid_lonlat.data() );
+    for ( size_t jnode = 0; jnode < nb_nodes; ++jnode ) {
+        xy( jnode, XX )      = grid_xy[2 * jnode + XX];
+        xy( jnode, YY )      = grid_xy[2 * jnode + YY];
+        lonlat( jnode, LON ) = grid_lonlat[2 * jnode + LON];
+        lonlat( jnode, LAT ) = grid_lonlat[2 * jnode + LAT];
     }
 }
 
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <exception>
 #include <limits>
 #include <numeric>
 #include <vector>
@@ -33,6 +34,7 @@
 #include "atlas/mesh/Nodes.h"
 #include "atlas/meshgenerator/StructuredMeshGenerator.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/runtime/Trace.h"
 #include "atlas/util/CoordinateEnums.h"
@@ -63,6 +65,7 @@ struct Region {
     std::vector<int> lat_begin;
     std::vector<int> lat_end;
     std::vector<int> nb_lat_elems;
+    std::vector<int> nb_lat_quads;
 };
 
 StructuredMeshGenerator::StructuredMeshGenerator( const eckit::Parametrisation& p ) {
@@ -232,43 +235,50 @@ void StructuredMeshGenerator::generate_region( const grid::StructuredGrid& rg, c
     bool unique_pole = options.get<bool>( "unique_pole" ) && three_dimensional && has_north_pole && has_south_pole;
     bool periodic_east_west = rg.periodic();
 
-    int n;
+    const int ny = rg.ny();
+    ASSERT( parts.size() == size_t( rg.size() ) );
+
+    std::vector<int> offset( ny, 0 );
+
+    int n = 0;
+    for ( int jlat = 0; jlat < ny; ++jlat ) {
+        offset[jlat] = n;
+        n += rg.nx( jlat );
+    }
+
     /*
-Find min and max latitudes used by this part.
+Find first and last longitude of this part on each latitude.
+The replicated distribution is only scanned once, and in parallel over latitudes.
 */
-    n             = 0;
-    int lat_north = -1;
-    for ( size_t jlat = 0; jlat < rg.ny(); ++jlat ) {
-        for ( size_t jlon = 0; jlon < rg.nx( jlat ); ++jlon ) {
-            if ( parts.at( n ) == mypart ) {
-                lat_north = jlat;
-                goto end_north;
+    std::vector<int> part_begin( ny, -1 );
+    std::vector<int> part_end( ny, -1 );
+    ATLAS_TRACE_SCOPE( "find latitudes of part" ) {
+        atlas_omp_parallel_for( int jlat = 0; jlat < ny; ++jlat ) {
+            const int* p = parts.data() + offset[jlat];
+            const int nx = rg.nx( jlat );
+            for ( int jlon = 0; jlon < nx; ++jlon ) {
+                if ( p[jlon] == mypart ) {
+                    if ( part_begin[jlat] == -1 ) part_begin[jlat] = jlon;
+                    part_end[jlat] = jlon;
+                }
             }
-            ++n;
         }
     }
-end_north:
 
-    n             = rg.size() - 1;
+    int lat_north = -1;
     int lat_south = -1;
-    for ( int jlat = rg.ny() - 1; jlat >= 0; --jlat ) {
-        for ( int jlon = rg.nx( jlat ) - 1; jlon >= 0; --jlon ) {
-            if ( parts.at( n ) == mypart ) {
-                lat_south = jlat;
-                goto end_south;
-            }
-            --n;
+    for ( int jlat = 0; jlat < ny; ++jlat ) {
+        if ( part_end[jlat] >= 0 ) {
+            if ( lat_north == -1 ) lat_north = jlat;
+            lat_south = jlat;
         }
     }
-end_south:
-
-    std::vector<int> offset( rg.ny(), 0 );
-
-    n = 0;
-    for ( size_t jlat = 0; jlat < rg.ny(); ++jlat ) {
-        offset.at( jlat ) = n;
-        n += rg.nx( jlat );
-    };
+    if ( lat_north == -1 ) {
+        throw Exception(
+            "Trying to generate mesh with too many partitions. Reduce "
+            "the number of partitions.",
+            Here() );
+    }
 
     /*
 We need to connect to next region
@@ -278,6 +288,7 @@ We need to connect to next region
     region.lat_begin.resize( rg.ny(), -1 );
     region.lat_end.resize( rg.ny(), -1 );
     region.nb_lat_elems.resize( rg.ny(), 0 );
+    region.nb_lat_quads.resize( rg.ny(), 0 );
     region.north = lat_north;
     region.south = lat_south;
 
@@ -285,17 +296,33 @@ We need to connect to next region
 
     region.elems.reset( array::Array::create<int>( shape ) );
 
-    int nelems     = 0;
     region.nquads  = 0;
     region.ntriags = 0;
 
     array::ArrayView<int, 3> elemview = array::make_view<int, 3>( *region.elems );
     elemview.assign( -1 );
 
+    // Extent of the elements of one latitude row on its northern and southern latitude (-1 when unset)
+    struct LatitudeRow {
+        int beginN{-1};
+        int endN{-1};
+        int beginS{-1};
+        int endS{-1};
+        int nquads{0};
+        int ntriags{0};
+    };
+    auto extend = []( int& begin, int& end, int jbegin, int jend ) {
+        begin = ( begin == -1 ) ? jbegin : std::min( begin, jbegin );
+        end   = std::max( end, jend );
+    };
+
     bool stagger = options.get<bool>( "stagger" );
-    for ( int jlat = lat_north; jlat < lat_south; ++jlat ) {
-        //    std::stringstream filename; filename << "/tmp/debug/"<<jlat;
 
+    /*
+Create the elements between latitudes jlat and jlat+1 that belong to this part.
+Only the row's own slice of region.elems is written, so rows can be created concurrently.
+*/
+    auto create_row = [&]( int jlat, LatitudeRow& row ) {
         size_t ilat, latN, latS;
         size_t ipN1, ipN2, ipS1, ipS2;
         double xN1, xN2, yN, xS1, xS2, yS;
@@ -303,7 +330,7 @@ We need to connect to next region
         bool try_make_triangle_up, try_make_triangle_down, try_make_quad;
         bool add_triag, add_quad;
 
-        ilat = jlat - region.north;
+        ilat = jlat - lat_north;
 
         auto lat_elems_view = elemview.slice( ilat, Range::all(), Range::all() );
 
@@ -328,7 +355,7 @@ We need to connect to next region
         ipS2 = std::min( ipS1 + 1, endS );
 
         int jelem = 0;
-        int pE    = parts.at( offset.at( latN ) );
+        int pE    = parts[offset[latN]];
 
 #if DEBUG_OUTPUT
         Log::info() << "=================\n";
@@ -508,16 +535,11 @@ We need to connect to next region
                 }
                 add_quad = ( pE == mypart );
                 if ( add_quad ) {
-                    ++region.nquads;
+                    ++row.nquads;
                     ++jelem;
-                    ++nelems;
-
-                    if ( region.lat_begin.at( latN ) == -1 ) region.lat_begin.at( latN ) = ipN1;
-                    if ( region.lat_begin.at( latS ) == -1 ) region.lat_begin.at( latS ) = ipS1;
-                    region.lat_begin.at( latN ) = std::min<int>( region.lat_begin.at( latN ), ipN1 );
-                    region.lat_begin.at( latS ) = std::min<int>( region.lat_begin.at( latS ), ipS1 );
-                    region.lat_end.at( latN )   = std::max<int>( region.lat_end.at( latN ), ipN2 );
-                    region.lat_end.at( latS )   = std::max<int>( region.lat_end.at( latS ), ipS2 );
+
+                    extend( row.beginN, row.endN, ipN1, ipN2 );
+                    extend( row.beginS, row.endS, ipS1, ipS2 );
                 }
                 else {
 #if DEBUG_OUTPUT
@@ -544,16 +566,11 @@ We need to connect to next region
                 add_triag = ( mypart == pE );
 
                 if ( add_triag ) {
-                    ++region.ntriags;
+                    ++row.ntriags;
                     ++jelem;
-                    ++nelems;
-
-                    if ( region.lat_begin.at( latN ) == -1 ) region.lat_begin.at( latN ) = ipN1;
-                    if ( region.lat_begin.at( latS ) == -1 ) region.lat_begin.at( latS ) = ipS1;
-                    region.lat_begin.at( latN ) = std::min<int>( region.lat_begin.at( latN ), ipN1 );
-                    region.lat_begin.at( latS ) = std::min<int>( region.lat_begin.at( latS ), ipS1 );
-                    region.lat_end.at( latN )   = std::max<int>( region.lat_end.at( latN ), ipN2 );
-                    region.lat_end.at( latS )   = std::max<int>( region.lat_end.at( latS ), ipS1 );
+
+                    extend( row.beginN, row.endN, ipN1, ipN2 );
+                    extend( row.beginS, row.endS, ipS1, ipS1 );
                 }
                 else {
 #if DEBUG_OUTPUT
@@ -588,16 +605,11 @@ We need to connect to next region
                 add_triag = ( mypart == pE );
 
                 if ( add_triag ) {
-                    ++region.ntriags;
+                    ++row.ntriags;
                     ++jelem;
-                    ++nelems;
-
-                    if ( region.lat_begin.at( latN ) == -1 ) region.lat_begin.at( latN ) = ipN1;
-                    if ( region.lat_begin.at( latS ) == -1 ) region.lat_begin.at( latS ) = ipS1;
-                    region.lat_begin.at( latN ) = std::min<int>( region.lat_begin.at( latN ), ipN1 );
-                    region.lat_begin.at( latS ) = std::min<int>( region.lat_begin.at( latS ), ipS1 );
-                    region.lat_end.at( latN )   = std::max<int>( region.lat_end.at( latN ), ipN1 );
-                    region.lat_end.at( latS )   = std::max<int>( region.lat_end.at( latS ), ipS2 );
+
+                    extend( row.beginN, row.endN, ipN1, ipN1 );
+                    extend( row.beginS, row.endS, ipS1, ipS2 );
                 }
                 else {
 #if DEBUG_OUTPUT
@@ -613,16 +625,44 @@ We need to connect to next region
             ipN2 = std::min( endN, ipN1 + 1 );
             ipS2 = std::min( endS, ipS1 + 1 );
         }
-        region.nb_lat_elems.at( jlat ) = jelem;
+    };
+
+    std::vector<LatitudeRow> rows( lat_south - lat_north );
+    ATLAS_TRACE_SCOPE( "create elements" ) {
+        std::exception_ptr error;
+        atlas_omp_parallel_for( int jlat = lat_north; jlat < lat_south; ++jlat ) {
+            try {
+                create_row( jlat, rows[jlat - lat_north] );
+            }
+            catch ( ... ) {
+                atlas_omp_critical { error = std::current_exception(); }
+            }
+        }
+        if ( error ) { std::rethrow_exception( error ); }
+    }
+
+    /*
+Combine the rows in order of latitude, so that the result does not depend on the number of threads
+*/
+    for ( int jlat = lat_north; jlat < lat_south; ++jlat ) {
+        const LatitudeRow& row = rows[jlat - lat_north];
+
+        int latN  = jlat;
+        int latS  = jlat + 1;
+        double yN = rg.y( latN );
+        double yS = rg.y( latS );
+
+        if ( row.beginN != -1 ) extend( region.lat_begin[latN], region.lat_end[latN], row.beginN, row.endN );
+        if ( row.beginS != -1 ) extend( region.lat_begin[latS], region.lat_end[latS], row.beginS, row.endS );
+        region.nquads += row.nquads;
+        region.ntriags += row.ntriags;
+        region.nb_lat_quads[jlat] = row.nquads;
+        region.nb_lat_elems[jlat] = row.nquads + row.ntriags;
 #if DEBUG_OUTPUT
         ATLAS_DEBUG_VAR( region.nb_lat_elems.at( jlat ) );
 #endif
-        if ( region.nb_lat_elems.at( jlat ) == 0 && latN == size_t( region.north ) ) { ++region.north; }
-        if ( region.nb_lat_elems.at( jlat ) == 0 && latS == size_t( region.south ) ) { --region.south; }
-        //    region.lat_end.at(latN) = std::min(region.lat_end.at(latN),
-        //    int(rg.nx(latN)-1));
-        //    region.lat_end.at(latS) = std::min(region.lat_end.at(latS),
-        //    int(rg.nx(latS)-1));
+        if ( region.nb_lat_elems.at( jlat ) == 0 && latN == region.north ) { ++region.north; }
+        if ( region.nb_lat_elems.at( jlat ) == 0 && latS == region.south ) { --region.south; }
         if ( yN == 90 && unique_pole ) region.lat_end.at( latN ) = rg.nx( latN ) - 1;
         if ( yS == -90 && unique_pole ) region.lat_end.at( latS ) = rg.nx( latS ) - 1;
 
@@ -630,28 +670,29 @@ We need to connect to next region
             region.lat_end.at( latN ) = std::max( region.lat_end.at( latN ), region.lat_begin.at( latN ) );
             region.lat_end.at( latS ) = std::max( region.lat_end.at( latS ), region.lat_begin.at( latS ) );
         }
-    }  // for jlat
+    }
 
-    //  Log::info()  << "nb_triags = " << region.ntriags << std::endl;
-    //  Log::info()  << "nb_quads = " << region.nquads << std::endl;
-    //  Log::info()  << "nb_elems = " << nelems << std::endl;
+    // Rows of region.elems are numbered from region.north, which moved south past empty rows
+    if ( region.north > lat_north ) {
+        for ( int jlat = region.north; jlat < region.south; ++jlat ) {
+            int ilat_from = jlat - lat_north;
+            int ilat_to   = jlat - region.north;
+            for ( int jelem = 0; jelem < region.nb_lat_elems[jlat]; ++jelem ) {
+                for ( int j = 0; j < 4; ++j ) {
+                    elemview( ilat_to, jelem, j ) = elemview( ilat_from, jelem, j );
+                }
+            }
+        }
+    }
 
     int nb_region_nodes = 0;
     for ( int jlat = region.north; jlat <= region.south; ++jlat ) {
-        n                           = offset.at( jlat );
         region.lat_begin.at( jlat ) = std::max( 0, region.lat_begin.at( jlat ) );
-        for ( size_t jlon = 0; jlon < rg.nx( jlat ); ++jlon ) {
-            if ( parts.at( n ) == mypart ) {
-                region.lat_begin.at( jlat ) = std::min( region.lat_begin.at( jlat ), int( jlon ) );
-                region.lat_end.at( jlat )   = std::max( region.lat_end.at( jlat ), int( jlon ) );
-            }
-            ++n;
+        if ( part_end[jlat] >= 0 ) {
+            region.lat_begin.at( jlat ) = std::min( region.lat_begin.at( jlat ), part_begin[jlat] );
+            region.lat_end.at( jlat )   = std::max( region.lat_end.at( jlat ), part_end[jlat] );
         }
         nb_region_nodes += region.lat_end.at( jlat ) - region.lat_begin.at( jlat ) + 1;
-
-        // Count extra periodic node
-        // if( periodic_east_west && size_t(region.lat_end.at(jlat)) == rg.nx(jlat)
-        // - 1) ++nb_region_nodes;
     }
 
     region.nnodes = nb_region_nodes;
@@ -788,19 +829,29 @@ void StructuredMeshGenerator::generate_mesh( const grid::StructuredGrid& rg, con
 
     bool stagger = options.get<bool>( "stagger" );
 
+    /*
+Offset of each latitude in the local nodes before renumbering.
+Periodic points beyond the last longitude are only stored with include_periodic_ghost_points.
+*/
+    ASSERT( region.south >= region.north );
+    l = 0;
+    for ( int jlat = region.north; jlat <= region.south; ++jlat ) {
+        int ilat              = jlat - region.north;
+        int nx                = rg.nx( jlat );
+        offset_loc.at( ilat ) = l;
+        l += region.lat_end.at( jlat ) - region.lat_begin.at( jlat ) + 1;
+        if ( !include_periodic_ghost_points && region.lat_end.at( jlat ) >= nx ) {
+            l -= region.lat_end.at( jlat ) - std::max( region.lat_begin.at( jlat ), nx ) + 1;
+        }
+    }
+
     std::vector<int> node_numbering( node_numbering_size, -1 );
     if ( options.get<bool>( "ghost_at_end" ) ) {
         std::vector<GhostNode> ghost_nodes;
         ghost_nodes.reserve( nnodes );
         int node_number = 0;
         int jnode       = 0;
-        l               = 0;
-        ASSERT( region.south >= region.north );
         for ( int jlat = region.north; jlat <= region.south; ++jlat ) {
-            int ilat              = jlat - region.north;
-            offset_loc.at( ilat ) = l;
-            l += region.lat_end.at( jlat ) - region.lat_begin.at( jlat ) + 1;
-
             if ( region.lat_end.at( jlat ) < region.lat_begin.at( jlat ) ) {
                 ATLAS_DEBUG_VAR( jlat );
                 ATLAS_DEBUG_VAR( region.lat_begin[jlat] );
@@ -827,11 +878,9 @@ void StructuredMeshGenerator::generate_mesh( const grid::StructuredGrid& rg, con
                     ghost_nodes.push_back( GhostNode( jlat, rg.nx( jlat ), jnode ) );
                     ++jnode;
                 }
-                else {
-                    --l;
-                }
             }
         }
+        ASSERT( jnode == l );
         for ( size_t jghost = 0; jghost < ghost_nodes.size(); ++jghost ) {
             node_numbering.at( ghost_nodes.at( jghost ).jnode ) = node_number;
             ++node_number;
@@ -852,83 +901,80 @@ void StructuredMeshGenerator::generate_mesh( const grid::StructuredGrid& rg, con
             node_numbering.at( jnode ) = jnode;
     }
 
-    int jnode = 0;
-    l         = 0;
-    for ( int jlat = region.north; jlat <= region.south; ++jlat ) {
-        int ilat              = jlat - region.north;
-        offset_loc.at( ilat ) = l;
-        l += region.lat_end.at( jlat ) - region.lat_begin.at( jlat ) + 1;
+    ATLAS_TRACE_SCOPE( "fill nodes" ) {
+        atlas_omp_parallel_for( int jlat = region.north; jlat <= region.south; ++jlat ) {
+            int jnode = offset_loc[jlat - region.north];
 
-        double y = rg.y( jlat );
-        for ( int jlon = region.lat_begin.at( jlat ); jlon <= region.lat_end.at( jlat ); ++jlon ) {
-            if ( jlon < rg.nx( jlat ) ) {
-                int inode = node_numbering.at( jnode );
-                n         = offset_glb.at( jlat ) + jlon;
-
-                double x = rg.x( jlon, jlat );
-                // std::cout << "jlat = " << jlat << "; jlon = " << jlon << "; x = " <<
-                // x << std::endl;
-                if ( stagger && ( jlat + 1 ) % 2 == 0 ) x += 180. / static_cast<double>( rg.nx( jlat ) );
-
-                xy( inode, XX ) = x;
-                xy( inode, YY ) = y;
-
-                // geographic coordinates by using projection
-                double crd[] = {x, y};
-                rg.projection().xy2lonlat( crd );
-                lonlat( inode, LON ) = crd[LON];
-                lonlat( inode, LAT ) = crd[LAT];
-
-                glb_idx( inode ) = n + 1;
-                part( inode )    = parts.at( n );
-                ghost( inode )   = 0;
-                Topology::reset( flags( inode ) );
-                if ( jlat == 0 && !include_north_pole ) {
-                    Topology::set( flags( inode ), Topology::BC | Topology::NORTH );
-                }
-                if ( size_t( jlat ) == rg.ny() - 1 && !include_south_pole ) {
-                    Topology::set( flags( inode ), Topology::BC | Topology::SOUTH );
-                }
-                if ( jlon == 0 && include_periodic_ghost_points ) {
-                    Topology::set( flags( inode ), Topology::BC | Topology::WEST );
+            double y = rg.y( jlat );
+            for ( int jlon = region.lat_begin[jlat]; jlon <= region.lat_end[jlat]; ++jlon ) {
+                if ( jlon < rg.nx( jlat ) ) {
+                    int inode = node_numbering[jnode];
+                    int n     = offset_glb[jlat] + jlon;
+
+                    double x = rg.x( jlon, jlat );
+                    // std::cout << "jlat = " << jlat << "; jlon = " << jlon << "; x = " <<
+                    // x << std::endl;
+                    if ( stagger && ( jlat + 1 ) % 2 == 0 ) x += 180. / static_cast<double>( rg.nx( jlat ) );
+
+                    xy( inode, XX ) = x;
+                    xy( inode, YY ) = y;
+
+                    // geographic coordinates by using projection
+                    double crd[] = {x, y};
+                    rg.projection().xy2lonlat( crd );
+                    lonlat( inode, LON ) = crd[LON];
+                    lonlat( inode, LAT ) = crd[LAT];
+
+                    glb_idx( inode ) = n + 1;
+                    part( inode )    = parts[n];
+                    ghost( inode )   = 0;
+                    Topology::reset( flags( inode ) );
+                    if ( jlat == 0 && !include_north_pole ) {
+                        Topology::set( flags( inode ), Topology::BC | Topology::NORTH );
+                    }
+                    if ( size_t( jlat ) == rg.ny() - 1 && !include_south_pole ) {
+                        Topology::set( flags( inode ), Topology::BC | Topology::SOUTH );
+                    }
+                    if ( jlon == 0 && include_periodic_ghost_points ) {
+                        Topology::set( flags( inode ), Topology::BC | Topology::WEST );
+                    }
+                    if ( part( inode ) != mypart ) {
+                        Topology::set( flags( inode ), Topology::GHOST );
+                        ghost( inode ) = 1;
+                    }
+                    ++jnode;
                 }
-                if ( part( inode ) != mypart ) {
-                    Topology::set( flags( inode ), Topology::GHOST );
+                else if ( include_periodic_ghost_points )  // add periodic point
+                {
+                    int inode = node_numbering[jnode];
+                    // int inode_left = node_numbering.at(jnode-1);
+                    double x = rg.x( rg.nx( jlat ), jlat );
+                    if ( stagger && ( jlat + 1 ) % 2 == 0 ) x += 180. / static_cast<double>( rg.nx( jlat ) );
+
+                    xy( inode, XX ) = x;
+                    xy( inode, YY ) = y;
+
+                    // geographic coordinates by using projection
+                    double crd[] = {x, y};
+                    rg.projection().xy2lonlat( crd );
+                    lonlat( inode, LON ) = crd[LON];
+                    lonlat( inode, LAT ) = crd[LAT];
+
+                    glb_idx( inode ) = periodic_glb.at( jlat ) + 1;
+    //#warning TODO: use commented approach
+                    //        part(inode)      = parts.at( offset_glb.at(jlat) );
+                    part( inode )  = mypart;  // The actual part will be fixed later
                     ghost( inode ) = 1;
+                    Topology::reset( flags( inode ) );
+                    Topology::set( flags( inode ), Topology::BC | Topology::EAST );
+                    Topology::set( flags( inode ), Topology::GHOST );
+                    ++jnode;
                 }
-                ++jnode;
-            }
-            else if ( include_periodic_ghost_points )  // add periodic point
-            {
-                int inode = node_numbering.at( jnode );
-                // int inode_left = node_numbering.at(jnode-1);
-                double x = rg.x( rg.nx( jlat ), jlat );
-                if ( stagger && ( jlat + 1 ) % 2 == 0 ) x += 180. / static_cast<double>( rg.nx( jlat ) );
-
-                xy( inode, XX ) = x;
-                xy( inode, YY ) = y;
-
-                // geographic coordinates by using projection
-                double crd[] = {x, y};
-                rg.projection().xy2lonlat( crd );
-                lonlat( inode, LON ) = crd[LON];
-                lonlat( inode, LAT ) = crd[LAT];
-
-                glb_idx( inode ) = periodic_glb.at( jlat ) + 1;
-//#warning TODO: use commented approach
-                //        part(inode)      = parts.at( offset_glb.at(jlat) );
-                part( inode )  = mypart;  // The actual part will be fixed later
-                ghost( inode ) = 1;
-                Topology::reset( flags( inode ) );
-                Topology::set( flags( inode ), Topology::BC | Topology::EAST );
-                Topology::set( flags( inode ), Topology::GHOST );
-                ++jnode;
-            }
-            else {
-                --l;
             }
         }
-    };
+    }
+
+    int jnode = l;
 
     int jnorth = -1;
     if ( include_north_pole ) {
@@ -999,84 +1045,106 @@ void StructuredMeshGenerator::generate_mesh( const grid::StructuredGrid& rg, con
     /*
 Fill in connectivity tables with global node indices first
 */
-    int jcell;
     int jquad       = 0;
     int jtriag      = 0;
     int quad_begin  = mesh.cells().elements( 0 ).begin();
     int triag_begin = mesh.cells().elements( 1 ).begin();
-    int quad_nodes[4];
-    int triag_nodes[3];
 
+    // First quadrilateral and triangle of each latitude row
+    std::vector<int> quad_offset( region.south - region.north + 1 );
+    std::vector<int> triag_offset( region.south - region.north + 1 );
     for ( int jlat = region.north; jlat < region.south; ++jlat ) {
-        int ilat  = jlat - region.north;
-        int jlatN = jlat;
-        int jlatS = jlat + 1;
-        int ilatN = ilat;
-        int ilatS = ilat + 1;
-        for ( int jelem = 0; jelem < region.nb_lat_elems.at( jlat ); ++jelem ) {
-            const auto elem = array::make_view<int, 3>( *region.elems ).slice( ilat, jelem, Range::all() );
-
-            if ( elem( 2 ) >= 0 && elem( 3 ) >= 0 )  // This is a quad
-            {
-                quad_nodes[0] = node_numbering.at( offset_loc.at( ilatN ) + elem( 0 ) - region.lat_begin.at( jlatN ) );
-                quad_nodes[1] = node_numbering.at( offset_loc.at( ilatS ) + elem( 1 ) - region.lat_begin.at( jlatS ) );
-                quad_nodes[2] = node_numbering.at( offset_loc.at( ilatS ) + elem( 2 ) - region.lat_begin.at( jlatS ) );
-                quad_nodes[3] = node_numbering.at( offset_loc.at( ilatN ) + elem( 3 ) - region.lat_begin.at( jlatN ) );
-
-                if ( three_dimensional && periodic_east_west ) {
-                    if ( size_t( elem( 2 ) ) == rg.nx( jlatS ) )
-                        quad_nodes[2] = node_numbering.at( offset_loc.at( ilatS ) );
-                    if ( size_t( elem( 3 ) ) == rg.nx( jlatN ) )
-                        quad_nodes[3] = node_numbering.at( offset_loc.at( ilatN ) );
-                }
-
-                jcell = quad_begin + jquad++;
-                node_connectivity.set( jcell, quad_nodes );
-                cells_glb_idx( jcell ) = jcell + 1;
-                cells_part( jcell )    = mypart;
-                cells_patch( jcell )   = 0;
-            }
-            else  // This is a triag
-            {
-                if ( elem( 3 ) < 0 )  // This is a triangle pointing up
+        int ilat           = jlat - region.north;
+        quad_offset[ilat]  = jquad;
+        triag_offset[ilat] = jtriag;
+        jquad += region.nb_lat_quads[jlat];
+        jtriag += region.nb_lat_elems[jlat] - region.nb_lat_quads[jlat];
+    }
+    ASSERT( jquad == region.nquads );
+    ASSERT( jtriag == region.ntriags );
+
+    const array::ArrayView<int, 3> elems = array::make_view<int, 3>( *region.elems );
+
+    ATLAS_TRACE_SCOPE( "fill elements" ) {
+        atlas_omp_parallel_for( int jlat = region.north; jlat < region.south; ++jlat ) {
+            int ilat       = jlat - region.north;
+            int jlatN      = jlat;
+            int jlatS      = jlat + 1;
+            int ilatN      = ilat;
+            int ilatS      = ilat + 1;
+            int jquad_row  = quad_offset[ilat];
+            int jtriag_row = triag_offset[ilat];
+            int quad_nodes[4];
+            int triag_nodes[3];
+            int jcell;
+            for ( int jelem = 0; jelem < region.nb_lat_elems[jlat]; ++jelem ) {
+                const auto elem = elems.slice( ilat, jelem, Range::all() );
+
+                if ( elem( 2 ) >= 0 && elem( 3 ) >= 0 )  // This is a quad
                 {
-                    triag_nodes[0] =
-                        node_numbering.at( offset_loc.at( ilatN ) + elem( 0 ) - region.lat_begin.at( jlatN ) );
-                    triag_nodes[1] =
-                        node_numbering.at( offset_loc.at( ilatS ) + elem( 1 ) - region.lat_begin.at( jlatS ) );
-                    triag_nodes[2] =
-                        node_numbering.at( offset_loc.at( ilatS ) + elem( 2 ) - region.lat_begin.at( jlatS ) );
+                    quad_nodes[0] = node_numbering.at( offset_loc.at( ilatN ) + elem( 0 ) - region.lat_begin.at( jlatN ) );
+                    quad_nodes[1] = node_numbering.at( offset_loc.at( ilatS ) + elem( 1 ) - region.lat_begin.at( jlatS ) );
+                    quad_nodes[2] = node_numbering.at( offset_loc.at( ilatS ) + elem( 2 ) - region.lat_begin.at( jlatS ) );
+                    quad_nodes[3] = node_numbering.at( offset_loc.at( ilatN ) + elem( 3 ) - region.lat_begin.at( jlatN ) );
+
                     if ( three_dimensional && periodic_east_west ) {
-                        if ( size_t( elem( 0 ) ) == rg.nx( jlatN ) )
-                            triag_nodes[0] = node_numbering.at( offset_loc.at( ilatN ) );
                         if ( size_t( elem( 2 ) ) == rg.nx( jlatS ) )
-                            triag_nodes[2] = node_numbering.at( offset_loc.at( ilatS ) );
+                            quad_nodes[2] = node_numbering.at( offset_loc.at( ilatS ) );
+                        if ( size_t( elem( 3 ) ) == rg.nx( jlatN ) )
+                            quad_nodes[3] = node_numbering.at( offset_loc.at( ilatN ) );
                     }
+
+                    jcell = quad_begin + jquad_row++;
+                    node_connectivity.set( jcell, quad_nodes );
+                    cells_glb_idx( jcell ) = jcell + 1;
+                    cells_part( jcell )    = mypart;
+                    cells_patch( jcell )   = 0;
                 }
-                else  // This is a triangle pointing down
+                else  // This is a triag
                 {
-                    triag_nodes[0] =
-                        node_numbering.at( offset_loc.at( ilatN ) + elem( 0 ) - region.lat_begin.at( jlatN ) );
-                    triag_nodes[1] =
-                        node_numbering.at( offset_loc.at( ilatS ) + elem( 1 ) - region.lat_begin.at( jlatS ) );
-                    triag_nodes[2] =
-                        node_numbering.at( offset_loc.at( ilatN ) + elem( 3 ) - region.lat_begin.at( jlatN ) );
-                    if ( three_dimensional && periodic_east_west ) {
-                        if ( size_t( elem( 1 ) ) == rg.nx( jlatS ) )
-                            triag_nodes[1] = node_numbering.at( offset_loc.at( ilatS ) );
-                        if ( size_t( elem( 3 ) ) == rg.nx( jlatN ) )
-                            triag_nodes[2] = node_numbering.at( offset_loc.at( ilatN ) );
+                    if ( elem( 3 ) < 0 )  // This is a triangle pointing up
+                    {
+                        triag_nodes[0] =
+                            node_numbering.at( offset_loc.at( ilatN ) + elem( 0 ) - region.lat_begin.at( jlatN ) );
+                        triag_nodes[1] =
+                            node_numbering.at( offset_loc.at( ilatS ) + elem( 1 ) - region.lat_begin.at( jlatS ) );
+                        triag_nodes[2] =
+                            node_numbering.at( offset_loc.at( ilatS ) + elem( 2 ) - region.lat_begin.at( jlatS ) );
+                        if ( three_dimensional && periodic_east_west ) {
+                            if ( size_t( elem( 0 ) ) == rg.nx( jlatN ) )
+                                triag_nodes[0] = node_numbering.at( offset_loc.at( ilatN ) );
+                            if ( size_t( elem( 2 ) ) == rg.nx( jlatS ) )
+                                triag_nodes[2] = node_numbering.at( offset_loc.at( ilatS ) );
+                        }
                     }
+                    else  // This is a triangle pointing down
+                    {
+                        triag_nodes[0] =
+                            node_numbering.at( offset_loc.at( ilatN ) + elem( 0 ) - region.lat_begin.at( jlatN ) );
+                        triag_nodes[1] =
+                            node_numbering.at( offset_loc.at( ilatS ) + elem( 1 ) - region.lat_begin.at( jlatS ) );
+                        triag_nodes[2] =
+                            node_numbering.at( offset_loc.at( ilatN ) + elem( 3 ) - region.lat_begin.at( jlatN ) );
+                        if ( three_dimensional && periodic_east_west ) {
+                            if ( size_t( elem( 1 ) ) == rg.nx( jlatS ) )
+                                triag_nodes[1] = node_numbering.at( offset_loc.at( ilatS ) );
+                            if ( size_t( elem( 3 ) ) == rg.nx( jlatN ) )
+                                triag_nodes[2] = node_numbering.at( offset_loc.at( ilatN ) );
+                        }
+                    }
+                    jcell = triag_begin + jtriag_row++;
+                    node_connectivity.set( jcell, triag_nodes );
+                    cells_glb_idx( jcell ) = jcell + 1;
+                    cells_part( jcell )    = mypart;
+                    cells_patch( jcell )   = 0;
                 }
-                jcell = triag_begin + jtriag++;
-                node_connectivity.set( jcell, triag_nodes );
-                cells_glb_idx( jcell ) = jcell + 1;
-                cells_part( jcell )    = mypart;
-                cells_patch( jcell )   = 0;
             }
         }
     }
 
+    int jcell;
+    int triag_nodes[3];
+
     if ( include_north_pole ) {
         int ilat    = 0;
         int ip1     = 0;
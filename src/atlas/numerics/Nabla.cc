@@ -15,6 +15,7 @@
 #include "eckit/thread/AutoLock.h"
 #include "eckit/thread/Mutex.h"
 
+#include "atlas/field/FieldSet.h"
 #include "atlas/library/config.h"
 #include "atlas/numerics/Method.h"
 #include "atlas/numerics/Nabla.h"
@@ -43,6 +44,30 @@ NablaImpl::NablaImpl( const Method& method, const eckit::Parametrisation& p ) {}
 
 NablaImpl::~NablaImpl() {}
 
+void NablaImpl::gradient( const FieldSet& scalars, FieldSet& grads ) const {
+    ASSERT( scalars.size() == grads.size() );
+    for ( size_t f = 0; f < scalars.size(); ++f ) {
+        Field grad = grads[f];
+        gradient( scalars[f], grad );
+    }
+}
+
+void NablaImpl::divergence( const FieldSet& vectors, FieldSet& divs ) const {
+    ASSERT( vectors.size() == divs.size() );
+    for ( size_t f = 0; f < vectors.size(); ++f ) {
+        Field div = divs[f];
+        divergence( vectors[f], div );
+    }
+}
+
+void NablaImpl::curl( const FieldSet& vectors, FieldSet& curls ) const {
+    ASSERT( vectors.size() == curls.size() );
+    for ( size_t f = 0; f < vectors.size(); ++f ) {
+        Field curl = curls[f];
+        this->curl( vectors[f], curl );
+    }
+}
+
 Nabla::Nabla() : nabla_( nullptr ) {}
 
 Nabla::Nabla( const Nabla::nabla_t* nabla ) : nabla_( nabla ) {}
@@ -69,6 +94,18 @@ void Nabla::laplacian( const Field& scalar, Field& laplacian ) const {
     nabla_->laplacian( scalar, laplacian );
 }
 
+void Nabla::gradient( const FieldSet& scalars, FieldSet& grads ) const {
+    nabla_->gradient( scalars, grads );
+}
+
+void Nabla::divergence( const FieldSet& vectors, FieldSet& divs ) const {
+    nabla_->divergence( vectors, divs );
+}
+
+void Nabla::curl( const FieldSet& vectors, FieldSet& curls ) const {
+    nabla_->curl( vectors, curls );
+}
+
 namespace {
 
 template <typename T>
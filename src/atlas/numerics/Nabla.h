@@ -28,7 +28,8 @@ class FieldImpl;
 }  // namespace atlas
 namespace atlas {
 class Field;
-}
+class FieldSet;
+}  // namespace atlas
 
 namespace atlas {
 namespace numerics {
@@ -42,6 +43,11 @@ public:
     virtual void divergence( const Field& vector, Field& div ) const      = 0;
     virtual void curl( const Field& vector, Field& curl ) const           = 0;
     virtual void laplacian( const Field& scalar, Field& laplacian ) const = 0;
+
+    /// Operators on all fields of a FieldSet; by default applied field by field
+    virtual void gradient( const FieldSet& scalars, FieldSet& grads ) const;
+    virtual void divergence( const FieldSet& vectors, FieldSet& divs ) const;
+    virtual void curl( const FieldSet& vectors, FieldSet& curls ) const;
 };
 
 // ------------------------------------------------------------------
@@ -65,6 +71,10 @@ public:
     void curl( const Field& vector, Field& curl ) const;
     void laplacian( const Field& scalar, Field& laplacian ) const;
 
+    void gradient( const FieldSet& scalars, FieldSet& grads ) const;
+    void divergence( const FieldSet& vectors, FieldSet& divs ) const;
+    void curl( const FieldSet& vectors, FieldSet& curls ) const;
+
     const nabla_t* get() const { return nabla_.get(); }
 };
 
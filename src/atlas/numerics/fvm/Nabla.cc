@@ -8,12 +8,16 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <cmath>
+#include <string>
+
 #include "eckit/config/Parametrisation.h"
 #include "eckit/exception/Exceptions.h"
 
 #include "atlas/array/ArrayView.h"
 #include "atlas/array/MakeView.h"
 #include "atlas/field/Field.h"
+#include "atlas/field/FieldSet.h"
 #include "atlas/mesh/HybridElements.h"
 #include "atlas/mesh/Mesh.h"
 #include "atlas/mesh/Nodes.h"
@@ -36,6 +40,50 @@ namespace {
 static NablaBuilder<Nabla> __fvm_nabla( "fvm" );
 }
 
+namespace {
+
+template <typename Value>
+array::LocalView<Value, 2> make_scalar_view( const Field& field ) {
+    return field.levels() ? array::make_view<Value, 2>( field ).slice( Range::all(), Range::all() )
+                          : array::make_view<Value, 1>( field ).slice( Range::all(), Range::dummy() );
+}
+
+template <typename Value>
+array::LocalView<Value, 3> make_vector_view( const Field& field ) {
+    return field.levels() ? array::make_view<Value, 3>( field ).slice( Range::all(), Range::all(), Range::all() )
+                          : array::make_view<Value, 2>( field ).slice( Range::all(), Range::dummy(), Range::all() );
+}
+
+size_t nb_levels( const Field& field ) {
+    return field.levels() ? field.levels() : 1;
+}
+
+void check_levels( const Field& in, const Field& out, const std::string& name ) {
+    if ( nb_levels( in ) != nb_levels( out ) ) {
+        throw eckit::AssertionFailed( name + " field should have same number of levels", Here() );
+    }
+}
+
+// All input and output fields must have the same datatype, which is returned
+array::DataType common_datatype( const FieldSet& in, const FieldSet& out ) {
+    if ( in.size() != out.size() ) {
+        throw eckit::AssertionFailed( "input and output FieldSets should have same number of fields", Here() );
+    }
+    if ( in.size() == 0 ) { return array::DataType::real64(); }
+    array::DataType datatype = in[0].datatype();
+    for ( size_t f = 0; f < in.size(); ++f ) {
+        if ( in[f].datatype() != datatype || out[f].datatype() != datatype ) {
+            throw eckit::BadParameter( "all fields should have same datatype", Here() );
+        }
+    }
+    if ( datatype != array::DataType::real64() && datatype != array::DataType::real32() ) {
+        throw eckit::BadParameter( "fvm::Nabla only supports real32 and real64 fields", Here() );
+    }
+    return datatype;
+}
+
+}  // namespace
+
 Nabla::Nabla( const numerics::Method& method, const eckit::Parametrisation& p ) :
     atlas::numerics::Nabla::nabla_t( method, p ) {
     fvm_ = dynamic_cast<const fvm::Method*>( &method );
@@ -50,8 +98,10 @@ Nabla::~Nabla() {}
 
 void Nabla::setup() {
     const mesh::Edges& edges = fvm_->mesh().edges();
+    const mesh::Nodes& nodes = fvm_->mesh().nodes();
 
     const size_t nedges = edges.size();
+    const size_t nnodes = nodes.size();
 
     const array::ArrayView<int, 1> edge_is_pole = array::make_view<int, 1>( edges.field( "is_pole_edge" ) );
 
@@ -65,36 +115,12 @@ void Nabla::setup() {
     pole_edges_.reserve( c );
     for ( size_t jedge = 0; jedge < c; ++jedge )
         pole_edges_.push_back( tmp[jedge] );
-}
-
-void Nabla::gradient( const Field& field, Field& grad_field ) const {
-    if ( field.variables() > 1 ) { return gradient_of_vector( field, grad_field ); }
-    else {
-        return gradient_of_scalar( field, grad_field );
-    }
-    throw eckit::SeriousBug( "Cannot figure out if field is a scalar or vector field", Here() );
-}
-
-void Nabla::gradient_of_scalar( const Field& scalar_field, Field& grad_field ) const {
-    Log::debug() << "Compute gradient of scalar field " << scalar_field.name() << " with fvm method" << std::endl;
-    const double radius  = fvm_->radius();
-    const double deg2rad = M_PI / 180.;
-
-    const mesh::Edges& edges = fvm_->mesh().edges();
-    const mesh::Nodes& nodes = fvm_->mesh().nodes();
-
-    const size_t nnodes = nodes.size();
-    const size_t nedges = edges.size();
-    const size_t nlev   = scalar_field.levels() ? scalar_field.levels() : 1;
-    if ( ( grad_field.levels() ? grad_field.levels() : 1 ) != nlev )
-        throw eckit::AssertionFailed( "gradient field should have same number of levels", Here() );
 
-    const auto scalar = scalar_field.levels()
-                            ? array::make_view<double, 2>( scalar_field ).slice( Range::all(), Range::all() )
-                            : array::make_view<double, 1>( scalar_field ).slice( Range::all(), Range::dummy() );
-    auto grad = grad_field.levels()
-                    ? array::make_view<double, 3>( grad_field ).slice( Range::all(), Range::all(), Range::all() )
-                    : array::make_view<double, 2>( grad_field ).slice( Range::all(), Range::dummy(), Range::all() );
+    // Precompute metric terms, evaluated exactly as the operators used to do on every call
+    const double radius     = fvm_->radius();
+    const double deg2rad    = M_PI / 180.;
+    const double scale      = deg2rad * deg2rad * radius;
+    const double scale_curl = deg2rad * deg2rad * radius * radius;
 
     const auto lonlat_deg     = array::make_view<double, 2>( nodes.lonlat() );
     const auto dual_volumes   = array::make_view<double, 1>( nodes.field( "dual_volumes" ) );
@@ -104,42 +130,106 @@ void Nabla::gradient_of_scalar( const Field& scalar_field, Field& grad_field ) c
     const mesh::Connectivity& node2edge           = nodes.edge_connectivity();
     const mesh::MultiBlockConnectivity& edge2node = edges.node_connectivity();
 
-    array::ArrayT<double> avgS_arr( nedges, nlev, 2ul );
-    auto avgS = array::make_view<double, 3>( avgS_arr );
+    node_metrics_.resize( nnodes );
+    node_edges_begin_.resize( nnodes + 1 );
+    node_edges_begin_[0] = 0;
+    for ( size_t jnode = 0; jnode < nnodes; ++jnode ) {
+        node_edges_begin_[jnode + 1] = node_edges_begin_[jnode] + node2edge.cols( jnode );
+    }
+    node_edges_.resize( node_edges_begin_[nnodes] );
+
+    atlas_omp_parallel_for( size_t jnode = 0; jnode < nnodes; ++jnode ) {
+        const double y     = lonlat_deg( jnode, LAT ) * deg2rad;
+        NodeMetric& metric = node_metrics_[jnode];
+        metric.metric_y    = 1. / ( dual_volumes( jnode ) * scale );
+        metric.metric_x    = metric.metric_y / std::cos( y );
+        metric.metric_div  = 1. / ( dual_volumes( jnode ) * scale * std::cos( y ) );
+        metric.metric_curl = 1. / ( dual_volumes( jnode ) * scale_curl * std::cos( y ) );
+        metric.cosy        = std::cos( y );
+        metric.rcosy       = radius * std::cos( y );
+        for ( size_t jedge = 0; jedge < node2edge.cols( jnode ); ++jedge ) {
+            const idx_t iedge = node2edge( jnode, jedge );
+            NodeEdge& e       = node_edges_[node_edges_begin_[jnode] + jedge];
+            e.ip1             = edge2node( iedge, 0 );
+            e.ip2             = edge2node( iedge, 1 );
+            e.sign            = node2edge_sign( jnode, jedge );
+            e.S[LON]          = dual_normals( iedge, LON ) * deg2rad;
+            e.S[LAT]          = dual_normals( iedge, LAT ) * deg2rad;
+            e.pole            = edge_is_pole( iedge );
+        }
+    }
 
-    const double scale = deg2rad * deg2rad * radius;
+    pole_edge_S_lat_.resize( pole_edges_.size() );
+    for ( size_t jedge = 0; jedge < pole_edges_.size(); ++jedge ) {
+        pole_edge_S_lat_[jedge] = dual_normals( pole_edges_[jedge], LAT ) * deg2rad;
+    }
+}
 
-    atlas_omp_parallel {
-        atlas_omp_for( size_t jedge = 0; jedge < nedges; ++jedge ) {
-            int ip1 = edge2node( jedge, 0 );
-            int ip2 = edge2node( jedge, 1 );
+void Nabla::gradient( const Field& field, Field& grad_field ) const {
+    FieldSet fields;
+    fields.add( field );
+    FieldSet grads;
+    grads.add( grad_field );
+    gradient( fields, grads );
+}
 
-            for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
-                double avg               = ( scalar( ip1, jlev ) + scalar( ip2, jlev ) ) * 0.5;
-                avgS( jedge, jlev, LON ) = dual_normals( jedge, LON ) * deg2rad * avg;
-                avgS( jedge, jlev, LAT ) = dual_normals( jedge, LAT ) * deg2rad * avg;
-            }
+void Nabla::gradient( const FieldSet& fields, FieldSet& grads ) const {
+    FieldSet scalars, scalar_grads, vectors, vector_grads;
+    for ( size_t f = 0; f < fields.size() && f < grads.size(); ++f ) {
+        if ( fields[f].variables() > 1 ) {
+            vectors.add( fields[f] );
+            vector_grads.add( grads[f] );
+        }
+        else {
+            scalars.add( fields[f] );
+            scalar_grads.add( grads[f] );
         }
+    }
+    if ( common_datatype( fields, grads ) == array::DataType::real64() ) {
+        if ( scalars.size() ) gradient_of_scalar<double>( scalars, scalar_grads );
+        if ( vectors.size() ) gradient_of_vector<double>( vectors, vector_grads );
+    }
+    else {
+        if ( scalars.size() ) gradient_of_scalar<float>( scalars, scalar_grads );
+        if ( vectors.size() ) gradient_of_vector<float>( vectors, vector_grads );
+    }
+}
+
+template <typename Value>
+void Nabla::gradient_of_scalar( const FieldSet& scalar_fields, FieldSet& grad_fields ) const {
+    const size_t nnodes  = fvm_->mesh().nodes().size();
+    const size_t nfields = scalar_fields.size();
+
+    std::vector<array::LocalView<Value, 2>> scalar;
+    std::vector<array::LocalView<Value, 3>> grad;
+    scalar.reserve( nfields );
+    grad.reserve( nfields );
+    for ( size_t f = 0; f < nfields; ++f ) {
+        Log::debug() << "Compute gradient of scalar field " << scalar_fields[f].name() << " with fvm method"
+                     << std::endl;
+        check_levels( scalar_fields[f], grad_fields[f], "gradient" );
+        scalar.emplace_back( make_scalar_view<Value>( scalar_fields[f] ) );
+        grad.emplace_back( make_vector_view<Value>( grad_fields[f] ) );
+    }
 
-        atlas_omp_for( size_t jnode = 0; jnode < nnodes; ++jnode ) {
+    // Node-centric: each node sums contributions of its edges, for all fields
+    atlas_omp_parallel_for( size_t jnode = 0; jnode < nnodes; ++jnode ) {
+        const NodeMetric& metric = node_metrics_[jnode];
+        const NodeEdge* begin    = node_edges_.data() + node_edges_begin_[jnode];
+        const NodeEdge* end      = node_edges_.data() + node_edges_begin_[jnode + 1];
+        for ( size_t f = 0; f < nfields; ++f ) {
+            const auto& s     = scalar[f];
+            auto& g           = grad[f];
+            const size_t nlev = s.shape( 1 );
             for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
-                grad( jnode, jlev, LON ) = 0.;
-                grad( jnode, jlev, LAT ) = 0.;
-            }
-            for ( size_t jedge = 0; jedge < node2edge.cols( jnode ); ++jedge ) {
-                const int iedge  = node2edge( jnode, jedge );
-                const double add = node2edge_sign( jnode, jedge );
-                for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
-                    grad( jnode, jlev, LON ) += add * avgS( iedge, jlev, LON );
-                    grad( jnode, jlev, LAT ) += add * avgS( iedge, jlev, LAT );
+                double sum[2] = {0., 0.};
+                for ( const NodeEdge* e = begin; e != end; ++e ) {
+                    const double avg = ( double( s( e->ip1, jlev ) ) + double( s( e->ip2, jlev ) ) ) * 0.5;
+                    sum[LON] += e->sign * ( e->S[LON] * avg );
+                    sum[LAT] += e->sign * ( e->S[LAT] * avg );
                 }
-            }
-            const double y        = lonlat_deg( jnode, LAT ) * deg2rad;
-            const double metric_y = 1. / ( dual_volumes( jnode ) * scale );
-            const double metric_x = metric_y / std::cos( y );
-            for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
-                grad( jnode, jlev, LON ) *= metric_x;
-                grad( jnode, jlev, LAT ) *= metric_y;
+                g( jnode, jlev, LON ) = sum[LON] * metric.metric_x;
+                g( jnode, jlev, LAT ) = sum[LAT] * metric.metric_y;
             }
         }
     }
@@ -147,41 +237,24 @@ void Nabla::gradient_of_scalar( const Field& scalar_field, Field& grad_field ) c
 
 // ================================================================================
 
-void Nabla::gradient_of_vector( const Field& vector_field, Field& grad_field ) const {
-    Log::debug() << "Compute gradient of vector field " << vector_field.name() << " with fvm method" << std::endl;
-    const double radius  = fvm_->radius();
-    const double deg2rad = M_PI / 180.;
-
-    const mesh::Edges& edges = fvm_->mesh().edges();
-    const mesh::Nodes& nodes = fvm_->mesh().nodes();
-
-    const size_t nnodes = nodes.size();
-    const size_t nedges = edges.size();
-    const size_t nlev   = vector_field.levels();
-    if ( vector_field.levels() != nlev )
-        throw eckit::AssertionFailed( "gradient field should have same number of levels", Here() );
-
-    const auto vector =
-        vector_field.levels()
-            ? array::make_view<double, 3>( vector_field ).slice( Range::all(), Range::all(), Range::all() )
-            : array::make_view<double, 2>( vector_field ).slice( Range::all(), Range::dummy(), Range::all() );
-    auto grad = grad_field.levels()
-                    ? array::make_view<double, 3>( grad_field ).slice( Range::all(), Range::all(), Range::all() )
-                    : array::make_view<double, 2>( grad_field ).slice( Range::all(), Range::dummy(), Range::all() );
-
-    const array::ArrayView<double, 2> lonlat_deg     = array::make_view<double, 2>( nodes.lonlat() );
-    const array::ArrayView<double, 1> dual_volumes   = array::make_view<double, 1>( nodes.field( "dual_volumes" ) );
-    const array::ArrayView<double, 2> dual_normals   = array::make_view<double, 2>( edges.field( "dual_normals" ) );
-    const array::ArrayView<int, 1> edge_is_pole      = array::make_view<int, 1>( edges.field( "is_pole_edge" ) );
-    const array::ArrayView<double, 2> node2edge_sign = array::make_view<double, 2>( nodes.field( "node2edge_sign" ) );
-
-    const mesh::Connectivity& node2edge           = nodes.edge_connectivity();
-    const mesh::MultiBlockConnectivity& edge2node = edges.node_connectivity();
-
-    array::ArrayT<double> avgS_arr( nedges, nlev, 4ul );
-    array::ArrayView<double, 3> avgS = array::make_view<double, 3>( avgS_arr );
-
-    const double scale = deg2rad * deg2rad * radius;
+template <typename Value>
+void Nabla::gradient_of_vector( const FieldSet& vector_fields, FieldSet& grad_fields ) const {
+    const size_t nnodes  = fvm_->mesh().nodes().size();
+    const size_t nfields = vector_fields.size();
+
+    const mesh::MultiBlockConnectivity& edge2node = fvm_->mesh().edges().node_connectivity();
+
+    std::vector<array::LocalView<Value, 3>> vector;
+    std::vector<array::LocalView<Value, 3>> grad;
+    vector.reserve( nfields );
+    grad.reserve( nfields );
+    for ( size_t f = 0; f < nfields; ++f ) {
+        Log::debug() << "Compute gradient of vector field " << vector_fields[f].name() << " with fvm method"
+                     << std::endl;
+        check_levels( vector_fields[f], grad_fields[f], "gradient" );
+        vector.emplace_back( make_vector_view<Value>( vector_fields[f] ) );
+        grad.emplace_back( make_vector_view<Value>( grad_fields[f] ) );
+    }
 
     enum
     {
@@ -191,60 +264,50 @@ void Nabla::gradient_of_vector( const Field& vector_field, Field& grad_field ) c
         LATdLAT = 3
     };
 
-    atlas_omp_parallel {
-        atlas_omp_for( size_t jedge = 0; jedge < nedges; ++jedge ) {
-            int ip1    = edge2node( jedge, 0 );
-            int ip2    = edge2node( jedge, 1 );
-            double pbc = 1. - 2. * edge_is_pole( jedge );
-
-            for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
-                double avg[2]                = {( vector( ip1, jlev, LON ) + pbc * vector( ip2, jlev, LON ) ) * 0.5,
-                                 ( vector( ip1, jlev, LAT ) + pbc * vector( ip2, jlev, LAT ) ) * 0.5};
-                avgS( jedge, jlev, LONdLON ) = dual_normals( jedge, LON ) * deg2rad * avg[LON];
-                // above = 0 at pole because of dual_normals
-                avgS( jedge, jlev, LONdLAT ) = dual_normals( jedge, LAT ) * deg2rad * avg[LON];
-                avgS( jedge, jlev, LATdLON ) = dual_normals( jedge, LON ) * deg2rad * avg[LAT];
-                // above = 0 at pole because of dual_normals
-                avgS( jedge, jlev, LATdLAT ) = dual_normals( jedge, LAT ) * deg2rad * avg[LAT];
-            }
-        }
-
-        atlas_omp_for( size_t jnode = 0; jnode < nnodes; ++jnode ) {
+    atlas_omp_parallel_for( size_t jnode = 0; jnode < nnodes; ++jnode ) {
+        const NodeMetric& metric = node_metrics_[jnode];
+        const NodeEdge* begin    = node_edges_.data() + node_edges_begin_[jnode];
+        const NodeEdge* end      = node_edges_.data() + node_edges_begin_[jnode + 1];
+        for ( size_t f = 0; f < nfields; ++f ) {
+            const auto& v     = vector[f];
+            auto& g           = grad[f];
+            const size_t nlev = v.shape( 1 );
             for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
-                grad( jnode, jlev, LONdLON ) = 0.;
-                grad( jnode, jlev, LONdLAT ) = 0.;
-                grad( jnode, jlev, LATdLON ) = 0.;
-                grad( jnode, jlev, LATdLAT ) = 0.;
-            }
-            for ( size_t jedge = 0; jedge < node2edge.cols( jnode ); ++jedge ) {
-                const int iedge = node2edge( jnode, jedge );
-                double add      = node2edge_sign( jnode, jedge );
-                for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
-                    grad( jnode, jlev, LONdLON ) += add * avgS( iedge, jlev, LONdLON );
-                    grad( jnode, jlev, LONdLAT ) += add * avgS( iedge, jlev, LONdLAT );
-                    grad( jnode, jlev, LATdLON ) += add * avgS( iedge, jlev, LATdLON );
-                    grad( jnode, jlev, LATdLAT ) += add * avgS( iedge, jlev, LATdLAT );
+                double sum[4] = {0., 0., 0., 0.};
+                for ( const NodeEdge* e = begin; e != end; ++e ) {
+                    const double pbc    = 1. - 2. * e->pole;
+                    const double avg[2] = {( double( v( e->ip1, jlev, LON ) ) + pbc * v( e->ip2, jlev, LON ) ) * 0.5,
+                                           ( double( v( e->ip1, jlev, LAT ) ) + pbc * v( e->ip2, jlev, LAT ) ) * 0.5};
+                    sum[LONdLON] += e->sign * ( e->S[LON] * avg[LON] );
+                    sum[LONdLAT] += e->sign * ( e->S[LAT] * avg[LON] );
+                    sum[LATdLON] += e->sign * ( e->S[LON] * avg[LAT] );
+                    sum[LATdLAT] += e->sign * ( e->S[LAT] * avg[LAT] );
                 }
-            }
-            const double y        = lonlat_deg( jnode, LAT ) * deg2rad;
-            const double metric_y = 1. / ( dual_volumes( jnode ) * scale );
-            const double metric_x = metric_y / std::cos( y );
-            for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
-                grad( jnode, jlev, LONdLON ) *= metric_x;
-                grad( jnode, jlev, LATdLON ) *= metric_x;
-                grad( jnode, jlev, LONdLAT ) *= metric_y;
-                grad( jnode, jlev, LATdLAT ) *= metric_y;
+                g( jnode, jlev, LONdLON ) = sum[LONdLON] * metric.metric_x;
+                g( jnode, jlev, LATdLON ) = sum[LATdLON] * metric.metric_x;
+                g( jnode, jlev, LONdLAT ) = sum[LONdLAT] * metric.metric_y;
+                g( jnode, jlev, LATdLAT ) = sum[LATdLAT] * metric.metric_y;
             }
         }
     }
+
     // Fix wrong node2edge_sign for vector quantities
-    for ( size_t jedge = 0; jedge < pole_edges_.size(); ++jedge ) {
-        const int iedge       = pole_edges_[jedge];
-        const int jnode       = edge2node( iedge, 1 );
-        const double metric_y = 1. / ( dual_volumes( jnode ) * scale );
-        for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
-            grad( jnode, jlev, LONdLAT ) -= 2. * avgS( iedge, jlev, LONdLAT ) * metric_y;
-            grad( jnode, jlev, LATdLAT ) -= 2. * avgS( iedge, jlev, LATdLAT ) * metric_y;
+    for ( size_t f = 0; f < nfields; ++f ) {
+        const auto& v     = vector[f];
+        auto& g           = grad[f];
+        const size_t nlev = v.shape( 1 );
+        for ( size_t jedge = 0; jedge < pole_edges_.size(); ++jedge ) {
+            const int iedge       = pole_edges_[jedge];
+            const int ip1         = edge2node( iedge, 0 );
+            const int jnode       = edge2node( iedge, 1 );
+            const double metric_y = node_metrics_[jnode].metric_y;
+            const double S_lat    = pole_edge_S_lat_[jedge];
+            for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
+                const double avg[2] = {( double( v( ip1, jlev, LON ) ) - v( jnode, jlev, LON ) ) * 0.5,
+                                       ( double( v( ip1, jlev, LAT ) ) - v( jnode, jlev, LAT ) ) * 0.5};
+                g( jnode, jlev, LONdLAT ) -= 2. * ( S_lat * avg[LON] ) * metric_y;
+                g( jnode, jlev, LATdLAT ) -= 2. * ( S_lat * avg[LAT] ) * metric_y;
+            }
         }
     }
 }
@@ -252,167 +315,128 @@ void Nabla::gradient_of_vector( const Field& vector_field, Field& grad_field ) c
 // ================================================================================
 
 void Nabla::divergence( const Field& vector_field, Field& div_field ) const {
-    const double radius  = fvm_->radius();
-    const double deg2rad = M_PI / 180.;
-
-    const mesh::Edges& edges = fvm_->mesh().edges();
-    const mesh::Nodes& nodes = fvm_->mesh().nodes();
-
-    const size_t nnodes = nodes.size();
-    const size_t nedges = edges.size();
-    const size_t nlev   = vector_field.levels();
-    if ( div_field.levels() != nlev )
-        throw eckit::AssertionFailed( "divergence field should have same number of levels", Here() );
-
-    const auto vector =
-        vector_field.levels()
-            ? array::make_view<double, 3>( vector_field ).slice( Range::all(), Range::all(), Range::all() )
-            : array::make_view<double, 2>( vector_field ).slice( Range::all(), Range::dummy(), Range::all() );
-    auto div = div_field.levels() ? array::make_view<double, 2>( div_field ).slice( Range::all(), Range::all() )
-                                  : array::make_view<double, 1>( div_field ).slice( Range::all(), Range::dummy() );
-
-    const auto lonlat_deg                         = array::make_view<double, 2>( nodes.lonlat() );
-    const auto dual_volumes                       = array::make_view<double, 1>( nodes.field( "dual_volumes" ) );
-    const auto dual_normals                       = array::make_view<double, 2>( edges.field( "dual_normals" ) );
-    const auto edge_is_pole                       = array::make_view<int, 1>( edges.field( "is_pole_edge" ) );
-    const auto node2edge_sign                     = array::make_view<double, 2>( nodes.field( "node2edge_sign" ) );
-    const mesh::Connectivity& node2edge           = nodes.edge_connectivity();
-    const mesh::MultiBlockConnectivity& edge2node = edges.node_connectivity();
-
-    array::ArrayT<double> avgS_arr( nedges, nlev, 2ul );
-    array::ArrayView<double, 3> avgS = array::make_view<double, 3>( avgS_arr );
-
-    const double scale = deg2rad * deg2rad * radius;
-
-    atlas_omp_parallel {
-        atlas_omp_for( size_t jedge = 0; jedge < nedges; ++jedge ) {
-            size_t ip1   = edge2node( jedge, 0 );
-            size_t ip2   = edge2node( jedge, 1 );
-            double y1    = lonlat_deg( ip1, LAT ) * deg2rad;
-            double y2    = lonlat_deg( ip2, LAT ) * deg2rad;
-            double cosy1 = std::cos( y1 );
-            double cosy2 = std::cos( y2 );
+    FieldSet vectors;
+    vectors.add( vector_field );
+    FieldSet divs;
+    divs.add( div_field );
+    divergence( vectors, divs );
+}
 
-            double pbc = 1. - edge_is_pole( jedge );
+void Nabla::divergence( const FieldSet& vectors, FieldSet& divs ) const {
+    if ( common_datatype( vectors, divs ) == array::DataType::real64() ) { divergence<double>( vectors, divs ); }
+    else {
+        divergence<float>( vectors, divs );
+    }
+}
 
-            for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
-                double avg[2] = {
-                    ( vector( ip1, jlev, LON ) + vector( ip2, jlev, LON ) ) * 0.5,
-                    ( cosy1 * vector( ip1, jlev, LAT ) + cosy2 * vector( ip2, jlev, LAT ) ) * 0.5 *
-                        pbc  // (force cos(y)=0 at pole)
-                };
-                avgS( jedge, jlev, LON ) = dual_normals( jedge, LON ) * deg2rad * avg[LON];
-                // above = 0 at pole by construction of S
-                avgS( jedge, jlev, LAT ) = dual_normals( jedge, LAT ) * deg2rad * avg[LAT];
-                // above = 0 at pole by construction of pbc
-                // We don't need the cross terms for divergence,
-                //    i.e.      dual_normals(jedge,LON)*deg2rad*avg[LAT]
-                //        and   dual_normals(jedge,LAT)*deg2rad*avg[LON]
-            }
-        }
+template <typename Value>
+void Nabla::divergence( const FieldSet& vector_fields, FieldSet& div_fields ) const {
+    const size_t nnodes  = fvm_->mesh().nodes().size();
+    const size_t nfields = vector_fields.size();
+
+    std::vector<array::LocalView<Value, 3>> vector;
+    std::vector<array::LocalView<Value, 2>> div;
+    vector.reserve( nfields );
+    div.reserve( nfields );
+    for ( size_t f = 0; f < nfields; ++f ) {
+        check_levels( vector_fields[f], div_fields[f], "divergence" );
+        vector.emplace_back( make_vector_view<Value>( vector_fields[f] ) );
+        div.emplace_back( make_scalar_view<Value>( div_fields[f] ) );
+    }
 
-        atlas_omp_for( size_t jnode = 0; jnode < nnodes; ++jnode ) {
+    atlas_omp_parallel_for( size_t jnode = 0; jnode < nnodes; ++jnode ) {
+        const NodeEdge* begin = node_edges_.data() + node_edges_begin_[jnode];
+        const NodeEdge* end   = node_edges_.data() + node_edges_begin_[jnode + 1];
+        for ( size_t f = 0; f < nfields; ++f ) {
+            const auto& v     = vector[f];
+            auto& d           = div[f];
+            const size_t nlev = v.shape( 1 );
             for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
-                div( jnode, jlev ) = 0.;
-            }
-            for ( size_t jedge = 0; jedge < node2edge.cols( jnode ); ++jedge ) {
-                int iedge  = node2edge( jnode, jedge );
-                double add = node2edge_sign( jnode, jedge );
-                for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
-                    div( jnode, jlev ) += add * ( avgS( iedge, jlev, LON ) + avgS( iedge, jlev, LAT ) );
+                double sum = 0.;
+                for ( const NodeEdge* e = begin; e != end; ++e ) {
+                    const double cosy1  = node_metrics_[e->ip1].cosy;
+                    const double cosy2  = node_metrics_[e->ip2].cosy;
+                    const double pbc    = 1. - e->pole;
+                    const double avg[2] = {
+                        ( double( v( e->ip1, jlev, LON ) ) + v( e->ip2, jlev, LON ) ) * 0.5,
+                        ( cosy1 * v( e->ip1, jlev, LAT ) + cosy2 * v( e->ip2, jlev, LAT ) ) * 0.5 *
+                            pbc  // (force cos(y)=0 at pole)
+                    };
+                    // We don't need the cross terms for divergence,
+                    //    i.e.      dual_normals(jedge,LON)*deg2rad*avg[LAT]
+                    //        and   dual_normals(jedge,LAT)*deg2rad*avg[LON]
+                    sum += e->sign * ( e->S[LON] * avg[LON] + e->S[LAT] * avg[LAT] );
                 }
-            }
-            const double y = lonlat_deg( jnode, LAT ) * deg2rad;
-            double metric  = 1. / ( dual_volumes( jnode ) * scale * std::cos( y ) );
-            for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
-                div( jnode, jlev ) *= metric;
+                d( jnode, jlev ) = sum * node_metrics_[jnode].metric_div;
             }
         }
     }
 }
 
-void Nabla::curl( const Field& vector_field, Field& curl_field ) const {
-    const double radius  = fvm_->radius();
-    const double deg2rad = M_PI / 180.;
-
-    const mesh::Edges& edges = fvm_->mesh().edges();
-    const mesh::Nodes& nodes = fvm_->mesh().nodes();
-
-    const size_t nnodes = nodes.size();
-    const size_t nedges = edges.size();
-    const size_t nlev   = vector_field.levels();
-    if ( curl_field.levels() != nlev )
-        throw eckit::AssertionFailed( "curl field should have same number of levels", Here() );
-
-    const auto vector =
-        vector_field.levels()
-            ? array::make_view<double, 3>( vector_field ).slice( Range::all(), Range::all(), Range::all() )
-            : array::make_view<double, 2>( vector_field ).slice( Range::all(), Range::dummy(), Range::all() );
-    auto curl = curl_field.levels() ? array::make_view<double, 2>( curl_field ).slice( Range::all(), Range::all() )
-                                    : array::make_view<double, 1>( curl_field ).slice( Range::all(), Range::dummy() );
-
-    const auto lonlat_deg     = array::make_view<double, 2>( nodes.lonlat() );
-    const auto dual_volumes   = array::make_view<double, 1>( nodes.field( "dual_volumes" ) );
-    const auto dual_normals   = array::make_view<double, 2>( edges.field( "dual_normals" ) );
-    const auto edge_is_pole   = array::make_view<int, 1>( edges.field( "is_pole_edge" ) );
-    const auto node2edge_sign = array::make_view<double, 2>( nodes.field( "node2edge_sign" ) );
-
-    const mesh::Connectivity& node2edge           = nodes.edge_connectivity();
-    const mesh::MultiBlockConnectivity& edge2node = edges.node_connectivity();
-
-    array::ArrayT<double> avgS_arr( nedges, nlev, 2ul );
-    array::ArrayView<double, 3> avgS = array::make_view<double, 3>( avgS_arr );
-
-    const double scale = deg2rad * deg2rad * radius * radius;
+// ================================================================================
 
-    atlas_omp_parallel {
-        atlas_omp_for( size_t jedge = 0; jedge < nedges; ++jedge ) {
-            size_t ip1    = edge2node( jedge, 0 );
-            size_t ip2    = edge2node( jedge, 1 );
-            double y1     = lonlat_deg( ip1, LAT ) * deg2rad;
-            double y2     = lonlat_deg( ip2, LAT ) * deg2rad;
-            double rcosy1 = radius * std::cos( y1 );
-            double rcosy2 = radius * std::cos( y2 );
+void Nabla::curl( const Field& vector_field, Field& curl_field ) const {
+    FieldSet vectors;
+    vectors.add( vector_field );
+    FieldSet curls;
+    curls.add( curl_field );
+    curl( vectors, curls );
+}
 
-            double pbc = 1 - edge_is_pole( jedge );
+void Nabla::curl( const FieldSet& vectors, FieldSet& curls ) const {
+    if ( common_datatype( vectors, curls ) == array::DataType::real64() ) { curl<double>( vectors, curls ); }
+    else {
+        curl<float>( vectors, curls );
+    }
+}
 
-            for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
-                double avg[2] = {( rcosy1 * vector( ip1, jlev, LON ) + rcosy2 * vector( ip2, jlev, LON ) ) * 0.5 *
-                                     pbc,  // (force R*cos(y)=0 at pole)
-                                 ( radius * vector( ip1, jlev, LAT ) + radius * vector( ip2, jlev, LAT ) ) * 0.5};
-                avgS( jedge, jlev, LON ) = dual_normals( jedge, LAT ) * deg2rad * avg[LON];
-                // above = 0 at pole by construction of pbc
-                avgS( jedge, jlev, LAT ) = dual_normals( jedge, LON ) * deg2rad * avg[LAT];
-                // above = 0 at pole by construction of S
-                // We don't need the non-cross terms for curl, i.e.
-                //          dual_normals(jedge,LON)*deg2rad*avg[LON]
-                //   and    dual_normals(jedge,LAT)*deg2rad*avg[LAT]
-            }
-        }
+template <typename Value>
+void Nabla::curl( const FieldSet& vector_fields, FieldSet& curl_fields ) const {
+    const double radius  = fvm_->radius();
+    const size_t nnodes  = fvm_->mesh().nodes().size();
+    const size_t nfields = vector_fields.size();
+
+    std::vector<array::LocalView<Value, 3>> vector;
+    std::vector<array::LocalView<Value, 2>> curl;
+    vector.reserve( nfields );
+    curl.reserve( nfields );
+    for ( size_t f = 0; f < nfields; ++f ) {
+        check_levels( vector_fields[f], curl_fields[f], "curl" );
+        vector.emplace_back( make_vector_view<Value>( vector_fields[f] ) );
+        curl.emplace_back( make_scalar_view<Value>( curl_fields[f] ) );
+    }
 
-        atlas_omp_for( size_t jnode = 0; jnode < nnodes; ++jnode ) {
+    atlas_omp_parallel_for( size_t jnode = 0; jnode < nnodes; ++jnode ) {
+        const NodeEdge* begin = node_edges_.data() + node_edges_begin_[jnode];
+        const NodeEdge* end   = node_edges_.data() + node_edges_begin_[jnode + 1];
+        for ( size_t f = 0; f < nfields; ++f ) {
+            const auto& v     = vector[f];
+            auto& c           = curl[f];
+            const size_t nlev = v.shape( 1 );
             for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
-                curl( jnode, jlev ) = 0.;
-            }
-            for ( size_t jedge = 0; jedge < node2edge.cols( jnode ); ++jedge ) {
-                size_t iedge = node2edge( jnode, jedge );
-                double add   = node2edge_sign( jnode, jedge );
-                for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
-                    curl( jnode, jlev ) += add * ( avgS( iedge, jlev, LAT ) - avgS( iedge, jlev, LON ) );
+                double sum = 0.;
+                for ( const NodeEdge* e = begin; e != end; ++e ) {
+                    const double rcosy1 = node_metrics_[e->ip1].rcosy;
+                    const double rcosy2 = node_metrics_[e->ip2].rcosy;
+                    const double pbc    = 1 - e->pole;
+                    const double avg[2] = {
+                        ( rcosy1 * v( e->ip1, jlev, LON ) + rcosy2 * v( e->ip2, jlev, LON ) ) * 0.5 *
+                            pbc,  // (force R*cos(y)=0 at pole)
+                        ( radius * v( e->ip1, jlev, LAT ) + radius * v( e->ip2, jlev, LAT ) ) * 0.5};
+                    // We don't need the non-cross terms for curl, i.e.
+                    //          dual_normals(jedge,LON)*deg2rad*avg[LON]
+                    //   and    dual_normals(jedge,LAT)*deg2rad*avg[LAT]
+                    sum += e->sign * ( e->S[LON] * avg[LAT] - e->S[LAT] * avg[LON] );
                 }
-            }
-            double y      = lonlat_deg( jnode, LAT ) * deg2rad;
-            double metric = 1. / ( dual_volumes( jnode ) * scale * std::cos( y ) );
-            for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
-                curl( jnode, jlev ) *= metric;
+                c( jnode, jlev ) = sum * node_metrics_[jnode].metric_curl;
             }
         }
     }
 }
 
 void Nabla::laplacian( const Field& scalar, Field& lapl ) const {
-    Field grad( fvm_->node_columns().createField<double>( option::name( "grad" ) | option::levels( scalar.levels() ) |
-                                                          option::variables( 2 ) ) );
+    Field grad( fvm_->node_columns().createField( option::name( "grad" ) | option::datatype( scalar.datatype() ) |
+                                                  option::levels( scalar.levels() ) | option::variables( 2 ) ) );
     gradient( scalar, grad );
     if ( fvm_->node_columns().halo().size() < 2 ) fvm_->node_columns().haloExchange( grad );
     divergence( grad, lapl );
@@ -12,6 +12,7 @@
 
 #include <vector>
 
+#include "atlas/library/config.h"
 #include "atlas/numerics/Nabla.h"
 
 namespace atlas {
@@ -24,7 +25,8 @@ class Method;
 
 namespace atlas {
 class Field;
-}
+class FieldSet;
+}  // namespace atlas
 
 namespace atlas {
 namespace numerics {
@@ -40,15 +42,47 @@ public:
     void curl( const Field& vector, Field& curl ) const;
     void laplacian( const Field& scalar, Field& laplacian ) const;
 
+    /// Operators applied to all fields of a FieldSet in a single pass over the nodes.
+    /// All fields must be either real32 or real64.
+    void gradient( const FieldSet& scalars, FieldSet& grads ) const;
+    void divergence( const FieldSet& vectors, FieldSet& divs ) const;
+    void curl( const FieldSet& vectors, FieldSet& curls ) const;
+
 private:
     void setup();
 
-    void gradient_of_scalar( const Field& scalar, Field& grad ) const;
-    void gradient_of_vector( const Field& vector, Field& grad ) const;
+    template <typename Value>
+    void gradient_of_scalar( const FieldSet& scalars, FieldSet& grads ) const;
+    template <typename Value>
+    void gradient_of_vector( const FieldSet& vectors, FieldSet& grads ) const;
+    template <typename Value>
+    void divergence( const FieldSet& vectors, FieldSet& divs ) const;
+    template <typename Value>
+    void curl( const FieldSet& vectors, FieldSet& curls ) const;
 
 private:
+    struct NodeMetric {
+        double metric_x;
+        double metric_y;
+        double metric_div;
+        double metric_curl;
+        double cosy;
+        double rcosy;
+    };
+    struct NodeEdge {
+        idx_t ip1;
+        idx_t ip2;
+        double sign;
+        double S[2];  // dual normal in radians
+        int pole;
+    };
+
     fvm::Method const* fvm_;
     std::vector<size_t> pole_edges_;
+    std::vector<double> pole_edge_S_lat_;
+    std::vector<NodeMetric> node_metrics_;
+    std::vector<size_t> node_edges_begin_;
+    std::vector<NodeEdge> node_edges_;  // edges of each node, starting at node_edges_begin_[node]
 };
 
 // ------------------------------------------------------------------
@@ -9,9 +9,11 @@
  */
 
 #include <cmath>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <sstream>
 #include <stdexcept>
 
 #include "eckit/exception/Exceptions.h"
@@ -32,6 +34,7 @@
 #include "atlas/output/detail/GmshIO.h"
 #include "atlas/parallel/GatherScatter.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/util/Constants.h"
 #include "atlas/util/CoordinateEnums.h"
@@ -119,61 +122,81 @@ array::LocalView<T, 2> make_level_view( const Field& field, int ndata, int jlev
     }
 }
 
-template <typename DATATYPE>
-void write_level( std::ostream& out, const array::ArrayView<gidx_t, 1> gidx,
-                  const array::LocalView<DATATYPE, 2> data ) {
-    int ndata = data.shape( 0 );
-    int nvars = data.shape( 1 );
-    if ( nvars == 1 ) {
-        for ( size_t n = 0; n < ndata; ++n ) {
-            out << gidx( n ) << " " << data( n, 0 ) << "\n";
-        }
-    }
+// Gmsh expects 1, 3 or 9 components per node. Returns for each component the field variable,
+// or -1 for a component padded with zero.
+std::vector<int> gmsh_components( int nvars ) {
+    if ( nvars == 1 ) { return {0}; }
     else if ( nvars <= 3 ) {
-        std::vector<DATATYPE> data_vec( 3, 0. );
-        for ( size_t n = 0; n < ndata; ++n ) {
-            out << gidx( n );
-            for ( size_t v = 0; v < nvars; ++v )
-                data_vec[v] = data( n, v );
-            for ( int v = 0; v < 3; ++v )
-                out << " " << data_vec[v];
-            out << "\n";
-        }
+        std::vector<int> components( 3, -1 );
+        for ( int v = 0; v < nvars; ++v )
+            components[v] = v;
+        return components;
     }
-    else if ( nvars <= 9 ) {
-        std::vector<DATATYPE> data_vec( 9, 0. );
-        if ( nvars == 4 ) {
-            for ( size_t n = 0; n < ndata; ++n ) {
-                for ( int i = 0; i < 2; ++i ) {
-                    for ( int j = 0; j < 2; ++j ) {
-                        data_vec[i * 3 + j] = data( n, i * 2 + j );
-                    }
+    else if ( nvars == 4 ) {
+        // 2x2 tensor into 3x3 tensor
+        return {0, 1, -1, 2, 3, -1, -1, -1, -1};
+    }
+    else if ( nvars == 9 ) {
+        return {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    }
+    NOTIMP;
+}
+
+// Number of nodes formatted or copied at once, before being written to the stream
+static const size_t write_level_chunk = 65536;
+
+template <typename DATATYPE>
+void write_level( std::ostream& out, const array::ArrayView<gidx_t, 1> gidx, const array::LocalView<DATATYPE, 2> data,
+                  bool binary ) {
+    const size_t ndata                = data.shape( 0 );
+    const std::vector<int> components = gmsh_components( data.shape( 1 ) );
+    const size_t ncomponents          = components.size();
+
+    auto value = [&]( size_t n, size_t c ) -> DATATYPE {
+        return components[c] < 0 ? DATATYPE( 0 ) : data( n, components[c] );
+    };
+
+    if ( binary ) {
+        // Records of node number and values in double precision, as announced in the header
+        const size_t record_size = sizeof( int ) + ncomponents * sizeof( double );
+        std::vector<char> buffer( std::min( write_level_chunk, ndata ) * record_size );
+        for ( size_t begin = 0; begin < ndata; begin += write_level_chunk ) {
+            const size_t end = std::min( begin + write_level_chunk, ndata );
+            atlas_omp_parallel_for( size_t n = begin; n < end; ++n ) {
+                char* record = buffer.data() + ( n - begin ) * record_size;
+                int g        = gidx( n );
+                std::memcpy( record, &g, sizeof( int ) );
+                for ( size_t c = 0; c < ncomponents; ++c ) {
+                    double v = value( n, c );
+                    std::memcpy( record + sizeof( int ) + c * sizeof( double ), &v, sizeof( double ) );
                 }
-                out << gidx( n );
-                for ( int v = 0; v < 9; ++v )
-                    out << " " << data_vec[v];
-                out << "\n";
             }
+            out.write( buffer.data(), ( end - begin ) * record_size );
         }
-        else if ( nvars == 9 ) {
-            for ( size_t n = 0; n < ndata; ++n ) {
-                for ( int i = 0; i < 3; ++i ) {
-                    for ( int j = 0; j < 3; ++j ) {
-                        data_vec[i * 3 + j] = data( n, i * 2 + j );
-                    }
+        out << "\n";
+    }
+    else {
+        // Each thread formats a contiguous block of nodes with the format settings of the output stream
+        const size_t nb_blocks = atlas_omp_get_max_threads();
+        std::vector<std::string> text( nb_blocks );
+        for ( size_t begin = 0; begin < ndata; begin += write_level_chunk ) {
+            const size_t end = std::min( begin + write_level_chunk, ndata );
+            atlas_omp_parallel_for( size_t b = 0; b < nb_blocks; ++b ) {
+                std::ostringstream ss;
+                ss.copyfmt( out );
+                for ( size_t n = begin + ( end - begin ) * b / nb_blocks;
+                      n < begin + ( end - begin ) * ( b + 1 ) / nb_blocks; ++n ) {
+                    ss << gidx( n );
+                    for ( size_t c = 0; c < ncomponents; ++c )
+                        ss << " " << value( n, c );
+                    ss << "\n";
                 }
-                out << gidx( n );
-                for ( int v = 0; v < 9; ++v )
-                    out << " " << data_vec[v];
-                out << "\n";
+                text[b] = ss.str();
+            }
+            for ( const std::string& block : text ) {
+                out.write( block.data(), block.size() );
             }
         }
-        else {
-            NOTIMP;
-        }
-    }
-    else {
-        NOTIMP;
     }
 }
 
@@ -265,7 +288,7 @@ void write_field_nodes( const Metadata& gmsh_options, const functionspace::NodeC
             out << atlas::mpi::comm().rank() << "\n";
             auto data = gather ? make_level_view<DATATYPE>( field_glb, ndata, jlev )
                                : make_level_view<DATATYPE>( field, ndata, jlev );
-            write_level( out, gidx, data );
+            write_level( out, gidx, data, binary );
             out << "$EndNodeData\n";
         }
     }
@@ -320,7 +343,7 @@ void write_field_nodes( const Metadata& gmsh_options, const functionspace::Struc
         out << atlas::mpi::comm().rank() << "\n";
         auto data = gather ? make_level_view<DATATYPE>( field_glb, ndata, jlev )
                            : make_level_view<DATATYPE>( field, ndata, jlev );
-        write_level( out, gidx, data );
+        write_level( out, gidx, data, binary );
         out << "$EndNodeData\n";
     }
 }
@@ -959,7 +982,12 @@ void GmshIO::write_delegate( const FieldSet& fieldset, const functionspace::Node
     GmshFile file( file_path, mode, gather ? -1 : atlas::mpi::comm().rank() );
 
     // Header
-    if ( is_new_file ) { write_header_ascii( file ); }
+    if ( is_new_file ) {
+        if ( binary )
+            write_header_binary( file );
+        else
+            write_header_ascii( file );
+    }
 
     // field::Fields
     for ( size_t field_idx = 0; field_idx < fieldset.size(); ++field_idx ) {
@@ -998,7 +1026,12 @@ void GmshIO::write_delegate( const FieldSet& fieldset, const functionspace::Stru
     GmshFile file( file_path, mode, gather ? -1 : atlas::mpi::comm().rank() );
 
     // Header
-    if ( is_new_file ) write_header_ascii( file );
+    if ( is_new_file ) {
+        if ( binary )
+            write_header_binary( file );
+        else
+            write_header_ascii( file );
+    }
 
     // field::Fields
     for ( size_t field_idx = 0; field_idx < fieldset.size(); ++field_idx ) {
@@ -0,0 +1,445 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "eckit/exception/Exceptions.h"
+#include "eckit/filesystem/PathName.h"
+#include "eckit/parser/JSON.h"
+
+#include "atlas/array/Array.h"
+#include "atlas/array/ArrayShape.h"
+#include "atlas/array/DataType.h"
+#include "atlas/field/Field.h"
+#include "atlas/grid/Grid.h"
+#include "atlas/mesh/Connectivity.h"
+#include "atlas/mesh/ElementType.h"
+#include "atlas/mesh/HybridElements.h"
+#include "atlas/mesh/Mesh.h"
+#include "atlas/mesh/Nodes.h"
+#include "atlas/output/detail/MeshSnapshotIO.h"
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/runtime/ErrorHandling.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/util/Config.h"
+#include "atlas/util/Metadata.h"
+
+namespace atlas {
+namespace output {
+namespace detail {
+
+// ------------------------------------------------------------------
+
+namespace {
+
+const char magic[8]            = {'A', 'T', 'L', 'A', 'S', 'M', 'S', 'H'};
+constexpr int version          = 1;
+constexpr uint32_t byte_order  = 0x01020304;
+constexpr size_t alignment     = 8;
+const std::string index_format = "atlas-mesh-snapshot";
+
+std::string partition_path( const eckit::PathName& path, size_t part ) {
+    return path.asString() + "." + std::to_string( part );
+}
+
+std::string to_json( const eckit::LocalConfiguration& config ) {
+    std::stringstream s;
+    eckit::JSON json( s );
+    json.precision( 17 );
+    json << config;
+    return s.str();
+}
+
+util::Metadata from_json( const std::string& str ) {
+    std::istringstream s( str );
+    return util::Metadata( util::Config( s ) );
+}
+
+size_t value_bytes( const array::DataType& datatype ) {
+    switch ( datatype.kind() ) {
+        case array::DataType::KIND_INT32:
+        case array::DataType::KIND_REAL32:
+            return 4;
+        case array::DataType::KIND_INT64:
+        case array::DataType::KIND_REAL64:
+        case array::DataType::KIND_UINT64:
+            return 8;
+        default:
+            throw eckit::BadValue( "Cannot store field with datatype " + datatype.str(), Here() );
+    }
+}
+
+const mesh::ElementType* create_element_type( const std::string& name ) {
+    if ( name == "Quadrilateral" ) return new mesh::temporary::Quadrilateral();
+    if ( name == "Triangle" ) return new mesh::temporary::Triangle();
+    if ( name == "Line" ) return new mesh::temporary::Line();
+    throw eckit::BadValue( "Cannot create element type " + name, Here() );
+}
+
+// ------------------------------------------------------------------
+
+/// Sequential binary output, keeping track of the offset for alignment of bulk data
+class Writer {
+public:
+    Writer( const std::string& path ) : path_( path ), out_( path.c_str(), std::ios::binary ) {
+        if ( !out_.is_open() ) throw eckit::CantOpenFile( path );
+    }
+
+    template <typename T>
+    void write_value( const T& value ) {
+        write_bytes( &value, sizeof( T ) );
+    }
+
+    void write_string( const std::string& str ) {
+        write_value<uint64_t>( str.size() );
+        write_bytes( str.data(), str.size() );
+    }
+
+    void write_bytes( const void* data, size_t bytes ) {
+        out_.write( static_cast<const char*>( data ), bytes );
+        offset_ += bytes;
+    }
+
+    /// Pad with zeros so that the next bulk data is aligned in the memory-mapped file
+    void align() {
+        static const char zeros[alignment] = {};
+        write_bytes( zeros, ( alignment - offset_ % alignment ) % alignment );
+    }
+
+    void close() {
+        out_.close();
+        if ( out_.fail() ) throw eckit::WriteError( path_ );
+    }
+
+private:
+    std::string path_;
+    std::ofstream out_;
+    size_t offset_{0};
+};
+
+/// Read-only memory mapping of a complete file
+class MappedFile {
+public:
+    MappedFile( const std::string& path ) : path_( path ) {
+        int fd = ::open( path.c_str(), O_RDONLY );
+        if ( fd < 0 ) throw eckit::CantOpenFile( path );
+        struct stat st;
+        if ( ::fstat( fd, &st ) != 0 ) {
+            ::close( fd );
+            throw eckit::FailedSystemCall( "fstat " + path );
+        }
+        size_ = st.st_size;
+        if ( size_ > 0 ) {
+            void* data = ::mmap( nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0 );
+            if ( data == MAP_FAILED ) {
+                ::close( fd );
+                throw eckit::FailedSystemCall( "mmap " + path );
+            }
+            data_ = static_cast<char*>( data );
+        }
+        ::close( fd );
+    }
+
+    ~MappedFile() {
+        if ( data_ ) ::munmap( data_, size_ );
+    }
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    const std::string& path() const { return path_; }
+
+private:
+    std::string path_;
+    char* data_{nullptr};
+    size_t size_{0};
+};
+
+/// Sequential access to a MappedFile, mirroring Writer
+class Reader {
+public:
+    Reader( const MappedFile& file ) : file_( file ) {}
+
+    template <typename T>
+    T read_value() {
+        T value;
+        std::memcpy( &value, read_bytes( sizeof( T ) ), sizeof( T ) );
+        return value;
+    }
+
+    std::string read_string() {
+        size_t size = read_value<uint64_t>();
+        return std::string( read_bytes( size ), size );
+    }
+
+    const char* read_bytes( size_t bytes ) {
+        if ( offset_ + bytes > file_.size() ) {
+            throw eckit::ReadError( "Unexpected end of mesh snapshot " + file_.path() );
+        }
+        const char* data = file_.data() + offset_;
+        offset_ += bytes;
+        return data;
+    }
+
+    void align() { offset_ += ( alignment - offset_ % alignment ) % alignment; }
+
+private:
+    const MappedFile& file_;
+    size_t offset_{0};
+};
+
+// ------------------------------------------------------------------
+
+void write_field( Writer& out, const Field& field ) {
+    ASSERT( field.array().contiguous() );
+    out.write_string( field.name() );
+    out.write_value<int64_t>( field.datatype().kind() );
+    out.write_value<uint64_t>( field.rank() );
+    for ( size_t n : field.shape() ) {
+        out.write_value<uint64_t>( n );
+    }
+    out.write_string( to_json( field.metadata() ) );
+    out.align();
+    out.write_bytes( field.array().storage(), field.size() * value_bytes( field.datatype() ) );
+}
+
+/// Read a field into the Nodes or HybridElements, adding it when not already present
+template <typename FieldContainer>
+void read_field( Reader& in, FieldContainer& container ) {
+    std::string name = in.read_string();
+    array::DataType datatype( in.read_value<int64_t>() );
+    std::vector<size_t> shape( in.read_value<uint64_t>() );
+    for ( size_t& n : shape ) {
+        n = in.read_value<uint64_t>();
+    }
+    util::Metadata metadata = from_json( in.read_string() );
+    in.align();
+
+    if ( not container.has_field( name ) ) {
+        container.add( Field( name, datatype, array::ArrayShape( std::vector<size_t>( shape ) ) ) );
+    }
+    Field field = container.field( name );
+    if ( field.datatype().kind() != datatype.kind() || field.shape() != shape ) {
+        throw eckit::BadValue( "Field \"" + name + "\" in mesh snapshot does not match the mesh", Here() );
+    }
+    size_t bytes = field.size() * value_bytes( datatype );
+    std::memcpy( field.array().storage(), in.read_bytes( bytes ), bytes );
+    field.metadata() = metadata;
+}
+
+// Connectivities are stored with base 0, so that snapshots do not depend on ATLAS_HAVE_FORTRAN
+void write_block( Writer& out, const mesh::BlockConnectivity& block ) {
+    std::vector<idx_t> values( block.rows() * block.cols() );
+    for ( size_t jrow = 0, j = 0; jrow < block.rows(); ++jrow ) {
+        for ( size_t jcol = 0; jcol < block.cols(); ++jcol ) {
+            values[j++] = block( jrow, jcol );
+        }
+    }
+    out.write_value<uint64_t>( block.rows() );
+    out.write_value<uint64_t>( block.cols() );
+    out.align();
+    out.write_bytes( values.data(), values.size() * sizeof( idx_t ) );
+}
+
+const idx_t* read_block( Reader& in, size_t& rows, size_t& cols ) {
+    rows = in.read_value<uint64_t>();
+    cols = in.read_value<uint64_t>();
+    in.align();
+    return reinterpret_cast<const idx_t*>( in.read_bytes( rows * cols * sizeof( idx_t ) ) );
+}
+
+void write_elements( Writer& out, const mesh::HybridElements& elements ) {
+    out.write_value<uint64_t>( elements.size() );
+
+    out.write_value<uint64_t>( elements.nb_types() );
+    for ( size_t jtype = 0; jtype < elements.nb_types(); ++jtype ) {
+        out.write_string( elements.element_type( jtype ).name() );
+        write_block( out, elements.node_connectivity().block( jtype ) );
+    }
+
+    for ( const mesh::HybridElements::Connectivity* connectivity :
+          {&elements.edge_connectivity(), &elements.cell_connectivity()} ) {
+        out.write_value<uint64_t>( connectivity->blocks() );
+        for ( size_t jblock = 0; jblock < connectivity->blocks(); ++jblock ) {
+            write_block( out, connectivity->block( jblock ) );
+        }
+    }
+
+    out.write_string( to_json( elements.metadata() ) );
+    out.write_value<uint64_t>( elements.nb_fields() );
+    for ( size_t jfield = 0; jfield < elements.nb_fields(); ++jfield ) {
+        write_field( out, elements.field( jfield ) );
+    }
+}
+
+void read_elements( Reader& in, mesh::HybridElements& elements ) {
+    size_t size = in.read_value<uint64_t>();
+    size_t rows, cols;
+
+    size_t nb_types = in.read_value<uint64_t>();
+    for ( size_t jtype = 0; jtype < nb_types; ++jtype ) {
+        const mesh::ElementType* type = create_element_type( in.read_string() );
+        const idx_t* values           = read_block( in, rows, cols );
+        elements.add( type, rows, values );
+        ASSERT( elements.element_type( jtype ).nb_nodes() == cols );
+    }
+    ASSERT( elements.size() == size );
+
+    for ( mesh::HybridElements::Connectivity* connectivity :
+          {&elements.edge_connectivity(), &elements.cell_connectivity()} ) {
+        size_t nb_blocks = in.read_value<uint64_t>();
+        for ( size_t jblock = 0; jblock < nb_blocks; ++jblock ) {
+            const idx_t* values = read_block( in, rows, cols );
+            connectivity->add( rows, cols, values );
+        }
+    }
+
+    elements.metadata() = from_json( in.read_string() );
+    size_t nb_fields    = in.read_value<uint64_t>();
+    for ( size_t jfield = 0; jfield < nb_fields; ++jfield ) {
+        read_field( in, elements );
+    }
+}
+
+void write_nodes( Writer& out, const mesh::Nodes& nodes ) {
+    out.write_value<uint64_t>( nodes.size() );
+    out.write_string( to_json( nodes.metadata() ) );
+    out.write_value<uint64_t>( nodes.nb_fields() );
+    for ( size_t jfield = 0; jfield < nodes.nb_fields(); ++jfield ) {
+        write_field( out, nodes.field( jfield ) );
+    }
+}
+
+void read_nodes( Reader& in, mesh::Nodes& nodes ) {
+    nodes.resize( in.read_value<uint64_t>() );
+    nodes.metadata() = from_json( in.read_string() );
+    size_t nb_fields = in.read_value<uint64_t>();
+    for ( size_t jfield = 0; jfield < nb_fields; ++jfield ) {
+        read_field( in, nodes );
+    }
+}
+
+util::Config read_index( const eckit::PathName& path, size_t& nb_parts ) {
+    if ( not path.exists() ) throw eckit::CantOpenFile( path.asString() );
+    util::Config index( path );
+    std::string format;
+    if ( not index.get( "format", format ) || format != index_format || not index.get( "nb_parts", nb_parts ) ) {
+        throw eckit::BadValue( path.asString() + " is not a mesh snapshot index", Here() );
+    }
+    return index;
+}
+
+}  // namespace
+
+// ------------------------------------------------------------------
+
+void MeshSnapshotIO::write( const eckit::PathName& path, const Mesh& mesh ) {
+    write( path, mesh, mpi::comm().rank(), mpi::comm().size() );
+}
+
+void MeshSnapshotIO::write( const eckit::PathName& path, const Mesh& mesh, size_t part, size_t nb_parts ) {
+    ATLAS_TRACE( "MeshSnapshotIO::write" );
+    ASSERT( part < nb_parts );
+
+    if ( part == 0 ) {
+        util::Config index;
+        index.set( "format", index_format );
+        index.set( "version", version );
+        index.set( "nb_parts", nb_parts );
+        index.set( "grid", mesh.grid().spec() );
+        std::ofstream out( path.asString().c_str() );
+        if ( !out.is_open() ) throw eckit::CantOpenFile( path.asString() );
+        out << to_json( index ) << std::endl;
+    }
+
+    Writer out( partition_path( path, part ) );
+    out.write_bytes( magic, sizeof( magic ) );
+    out.write_value<uint32_t>( version );
+    out.write_value<uint32_t>( byte_order );
+    out.write_value<uint32_t>( sizeof( idx_t ) );
+    out.write_value<uint32_t>( sizeof( gidx_t ) );
+    out.write_value<uint64_t>( part );
+    out.write_value<uint64_t>( nb_parts );
+    out.write_string( to_json( mesh.metadata() ) );
+    write_nodes( out, mesh.nodes() );
+    write_elements( out, mesh.cells() );
+    write_elements( out, mesh.edges() );
+    out.close();
+}
+
+Mesh MeshSnapshotIO::read( const eckit::PathName& path ) {
+    size_t nb_parts = MeshSnapshotIO::nb_parts( path );
+    if ( nb_parts != mpi::comm().size() ) {
+        std::stringstream msg;
+        msg << "Mesh snapshot " << path << " has " << nb_parts << " partitions, but running with "
+            << mpi::comm().size() << " MPI tasks";
+        throw eckit::BadValue( msg.str(), Here() );
+    }
+    return read( path, mpi::comm().rank() );
+}
+
+Mesh MeshSnapshotIO::read( const eckit::PathName& path, size_t part ) {
+    ATLAS_TRACE( "MeshSnapshotIO::read" );
+    size_t nb_parts;
+    util::Config index = read_index( path, nb_parts );
+    ASSERT( part < nb_parts );
+
+    MappedFile file( partition_path( path, part ) );
+    Reader in( file );
+
+    if ( std::memcmp( in.read_bytes( sizeof( magic ) ), magic, sizeof( magic ) ) != 0 ) {
+        throw eckit::BadValue( file.path() + " is not a mesh snapshot", Here() );
+    }
+    if ( in.read_value<uint32_t>() != version ) {
+        throw eckit::BadValue( "Unsupported version of mesh snapshot " + file.path(), Here() );
+    }
+    if ( in.read_value<uint32_t>() != byte_order ) {
+        throw eckit::BadValue( "Mesh snapshot " + file.path() + " was written with a different byte order", Here() );
+    }
+    if ( in.read_value<uint32_t>() != sizeof( idx_t ) || in.read_value<uint32_t>() != sizeof( gidx_t ) ) {
+        throw eckit::BadValue( "Mesh snapshot " + file.path() + " was written with different index types", Here() );
+    }
+    ASSERT( in.read_value<uint64_t>() == part );
+    ASSERT( in.read_value<uint64_t>() == nb_parts );
+
+    Mesh mesh;
+    mesh.metadata() = from_json( in.read_string() );
+    read_nodes( in, mesh.nodes() );
+    read_elements( in, mesh.cells() );
+    read_elements( in, mesh.edges() );
+
+    util::Config grid;
+    if ( index.get( "grid", grid ) ) { mesh.setGrid( Grid( grid ) ); }
+    return mesh;
+}
+
+size_t MeshSnapshotIO::nb_parts( const eckit::PathName& path ) {
+    size_t nb_parts;
+    read_index( path, nb_parts );
+    return nb_parts;
+}
+
+// ------------------------------------------------------------------
+
+}  // namespace detail
+}  // namespace output
+}  // namespace atlas
@@ -0,0 +1,75 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+// forward declarations
+namespace eckit {
+class PathName;
+}
+
+namespace atlas {
+class Mesh;
+}
+
+namespace atlas {
+namespace output {
+namespace detail {
+
+/**
+ * @brief MeshSnapshotIO writes and reads a partitioned Mesh as binary snapshot
+ *
+ * A snapshot consists of a small JSON index file "<path>", containing the number of partitions
+ * and the grid specification, and one binary file "<path>.<part>" per partition.
+ * Each partition file contains the metadata of the mesh, all fields of the nodes, and for the
+ * cells and edges their element types, node/edge/cell connectivities, fields and metadata.
+ * Parallel fields and halos that were built before writing are therefore restored by read(),
+ * without running a MeshGenerator, BuildParallelFields or BuildHalo.
+ *
+ * Partition files are written in native byte order, and are memory-mapped when read.
+ * Connectivities of nodes to elements are not stored. Callers that need them must build them again after
+ * read(), e.g. with mesh::actions::build_node_to_edge_connectivity().
+ *
+ * @note The mesh must have been created by a MeshGenerator, as the grid is stored in the index.
+ */
+class MeshSnapshotIO {
+public:
+    /**
+     * @brief Write partition of this MPI task to "<path>.<rank>", and the index "<path>" from task 0
+     */
+    static void write( const eckit::PathName& path, const Mesh& mesh );
+
+    /**
+     * @brief Write given partition out of nb_parts to "<path>.<part>", and the index "<path>" for part 0
+     */
+    static void write( const eckit::PathName& path, const Mesh& mesh, size_t part, size_t nb_parts );
+
+    /**
+     * @brief Read partition of this MPI task
+     * @note The number of partitions in the snapshot must equal the number of MPI tasks
+     */
+    static Mesh read( const eckit::PathName& path );
+
+    /**
+     * @brief Read given partition
+     */
+    static Mesh read( const eckit::PathName& path, size_t part );
+
+    /**
+     * @brief Number of partitions in the snapshot with given index
+     */
+    static size_t nb_parts( const eckit::PathName& path );
+};
+
+}  // namespace detail
+}  // namespace output
+}  // namespace atlas
@@ -25,23 +25,25 @@ Checksum::Checksum( const std::string& name ) : name_( name ) {
 
 void Checksum::setup( const int part[], const int remote_idx[], const int base, const gidx_t glb_idx[],
                       const int parsize ) {
-    parsize_ = parsize;
-    gather_.reset( new GatherScatter() );
-    gather_->setup( part, remote_idx, base, glb_idx, parsize );
-    is_setup_ = true;
+    const int mypart = mpi::comm().rank();
+    std::vector<int> mask( parsize );
+    for ( int n = 0; n < parsize; ++n ) {
+        mask[n] = ( part[n] != mypart || remote_idx[n] != base + n ) ? 1 : 0;
+    }
+    setup( part, remote_idx, base, glb_idx, mask.data(), parsize );
 }
 
 void Checksum::setup( const int part[], const int remote_idx[], const int base, const gidx_t glb_idx[],
                       const int mask[], const int parsize ) {
     parsize_ = parsize;
-    gather_.reset( new GatherScatter() );
-    gather_->setup( part, remote_idx, base, glb_idx, mask, parsize );
-    is_setup_ = true;
-}
-
-void Checksum::setup( const eckit::SharedPtr<GatherScatter>& gather ) {
-    gather_   = gather;
-    parsize_  = gather->parsize_;
+    points_.clear();
+    glb_idx_.clear();
+    for ( int n = 0; n < parsize; ++n ) {
+        if ( !mask[n] ) {
+            points_.push_back( n );
+            glb_idx_.push_back( glb_idx[n] );
+        }
+    }
     is_setup_ = true;
 }
 
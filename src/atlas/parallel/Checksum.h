@@ -17,8 +17,10 @@
 #include "eckit/utils/Translator.h"
 
 #include "atlas/array/ArrayView.h"
-#include "atlas/parallel/GatherScatter.h"
+#include "atlas/library/config.h"
+#include "atlas/parallel/mpi/Statistics.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/util/Checksum.h"
 
@@ -38,30 +40,36 @@ public:  // methods
     std::string name() const { return name_; }
 
     /// @brief Setup
+    ///
+    /// Points owned by this partition (part[n] == rank and remote_idx[n] == base + n) are included.
+    /// No communication is involved.
     /// @param [in] part         List of partitions
     /// @param [in] remote_idx   List of local indices on remote partitions
     /// @param [in] base         values of remote_idx start at "base"
     /// @param [in] glb_idx      List of global indices
-    /// @param [in] max_glb_idx  maximum glb index we want to Checksum.
-    ///                          To Checksum everything, set to val > max value in
-    ///                          domain
     /// @param [in] parsize      size of given lists
     void setup( const int part[], const int remote_idx[], const int base, const gidx_t glb_idx[], const int parsize );
 
     /// @brief Setup
+    ///
+    /// Unmasked points are included. Each global index must be unmasked on exactly one partition,
+    /// as is the case for a mask created with mesh::IsGhostNode.
+    /// No communication is involved.
     /// @param [in] part         List of partitions
     /// @param [in] remote_idx   List of local indices on remote partitions
     /// @param [in] base         values of remote_idx start at "base"
     /// @param [in] glb_idx      List of global indices
-    /// @param [in] mask         Mask indices not to include in the communication
-    ///                          pattern (0=include,1=exclude)
+    /// @param [in] mask         Mask indices not to include in the checksum
+    ///                          (0=include,1=exclude)
     /// @param [in] parsize      size of given lists
     void setup( const int part[], const int remote_idx[], const int base, const gidx_t glb_idx[], const int mask[],
                 const int parsize );
 
-    /// @brief Setup
-    void setup( const eckit::SharedPtr<GatherScatter>& );
-
+    /// @brief Checksum of a distributed field, independent of partitioning
+    ///
+    /// Each value of each included point is hashed together with the point's global index
+    /// (see util::hash), and the hashes are summed modulo 2^64, locally and then over all tasks
+    /// with a single allReduce. The result is the same on all tasks.
     template <typename DATA_TYPE>
     std::string execute( const DATA_TYPE lfield[], const int lvar_strides[], const int lvar_extents[],
                          const int lvar_rank ) const;
@@ -78,7 +86,8 @@ public:  // methods
 
 private:  // data
     std::string name_;
-    eckit::SharedPtr<GatherScatter> gather_;
+    std::vector<int> points_;      ///< local indices of points included in the checksum
+    std::vector<gidx_t> glb_idx_;  ///< global indices of points_
     bool is_setup_;
     size_t parsize_;
 };
@@ -86,24 +95,18 @@ private:  // data
 template <typename DATA_TYPE>
 std::string Checksum::execute( const DATA_TYPE data[], const int var_strides[], const int var_extents[],
                                const int var_rank ) const {
-    size_t root = 0;
-
     if ( !is_setup_ ) { throw eckit::SeriousBug( "Checksum was not setup", Here() ); }
-    std::vector<util::checksum_t> local_checksums( parsize_ );
-    int var_size = var_extents[0] * var_strides[0];
+    const size_t var_size = var_extents[0] * var_strides[0];
+    const size_t npts     = points_.size();
 
-    for ( size_t pp = 0; pp < parsize_; ++pp ) {
-        local_checksums[pp] = util::checksum( data + pp * var_size, var_size );
+    util::checksum_t local_checksum = 0;
+    atlas_omp_pragma( omp parallel for default(shared) reduction(+:local_checksum) )
+    for ( size_t jj = 0; jj < npts; ++jj ) {
+        local_checksum += util::hash( glb_idx_[jj], data + size_t( points_[jj] ) * var_size, var_size );
     }
 
-    std::vector<util::checksum_t> global_checksums( mpi::comm().rank() == root ? gather_->glb_dof() : 0 );
-    parallel::Field<util::checksum_t const> loc( local_checksums.data(), 1 );
-    parallel::Field<util::checksum_t> glb( global_checksums.data(), 1 );
-    gather_->gather( &loc, &glb, 1 );
-
-    util::checksum_t glb_checksum = util::checksum( global_checksums.data(), global_checksums.size() );
-
-    mpi::comm().broadcast( glb_checksum, root );
+    util::checksum_t glb_checksum;
+    ATLAS_TRACE_MPI( ALLREDUCE ) { mpi::comm().allReduce( local_checksum, glb_checksum, eckit::mpi::sum() ); }
 
     return eckit::Translator<util::checksum_t, std::string>()( glb_checksum );
 }
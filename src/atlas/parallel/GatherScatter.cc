@@ -8,6 +8,7 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <numeric>
 #include <sstream>
@@ -79,6 +80,10 @@ void GatherScatter::setup( const int part[], const int remote_idx[], const int b
                            const int mask[], const size_t parsize ) {
     ATLAS_TRACE( "GatherScatter::setup" );
 
+    // Only the root receives and sorts the global indices, and keeps the global map.
+    // Other ranks only keep which of their local indices to send, see locmap_.
+    const size_t root = 0;
+
     parsize_ = parsize;
 
     glbcounts_.resize( nproc );
@@ -89,54 +94,77 @@ void GatherScatter::setup( const int part[], const int remote_idx[], const int b
 
     std::vector<gidx_t> sendnodes( parsize_ * nvar );
 
-    loccnt_ = 0;
+    int nb_send = 0;
     for ( size_t n = 0; n < parsize_; ++n ) {
         if ( !mask[n] ) {
-            sendnodes[loccnt_++] = glb_idx[n];
-            sendnodes[loccnt_++] = part[n];
-            sendnodes[loccnt_++] = remote_idx[n] - base;
+            sendnodes[nb_send++] = glb_idx[n];
+            sendnodes[nb_send++] = part[n];
+            sendnodes[nb_send++] = remote_idx[n] - base;
         }
     }
 
-    ATLAS_TRACE_MPI( ALLGATHER ) { mpi::comm().allGather( loccnt_, glbcounts_.begin(), glbcounts_.end() ); }
-
-    glbcnt_ = std::accumulate( glbcounts_.begin(), glbcounts_.end(), 0 );
+    std::vector<int> recvcounts( nproc );
+    std::vector<int> recvdispls( nproc );
+    ATLAS_TRACE_MPI( GATHER ) { mpi::comm().gather( nb_send, recvcounts, root ); }
 
-    glbdispls_[0] = 0;
-    for ( size_t jproc = 1; jproc < nproc; ++jproc )  // start at 1
-    {
-        glbdispls_[jproc] = glbcounts_[jproc - 1] + glbdispls_[jproc - 1];
+    std::vector<int> locmaps;
+    glbmap_.clear();
+    if ( myproc == root ) {
+        recvdispls[0] = 0;
+        for ( size_t jproc = 1; jproc < nproc; ++jproc )  // start at 1
+        {
+            recvdispls[jproc] = recvcounts[jproc - 1] + recvdispls[jproc - 1];
+        }
     }
-    std::vector<gidx_t> recvnodes( glbcnt_ );
+    std::vector<gidx_t> recvnodes( myproc == root ? std::accumulate( recvcounts.begin(), recvcounts.end(), 0 ) : 0 );
 
-    ATLAS_TRACE_MPI( ALLGATHER ) {
-        mpi::comm().allGatherv( sendnodes.begin(), sendnodes.begin() + loccnt_, recvnodes.data(), glbcounts_.data(),
-                                glbdispls_.data() );
+    ATLAS_TRACE_MPI( GATHER ) {
+        mpi::comm().gatherv( sendnodes.data(), nb_send, recvnodes.data(), recvcounts.data(), recvdispls.data(),
+                             root );
     }
+    sendnodes.clear();
+
+    if ( myproc == root ) {
+        // Load recvnodes in sorting structure
+        size_t nb_recv_nodes = recvnodes.size() / nvar;
+        std::vector<Node> node_sort( nb_recv_nodes );
+        for ( size_t n = 0; n < nb_recv_nodes; ++n ) {
+            node_sort[n].g = recvnodes[n * nvar + 0];
+            node_sort[n].p = recvnodes[n * nvar + 1];
+            node_sort[n].i = recvnodes[n * nvar + 2];
+        }
 
-    // Load recvnodes in sorting structure
-    size_t nb_recv_nodes = glbcnt_ / nvar;
-    std::vector<Node> node_sort( nb_recv_nodes );
-    for ( size_t n = 0; n < nb_recv_nodes; ++n ) {
-        node_sort[n].g = recvnodes[n * nvar + 0];
-        node_sort[n].p = recvnodes[n * nvar + 1];
-        node_sort[n].i = recvnodes[n * nvar + 2];
-    }
+        recvnodes.clear();
 
-    recvnodes.clear();
+        // Sort on "g" member, and remove duplicates
+        ATLAS_TRACE_SCOPE( "sorting" ) {
+            std::sort( node_sort.begin(), node_sort.end() );
+            node_sort.erase( std::unique( node_sort.begin(), node_sort.end() ), node_sort.end() );
+        }
+        for ( size_t n = 0; n < node_sort.size(); ++n ) {
+            ++glbcounts_[node_sort[n].p];
+        }
+        glbdispls_[0] = 0;
+        for ( size_t jproc = 1; jproc < nproc; ++jproc )  // start at 1
+        {
+            glbdispls_[jproc] = glbcounts_[jproc - 1] + glbdispls_[jproc - 1];
+        }
 
-    // Sort on "g" member, and remove duplicates
-    ATLAS_TRACE_SCOPE( "sorting" ) {
-        std::sort( node_sort.begin(), node_sort.end() );
-        node_sort.erase( std::unique( node_sort.begin(), node_sort.end() ), node_sort.end() );
-    }
-    glbcounts_.assign( nproc, 0 );
-    glbdispls_.assign( nproc, 0 );
-    for ( size_t n = 0; n < node_sort.size(); ++n ) {
-        ++glbcounts_[node_sort[n].p];
+        // glbmap_ on root, and the local indices each rank has to send, ordered per rank
+        glbmap_.resize( node_sort.size() );
+        locmaps.resize( node_sort.size() );
+        std::vector<int> idx( nproc, 0 );
+        for ( size_t n = 0; n < node_sort.size(); ++n ) {
+            size_t jproc                            = node_sort[n].p;
+            glbmap_[glbdispls_[jproc] + idx[jproc]] = n;
+            locmaps[glbdispls_[jproc] + idx[jproc]] = node_sort[n].i;
+            ++idx[jproc];
+        }
     }
-    glbdispls_[0] = 0;
 
+    ATLAS_TRACE_MPI( BROADCAST ) { mpi::comm().broadcast( glbcounts_, root ); }
+
+    glbdispls_[0] = 0;
     for ( size_t jproc = 1; jproc < nproc; ++jproc )  // start at 1
     {
         glbdispls_[jproc] = glbcounts_[jproc - 1] + glbdispls_[jproc - 1];
@@ -144,23 +172,36 @@ void GatherScatter::setup( const int part[], const int remote_idx[], const int b
     glbcnt_ = std::accumulate( glbcounts_.begin(), glbcounts_.end(), 0 );
     loccnt_ = glbcounts_[myproc];
 
-    glbmap_.clear();
-    glbmap_.resize( glbcnt_ );
     locmap_.clear();
     locmap_.resize( loccnt_ );
-    std::vector<int> idx( nproc, 0 );
-    for ( size_t n = 0; n < node_sort.size(); ++n ) {
-        size_t jproc                            = node_sort[n].p;
-        glbmap_[glbdispls_[jproc] + idx[jproc]] = n;
-
-        if ( jproc == myproc ) locmap_[idx[jproc]] = node_sort[n].i;
-
-        ++idx[jproc];
+    ATLAS_TRACE_MPI( SCATTER ) {
+        mpi::comm().scatterv( locmaps.data(), glbcounts_.data(), glbdispls_.data(), locmap_.data(), loccnt_, root );
     }
 
+    has_glbmap_.assign( nproc, false );
+    has_glbmap_[root] = true;
+    glbmap_root_      = root;
+
     is_setup_ = true;
 }
 
+void GatherScatter::require_glbmap( const size_t root ) const {
+    if ( has_glbmap_[root] ) { return; }
+
+    // All ranks know which roots have the map, so this point-to-point transfer happens only on
+    // the first gather or scatter with a new root
+    ATLAS_TRACE( "GatherScatter::require_glbmap" );
+    const int tag = 0;
+    ATLAS_TRACE_MPI( SENDRECEIVE ) {
+        if ( myproc == glbmap_root_ ) { mpi::comm().send( glbmap_.data(), glbmap_.size(), root, tag ); }
+        if ( myproc == root ) {
+            glbmap_.resize( glbcnt_ );
+            mpi::comm().receive( glbmap_.data(), glbmap_.size(), glbmap_root_, tag );
+        }
+    }
+    has_glbmap_[root] = true;
+}
+
 void GatherScatter::setup( const int part[], const int remote_idx[], const int base, const gidx_t glb_idx[],
                            const size_t parsize ) {
     std::vector<int> mask( parsize );
@@ -171,6 +212,12 @@ void GatherScatter::setup( const int part[], const int remote_idx[], const int b
     setup( part, remote_idx, base, glb_idx, mask.data(), parsize );
 }
 
+size_t io_rank( size_t jfield, size_t nb_io_ranks ) {
+    const size_t nproc = mpi::comm().size();
+    nb_io_ranks        = std::max<size_t>( 1, std::min( nb_io_ranks, nproc ) );
+    return ( jfield % nb_io_ranks ) * ( nproc / nb_io_ranks );
+}
+
 /////////////////////
 
 GatherScatter* atlas__GatherScatter__new() {
@@ -16,6 +16,7 @@
 #include "eckit/memory/Owned.h"
 #include "eckit/memory/SharedPtr.h"
 
+#include "atlas/array/Allocator.h"
 #include "atlas/array/ArrayView.h"
 #include "atlas/library/config.h"
 #include "atlas/parallel/mpi/mpi.h"
@@ -164,6 +165,16 @@ public:  // methods
     void gather( const array::ArrayView<DATA_TYPE, LRANK>& ldata, array::ArrayView<DATA_TYPE, GRANK>& gdata,
                  const size_t root = 0 ) const;
 
+    /// @brief Gather fields, each to its own root
+    ///
+    /// All fields are gathered concurrently with non-blocking communication. Spreading the roots
+    /// over several (I/O) ranks, e.g. with io_rank(), spreads the memory and work of handling
+    /// the global fields, instead of serialising on a single rank.
+    /// @param [in] roots        Root of each field, of size nb_fields
+    template <typename DATA_TYPE>
+    void gather( parallel::Field<DATA_TYPE const> lfields[], parallel::Field<DATA_TYPE> gfields[],
+                 const size_t nb_fields, const std::vector<size_t>& roots ) const;
+
     template <typename DATA_TYPE>
     void scatter( parallel::Field<DATA_TYPE const> gfields[], parallel::Field<DATA_TYPE> lfields[],
                   const size_t nb_fields, const size_t root = 0 ) const;
@@ -200,6 +211,9 @@ private:  // methods
     void var_info( const array::ArrayView<DATA_TYPE, RANK>& arr, std::vector<size_t>& varstrides,
                    std::vector<size_t>& varshape ) const;
 
+    /// Make sure the global map is present on given root (collective)
+    void require_glbmap( const size_t root ) const;
+
 private:  // data
     std::string name_;
     int loccnt_;
@@ -207,7 +221,11 @@ private:  // data
     std::vector<int> glbcounts_;
     std::vector<int> glbdispls_;
     std::vector<int> locmap_;
-    std::vector<int> glbmap_;
+
+    // Global map, only present on the ranks that have been root of a gather or scatter
+    mutable std::vector<int> glbmap_;
+    mutable std::vector<bool> has_glbmap_;
+    size_t glbmap_root_;
 
     size_t nproc;
     size_t myproc;
@@ -215,17 +233,21 @@ private:  // data
     bool is_setup_;
 
     size_t parsize_;
-    friend class Checksum;
 
     int glb_cnt( size_t root ) const { return myproc == root ? glbcnt_ : 0; }
 };
 
+/// @brief Rank that gathers field number jfield, when output of many fields is spread evenly over
+/// nb_io_ranks ranks of the communicator
+size_t io_rank( size_t jfield, size_t nb_io_ranks );
+
 ////////////////////////////////////////////////////////////////////////////////
 
 template <typename DATA_TYPE>
 void GatherScatter::gather( parallel::Field<DATA_TYPE const> lfields[], parallel::Field<DATA_TYPE> gfields[],
                             size_t nb_fields, const size_t root ) const {
     if ( !is_setup_ ) { throw eckit::SeriousBug( "GatherScatter was not setup", Here() ); }
+    require_glbmap( root );
 
     for ( size_t jfield = 0; jfield < nb_fields; ++jfield ) {
         const size_t lvar_size = std::accumulate( lfields[jfield].var_shape.data(),
@@ -236,8 +258,9 @@ void GatherScatter::gather( parallel::Field<DATA_TYPE const> lfields[], parallel
                                                   std::multiplies<size_t>() );
         const int loc_size     = loccnt_ * lvar_size;
         const int glb_size     = glb_cnt( root ) * gvar_size;
-        std::vector<DATA_TYPE> loc_buffer( loc_size );
-        std::vector<DATA_TYPE> glb_buffer( glb_size );
+        array::Arena arena;
+        DATA_TYPE* loc_buffer = arena.allocate<DATA_TYPE>( loc_size );
+        DATA_TYPE* glb_buffer = arena.allocate<DATA_TYPE>( glb_size );
         std::vector<int> glb_displs( nproc );
         std::vector<int> glb_counts( nproc );
 
@@ -248,14 +271,74 @@ void GatherScatter::gather( parallel::Field<DATA_TYPE const> lfields[], parallel
 
         /// Pack
 
-        pack_send_buffer( lfields[jfield], locmap_, loc_buffer.data() );
+        pack_send_buffer( lfields[jfield], locmap_, loc_buffer );
 
         /// Gather
 
-        ATLAS_TRACE_MPI( GATHER ) { mpi::comm().gatherv( loc_buffer, glb_buffer, glb_counts, glb_displs, root ); }
+        ATLAS_TRACE_MPI( GATHER ) {
+            mpi::comm().gatherv( loc_buffer, loc_size, glb_buffer, glb_counts.data(), glb_displs.data(), root );
+        }
 
         /// Unpack
-        if ( myproc == root ) unpack_recv_buffer( glbmap_, glb_buffer.data(), gfields[jfield] );
+        if ( myproc == root ) unpack_recv_buffer( glbmap_, glb_buffer, gfields[jfield] );
+    }
+}
+
+template <typename DATA_TYPE>
+void GatherScatter::gather( parallel::Field<DATA_TYPE const> lfields[], parallel::Field<DATA_TYPE> gfields[],
+                            const size_t nb_fields, const std::vector<size_t>& roots ) const {
+    if ( !is_setup_ ) { throw eckit::SeriousBug( "GatherScatter was not setup", Here() ); }
+    ASSERT( roots.size() == nb_fields );
+    for ( size_t jfield = 0; jfield < nb_fields; ++jfield ) {
+        require_glbmap( roots[jfield] );
+    }
+
+    array::Arena arena;
+    std::vector<DATA_TYPE*> glb_buffers( nb_fields, nullptr );
+    std::vector<eckit::mpi::Request> requests;
+    requests.reserve( nb_fields * ( nproc + 1 ) );
+
+    /// Let MPI know what the roots like to receive
+    ATLAS_TRACE_MPI( IRECEIVE ) {
+        for ( size_t jfield = 0; jfield < nb_fields; ++jfield ) {
+            if ( myproc != roots[jfield] ) continue;
+            const size_t gvar_size = std::accumulate( gfields[jfield].var_shape.data(),
+                                                      gfields[jfield].var_shape.data() + gfields[jfield].var_rank, 1,
+                                                      std::multiplies<size_t>() );
+            glb_buffers[jfield] = arena.allocate<DATA_TYPE>( glbcnt_ * gvar_size );
+            for ( size_t jproc = 0; jproc < nproc; ++jproc ) {
+                if ( glbcounts_[jproc] > 0 ) {
+                    requests.push_back( mpi::comm().iReceive( glb_buffers[jfield] + glbdispls_[jproc] * gvar_size,
+                                                              glbcounts_[jproc] * gvar_size, jproc, jfield ) );
+                }
+            }
+        }
+    }
+
+    /// Pack and send
+    for ( size_t jfield = 0; jfield < nb_fields; ++jfield ) {
+        const size_t lvar_size = std::accumulate( lfields[jfield].var_shape.data(),
+                                                  lfields[jfield].var_shape.data() + lfields[jfield].var_rank, 1,
+                                                  std::multiplies<size_t>() );
+        const size_t loc_size  = loccnt_ * lvar_size;
+        DATA_TYPE* loc_buffer  = arena.allocate<DATA_TYPE>( loc_size );
+        pack_send_buffer( lfields[jfield], locmap_, loc_buffer );
+        if ( loc_size > 0 ) {
+            ATLAS_TRACE_MPI( ISEND ) {
+                requests.push_back( mpi::comm().iSend( loc_buffer, loc_size, roots[jfield], jfield ) );
+            }
+        }
+    }
+
+    ATLAS_TRACE_MPI( WAIT ) {
+        for ( auto& request : requests ) {
+            mpi::comm().wait( request );
+        }
+    }
+
+    /// Unpack
+    for ( size_t jfield = 0; jfield < nb_fields; ++jfield ) {
+        if ( myproc == roots[jfield] ) { unpack_recv_buffer( glbmap_, glb_buffers[jfield], gfields[jfield] ); }
     }
 }
 
@@ -272,6 +355,7 @@ template <typename DATA_TYPE>
 void GatherScatter::scatter( parallel::Field<DATA_TYPE const> gfields[], parallel::Field<DATA_TYPE> lfields[],
                              const size_t nb_fields, const size_t root ) const {
     if ( !is_setup_ ) { throw eckit::SeriousBug( "GatherScatter was not setup", Here() ); }
+    require_glbmap( root );
 
     for ( size_t jfield = 0; jfield < nb_fields; ++jfield ) {
         const int lvar_size =
@@ -282,8 +366,9 @@ void GatherScatter::scatter( parallel::Field<DATA_TYPE const> gfields[], paralle
                              gfields[jfield].var_shape.data() + gfields[jfield].var_rank, 1, std::multiplies<int>() );
         const int loc_size = loccnt_ * lvar_size;
         const int glb_size = glb_cnt( root ) * gvar_size;
-        std::vector<DATA_TYPE> loc_buffer( loc_size );
-        std::vector<DATA_TYPE> glb_buffer( glb_size );
+        array::Arena arena;
+        DATA_TYPE* loc_buffer = arena.allocate<DATA_TYPE>( loc_size );
+        DATA_TYPE* glb_buffer = arena.allocate<DATA_TYPE>( glb_size );
         std::vector<int> glb_displs( nproc );
         std::vector<int> glb_counts( nproc );
 
@@ -293,17 +378,16 @@ void GatherScatter::scatter( parallel::Field<DATA_TYPE const> gfields[], paralle
         }
 
         /// Pack
-        if ( myproc == root ) pack_send_buffer( gfields[jfield], glbmap_, glb_buffer.data() );
+        if ( myproc == root ) pack_send_buffer( gfields[jfield], glbmap_, glb_buffer );
 
         /// Scatter
 
         ATLAS_TRACE_MPI( SCATTER ) {
-            mpi::comm().scatterv( glb_buffer.begin(), glb_buffer.end(), glb_counts, glb_displs, loc_buffer.begin(),
-                                  loc_buffer.end(), root );
+            mpi::comm().scatterv( glb_buffer, glb_counts.data(), glb_displs.data(), loc_buffer, loc_size, root );
         }
 
         /// Unpack
-        unpack_recv_buffer( locmap_, loc_buffer.data(), lfields[jfield] );
+        unpack_recv_buffer( locmap_, loc_buffer, lfields[jfield] );
     }
 }
 
@@ -0,0 +1,242 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include "HardwareCounters.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "atlas/library/Library.h"
+#include "atlas/library/config.h"
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Log.h"
+
+#if ATLAS_HAVE_PERF_EVENT
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+//-----------------------------------------------------------------------------------------------------------
+
+namespace atlas {
+namespace runtime {
+namespace trace {
+
+namespace {
+
+#if ATLAS_HAVE_PERF_EVENT
+
+/// Group of perf events for the calling thread
+class PerfEventGroup {
+public:
+    PerfEventGroup() {
+        static const std::array<std::uint64_t, HardwareCounters::_COUNT_> config{
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES};
+        fd_.fill( -1 );
+        for ( size_t e = 0; e < HardwareCounters::_COUNT_; ++e ) {
+            struct perf_event_attr attr;
+            std::memset( &attr, 0, sizeof( attr ) );
+            attr.type           = PERF_TYPE_HARDWARE;
+            attr.size           = sizeof( attr );
+            attr.config         = config[e];
+            attr.disabled       = ( e == 0 );
+            attr.exclude_kernel = 1;
+            attr.exclude_hv     = 1;
+            attr.read_format =
+                PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            // pid = 0, cpu = -1 : calling thread, on any cpu
+            fd_[e] = ::syscall( __NR_perf_event_open, &attr, 0, -1, e == 0 ? -1 : fd_[0], 0 );
+            if ( fd_[e] < 0 ) {
+                close();
+                return;
+            }
+        }
+        ::ioctl( fd_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP );
+        ::ioctl( fd_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP );
+    }
+    ~PerfEventGroup() { close(); }
+
+    bool valid() const { return fd_[0] >= 0; }
+
+    enum Status
+    {
+        OK = 0,
+        FAILED,
+        NOT_SCHEDULED
+    };
+
+    /// Add counts to values. When the PMU is shared with other events (multiplexing), the counts
+    /// are extrapolated to the whole time the group was enabled.
+    Status read( HardwareCounters::Values& values ) const {
+        struct {
+            std::uint64_t nr;
+            std::uint64_t time_enabled;
+            std::uint64_t time_running;
+            std::uint64_t values[HardwareCounters::_COUNT_];
+        } data;
+        if ( ::read( fd_[0], &data, sizeof( data ) ) != sizeof( data ) ) { return FAILED; }
+        if ( data.time_running == 0 ) { return data.time_enabled == 0 ? OK : NOT_SCHEDULED; }
+        double scale = double( data.time_enabled ) / double( data.time_running );
+        for ( size_t e = 0; e < HardwareCounters::_COUNT_; ++e ) {
+            values[e] += static_cast<std::uint64_t>( scale * data.values[e] );
+        }
+        return OK;
+    }
+
+private:
+    void close() {
+        for ( size_t e = HardwareCounters::_COUNT_; e > 0; --e ) {
+            if ( fd_[e - 1] >= 0 ) { ::close( fd_[e - 1] ); }
+            fd_[e - 1] = -1;
+        }
+    }
+    std::array<int, HardwareCounters::_COUNT_> fd_;
+};
+
+#endif
+
+class HardwareCountersState {
+private:
+    HardwareCountersState() {
+#if ATLAS_HAVE_PERF_EVENT
+        enabled_ = atlas::Library::instance().traceCounters();
+#endif
+    }
+    // Read from all threads, and cleared by the first thread that fails to open or read its counters
+    std::atomic<bool> enabled_{false};
+
+#if ATLAS_HAVE_PERF_EVENT
+    std::mutex lock_;
+    std::vector<std::unique_ptr<PerfEventGroup>> groups_;  // one per thread that opened counters
+    std::atomic<size_t> team_size_{0};                     // number of OpenMP threads with counters
+
+    PerfEventGroup* open_thread() {
+        thread_local PerfEventGroup* group = nullptr;
+        thread_local bool opened           = false;
+        if ( not opened ) {
+            opened = true;
+            std::unique_ptr<PerfEventGroup> g( new PerfEventGroup() );
+            if ( g->valid() ) {
+                group = g.get();
+                std::lock_guard<std::mutex> guard( lock_ );
+                groups_.emplace_back( std::move( g ) );
+            }
+        }
+        return group;
+    }
+
+    /// Open counters on each thread of the OpenMP team, so that work in parallel regions is counted
+    bool open_team() {
+        size_t nthreads = atlas_omp_get_max_threads();
+        if ( team_size_ >= nthreads ) { return true; }
+        bool valid = true;
+        atlas_omp_parallel {
+            if ( open_thread() == nullptr ) {
+                atlas_omp_critical { valid = false; }
+            }
+        }
+        team_size_ = nthreads;
+        return valid;
+    }
+
+    void disable( const std::string& reason ) {
+        if ( enabled_.exchange( false ) ) {
+            Log::warning() << "Hardware performance counters not available (" << reason << "). Disabling counters."
+                           << std::endl;
+        }
+    }
+#endif
+
+public:
+    HardwareCountersState( HardwareCountersState const& ) = delete;
+    void operator=( HardwareCountersState const& ) = delete;
+    static HardwareCountersState& instance() {
+        static HardwareCountersState state;
+        return state;
+    }
+    operator bool() const { return enabled_; }
+
+    /// Counters summed over the threads of the OpenMP team, or of the calling thread only when
+    /// called from within a parallel region
+    bool read( HardwareCounters::Values& values ) {
+#if ATLAS_HAVE_PERF_EVENT
+        values.fill( 0 );
+        PerfEventGroup::Status status = PerfEventGroup::OK;
+        if ( atlas_omp_in_parallel() ) {
+            PerfEventGroup* group = open_thread();
+            status                = group ? group->read( values ) : PerfEventGroup::FAILED;
+        }
+        else {
+            if ( not open_team() ) { status = PerfEventGroup::FAILED; }
+            std::lock_guard<std::mutex> guard( lock_ );
+            for ( size_t g = 0; g < groups_.size() && status == PerfEventGroup::OK; ++g ) {
+                status = groups_[g]->read( values );
+            }
+        }
+        if ( status == PerfEventGroup::OK ) { return true; }
+        if ( status == PerfEventGroup::FAILED ) {
+            disable( "perf_event_open failed, check /proc/sys/kernel/perf_event_paranoid" );
+        }
+        else {
+            disable( "counters were never scheduled on the PMU, too many events in use" );
+        }
+#endif
+        return false;
+    }
+};
+
+}  // namespace
+
+constexpr double HardwareCounters::cache_line_bytes;
+
+bool HardwareCounters::enabled() {
+    return HardwareCountersState::instance();
+}
+
+const char* HardwareCounters::name( Event e ) {
+    static const char* names[_COUNT_] = {"cycles", "instructions", "llc_misses", "branch_misses"};
+    return names[e];
+}
+
+HardwareCounters::HardwareCounters() {
+    reset();
+}
+
+void HardwareCounters::start() {
+    if ( enabled() ) { running_ = HardwareCountersState::instance().read( start_ ); }
+}
+
+void HardwareCounters::stop() {
+    if ( running_ ) {
+        Values now;
+        if ( HardwareCountersState::instance().read( now ) ) {
+            for ( size_t e = 0; e < _COUNT_; ++e ) {
+                accumulated_[e] += now[e] - start_[e];
+            }
+        }
+        running_ = false;
+    }
+}
+
+void HardwareCounters::reset() {
+    accumulated_.fill( 0 );
+    start_.fill( 0 );
+}
+
+}  // namespace trace
+}  // namespace runtime
+}  // namespace atlas
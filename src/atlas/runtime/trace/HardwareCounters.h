@@ -0,0 +1,67 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace atlas {
+namespace runtime {
+namespace trace {
+
+//-----------------------------------------------------------------------------------------------------------
+
+/// @class HardwareCounters
+/// Accumulates hardware performance counters, much like StopWatch accumulates time.
+/// Counters are read with Linux perf_event_open, and are only active when enabled
+/// (ATLAS_TRACE_COUNTERS=1, or config "trace.counters"), and supported by the kernel.
+/// Counts are summed over all threads of the OpenMP team, including time spent waiting in barriers.
+/// When used within a parallel region, only the calling thread is counted.
+/// When the PMU is shared with other events, counts are extrapolated over the time the counters were
+/// enabled; when counters could not be scheduled at all, they are disabled with a warning.
+class HardwareCounters {
+public:
+    enum Event
+    {
+        CYCLES = 0,
+        INSTRUCTIONS,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        _COUNT_
+    };
+    using Values = std::array<std::uint64_t, _COUNT_>;
+
+    /// Size in bytes of memory traffic due to one last level cache miss
+    static constexpr double cache_line_bytes = 64.;
+
+public:  // static methods
+    static bool enabled();
+
+    static const char* name( Event );
+
+public:
+    HardwareCounters();
+    void start();
+    void stop();
+    void reset();
+    const Values& values() const { return accumulated_; }
+
+private:
+    Values accumulated_;
+    Values start_;
+    bool running_{false};
+};
+
+//-----------------------------------------------------------------------------------------------------------
+
+}  // namespace trace
+}  // namespace runtime
+}  // namespace atlas
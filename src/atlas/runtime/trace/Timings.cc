@@ -11,9 +11,13 @@
 
 #include "Timings.h"
 
+#include <algorithm>
 #include <cmath>
+#include <iomanip>
 #include <limits>
+#include <map>
 #include <regex>
+#include <set>
 #include <sstream>
 #include <string>
 
@@ -30,6 +34,80 @@ namespace atlas {
 namespace runtime {
 namespace trace {
 
+namespace {
+
+/// Row of a machine-readable timings report
+struct ReportRow {
+    size_t id;
+    std::string title;
+    std::string location;
+    long nest;
+    std::vector<double> values;
+};
+
+std::string json_escape( const std::string& in ) {
+    std::string out;
+    out.reserve( in.size() );
+    for ( char c : in ) {
+        if ( c == '"' || c == '\\' ) { out += '\\'; }
+        out += c;
+    }
+    return out;
+}
+
+void write_json( std::ostream& out, const std::vector<std::string>& columns, const std::vector<ReportRow>& rows,
+                 const std::string& mode ) {
+    out << "{\n  \"mode\" : \"" << mode << "\",\n  \"timers\" : [";
+    for ( size_t r = 0; r < rows.size(); ++r ) {
+        const auto& row = rows[r];
+        out << ( r ? "," : "" ) << "\n    {\"id\" : " << row.id << ", \"title\" : \"" << json_escape( row.title )
+            << "\", \"nest\" : " << row.nest << ", \"location\" : \"" << json_escape( row.location ) << "\"";
+        for ( size_t c = 0; c < columns.size(); ++c ) {
+            out << ", \"" << columns[c] << "\" : " << std::setprecision( 10 ) << row.values[c];
+        }
+        out << "}";
+    }
+    out << "\n  ]\n}" << std::endl;
+}
+
+void write_csv( std::ostream& out, const std::vector<std::string>& columns, const std::vector<ReportRow>& rows ) {
+    auto quoted = []( const std::string& in ) {
+        std::string out( "\"" );
+        for ( char c : in ) {
+            if ( c == '"' ) { out += '"'; }
+            out += c;
+        }
+        return out + "\"";
+    };
+    out << "id,title,nest,location";
+    for ( const auto& column : columns ) {
+        out << "," << column;
+    }
+    out << "\n";
+    for ( const auto& row : rows ) {
+        out << row.id << "," << quoted( row.title ) << "," << row.nest << "," << quoted( row.location );
+        for ( double v : row.values ) {
+            out << "," << std::setprecision( 10 ) << v;
+        }
+        out << "\n";
+    }
+}
+
+/// Instructions per cycle
+double ipc( const HardwareCounters::Values& c ) {
+    return c[HardwareCounters::CYCLES] ? double( c[HardwareCounters::INSTRUCTIONS] ) / c[HardwareCounters::CYCLES]
+                                       : 0.;
+}
+
+/// Memory traffic due to last level cache misses, per instruction
+double bytes_per_instruction( const HardwareCounters::Values& c ) {
+    return c[HardwareCounters::INSTRUCTIONS] ? HardwareCounters::cache_line_bytes * c[HardwareCounters::LLC_MISSES] /
+                                                   c[HardwareCounters::INSTRUCTIONS]
+                                             : 0.;
+}
+
+}  // namespace
+
 class TimingsRegistry {
 private:
     std::vector<long> counts_;
@@ -37,6 +115,7 @@ private:
     std::vector<double> min_timings_;
     std::vector<double> max_timings_;
     std::vector<double> var_timings_;
+    std::vector<HardwareCounters::Values> counters_;
     std::vector<std::string> titles_;
     std::vector<eckit::CodeLocation> locations_;
     std::vector<long> nest_;
@@ -57,10 +136,18 @@ public:
 
     void update( size_t idx, double seconds );
 
+    void update( size_t idx, const HardwareCounters::Values& );
+
     size_t size() const;
 
     void report( std::ostream& out, const eckit::Configuration& config );
 
+    void report_aggregated( std::ostream& out, const eckit::Configuration& config );
+
+    std::vector<Timings::Aggregated> aggregate( const eckit::Configuration& config );
+
+    std::vector<bool> exclusions( const eckit::Configuration& config );
+
 private:
     std::string filter_filepath( const std::string& filepath ) const;
 };
@@ -77,6 +164,7 @@ size_t TimingsRegistry::add( const eckit::CodeLocation& loc, const CallStack& st
         min_timings_.emplace_back( std::numeric_limits<double>::max() );
         max_timings_.emplace_back( 0 );
         var_timings_.emplace_back( 0 );
+        counters_.emplace_back( HardwareCounters::Values{} );
         titles_.emplace_back( title );
         locations_.emplace_back( loc );
         nest_.emplace_back( stack.size() );
@@ -105,11 +193,53 @@ void TimingsRegistry::update( size_t idx, double seconds ) {
     counts_[idx] += 1;
 }
 
+void TimingsRegistry::update( size_t idx, const HardwareCounters::Values& counters ) {
+    for ( size_t e = 0; e < HardwareCounters::_COUNT_; ++e ) {
+        counters_[idx][e] += counters[e];
+    }
+}
+
 size_t TimingsRegistry::size() const {
     return counts_.size();
 }
 
 void TimingsRegistry::report( std::ostream& out, const eckit::Configuration& config ) {
+    std::string format = config.getString( "format", "table" );
+    if ( format == "json" || format == "csv" ) {
+        std::vector<bool> excluded = exclusions( config );
+        std::vector<std::string> columns{"count", "tot", "avg", "std", "min", "max"};
+        if ( HardwareCounters::enabled() ) {
+            for ( size_t e = 0; e < HardwareCounters::_COUNT_; ++e ) {
+                columns.emplace_back( HardwareCounters::name( HardwareCounters::Event( e ) ) );
+            }
+            columns.emplace_back( "ipc" );
+            columns.emplace_back( "bytes_per_instruction" );
+        }
+        std::vector<ReportRow> rows;
+        for ( size_t j = 0; j < size(); ++j ) {
+            if ( not excluded[j] ) {
+                const auto& loc = locations_[j];
+                rows.emplace_back( ReportRow{
+                    j, titles_[j], filter_filepath( loc.file() ) + " +" + std::to_string( loc.line() ), nest_[j],
+                    {double( counts_[j] ), tot_timings_[j], tot_timings_[j] / double( counts_[j] ),
+                     std::sqrt( var_timings_[j] ), min_timings_[j], max_timings_[j]}} );
+                if ( HardwareCounters::enabled() ) {
+                    auto& values = rows.back().values;
+                    for ( auto c : counters_[j] ) {
+                        values.emplace_back( double( c ) );
+                    }
+                    values.emplace_back( ipc( counters_[j] ) );
+                    values.emplace_back( bytes_per_instruction( counters_[j] ) );
+                }
+            }
+        }
+        if ( format == "json" ) { write_json( out, columns, rows, "local" ); }
+        else {
+            write_csv( out, columns, rows );
+        }
+        return;
+    }
+
     auto box_horizontal = []( int n ) {
         std::string s;
         s.reserve( 2 * n );
@@ -128,61 +258,17 @@ void TimingsRegistry::report( std::ostream& out, const eckit::Configuration& con
     std::string box_T_left( "\u2524" );
     std::string box_cross( "\u253C" );
 
-    long indent                                     = config.getLong( "indent", 2 );
-    long depth                                      = config.getLong( "depth", 0 );
-    long decimals                                   = config.getLong( "decimals", 5 );
-    bool header                                     = config.getBool( "header", true );
-    std::vector<std::string> excluded_labels_vector = config.getStringVector( "exclude", std::vector<std::string>() );
-    std::vector<std::string> include_back;
-
-    for ( auto& label : excluded_labels_vector ) {
-        size_t found = label.find( "/*" );
-        if ( found != std::string::npos ) {
-            label.erase( found, 2 );
-            include_back.push_back( label );
-        }
-    }
-
-    std::set<std::string> excluded_labels( excluded_labels_vector.begin(), excluded_labels_vector.end() );
+    long indent   = config.getLong( "indent", 2 );
+    long decimals = config.getLong( "decimals", 5 );
+    bool header   = config.getBool( "header", true );
 
     auto digits_before_decimal = []( double x ) -> int {
         return std::floor( std::log10( std::trunc( std::max( 1., x ) ) ) ) + 1;
     };
     auto digits = []( long x ) -> long { return std::floor( std::log10( std::max( 1l, x ) ) ) + 1l; };
 
-    std::vector<size_t> excluded_timers_vector;
-    for ( auto label : labels_ ) {
-        auto name = label.first;
-        if ( excluded_labels.count( name ) ) {
-            auto timers = label.second;
-            for ( size_t j : timers ) {
-                excluded_timers_vector.push_back( j );
-            }
-        }
-    }
-    std::set<size_t> excluded_timers( excluded_timers_vector.begin(), excluded_timers_vector.end() );
-
-    auto excluded = [&]( size_t i ) -> bool {
-        if ( depth and nest_[i] > depth ) return true;
-        return excluded_timers.count( i );
-    };
-
-    std::vector<long> excluded_nest_stored( size() );
-    long excluded_nest = size();
-    for ( size_t j = 0; j < size(); ++j ) {
-        if ( nest_[j] > excluded_nest ) { excluded_timers.insert( j ); }
-        if ( not excluded( j ) ) { excluded_nest = nest_[j] + 1; }
-        else {
-            excluded_nest = std::min( excluded_nest, nest_[j] );
-        }
-        excluded_nest_stored[j] = excluded_nest;
-    }
-    for ( auto& label : include_back ) {
-        auto timers = labels_[label];
-        for ( size_t j : timers ) {
-            if ( nest_[j] == excluded_nest_stored[j] ) excluded_timers.erase( j );
-        }
-    }
+    std::vector<bool> excluded_timers = exclusions( config );
+    auto excluded                     = [&]( size_t i ) -> bool { return excluded_timers[i]; };
 
     size_t max_title_length( 0 );
     size_t max_location_length( 0 );
@@ -205,6 +291,11 @@ void TimingsRegistry::report( std::ostream& out, const eckit::Configuration& con
     if ( header ) { max_count_length = std::max( std::string( "cnt" ).size(), max_count_length ); }
     size_t max_digits_before_decimal = digits_before_decimal( max_seconds );
 
+    // Optional hardware counter columns: ipc, bytes/instruction, llc misses, branch misses
+    bool counters = HardwareCounters::enabled();
+    std::vector<std::string> counter_titles{"ipc", "B/ins", "llc-miss", "br-miss"};
+    size_t counter_length = 8;
+
     auto print_time = [max_digits_before_decimal, decimals]( double x ) -> std::string {
         std::stringstream out;
         char unit = 's';
@@ -226,7 +317,13 @@ void TimingsRegistry::report( std::ostream& out, const eckit::Configuration& con
            << print_line( max_digits_before_decimal + decimals + 2 ) << sep
            << print_line( max_digits_before_decimal + decimals + 2 ) << sep
            << print_line( max_digits_before_decimal + decimals + 2 ) << sep
-           << print_line( max_digits_before_decimal + decimals + 2 ) << sep << print_line( max_location_length );
+           << print_line( max_digits_before_decimal + decimals + 2 ) << sep;
+        if ( counters ) {
+            for ( size_t c = 0; c < counter_titles.size(); ++c ) {
+                ss << print_line( counter_length ) << sep;
+            }
+        }
+        ss << print_line( max_location_length );
         return ss.str();
     };
 
@@ -235,13 +332,32 @@ void TimingsRegistry::report( std::ostream& out, const eckit::Configuration& con
     std::string sep  = std::string( " " ) + box_vertical + std::string( " " );
     std::string sepf = box_horizontal( 1 ) + box_T_up + box_horizontal( 1 );
 
+    auto print_counters = [&]( size_t j ) -> std::string {
+        std::stringstream ss;
+        if ( counters ) {
+            const auto& c = counters_[j];
+            ss << std::right << std::fixed << std::setprecision( 2 ) << std::setw( counter_length ) << ipc( c )
+               << sep << std::setw( counter_length ) << bytes_per_instruction( c ) << sep
+               << std::scientific << std::setprecision( 2 ) << std::setw( counter_length )
+               << double( c[HardwareCounters::LLC_MISSES] ) << sep << std::setw( counter_length )
+               << double( c[HardwareCounters::BRANCH_MISSES] ) << sep;
+        }
+        return ss.str();
+    };
+
     out << print_horizontal( sept ) << std::endl;
     out << std::left << std::setw( max_title_length + digits( size() ) + 3 ) << "Timers" << sep
         << std::setw( max_count_length ) << "cnt" << sep << std::setw( max_digits_before_decimal + decimals + 2ul )
         << "tot" << sep << std::setw( max_digits_before_decimal + decimals + 2ul ) << "avg" << sep
         << std::setw( max_digits_before_decimal + decimals + 2ul ) << "std" << sep
         << std::setw( max_digits_before_decimal + decimals + 2ul ) << "min" << sep
-        << std::setw( max_digits_before_decimal + decimals + 2ul ) << "max" << sep << "location" << std::endl;
+        << std::setw( max_digits_before_decimal + decimals + 2ul ) << "max" << sep;
+    if ( counters ) {
+        for ( const auto& title : counter_titles ) {
+            out << std::setw( counter_length ) << title << sep;
+        }
+    }
+    out << "location" << std::endl;
     out << print_horizontal( seph ) << std::endl;
 
     std::vector<std::string> prefix_( size() );
@@ -308,7 +424,8 @@ void TimingsRegistry::report( std::ostream& out, const eckit::Configuration& con
                 << std::string( header ? "" : "avg: " ) << print_time( avg ) << sep
                 << std::string( header ? "" : "std: " ) << print_time( std ) << sep
                 << std::string( header ? "" : "min: " ) << print_time( min ) << sep
-                << std::string( header ? "" : "max: " ) << print_time( max ) << sep << filter_filepath( loc.file() )
+                << std::string( header ? "" : "max: " ) << print_time( max ) << sep << print_counters( j )
+                << filter_filepath( loc.file() )
                 << " +" << loc.line() << std::endl;
         }
     }
@@ -336,6 +453,326 @@ void TimingsRegistry::report( std::ostream& out, const eckit::Configuration& con
     out << std::left << box_horizontal( 40 ) << sepf << box_horizontal( 5 ) << sepf << box_horizontal( 12 ) << "\n";
 }
 
+std::vector<Timings::Aggregated> TimingsRegistry::aggregate( const eckit::Configuration& config ) {
+    // Note: no ATLAS_TRACE_MPI in here, as that would register new timers while reducing them
+    const auto& comm   = mpi::comm();
+    const size_t nproc = comm.size();
+    const size_t rank  = comm.rank();
+
+    // Timers are identified by their call stack hash. All timers registered on any task are included: those of
+    // task 0 in registration order, and those of other tasks inserted after their predecessor on that task.
+    std::vector<size_t> local_keys( size() );
+    for ( size_t j = 0; j < size(); ++j ) {
+        local_keys[j] = stack_[j].hash();
+    }
+    eckit::mpi::Buffer<size_t> recv_keys( nproc );
+    eckit::mpi::Buffer<long> recv_nest( nproc );
+    comm.allGatherv( local_keys.begin(), local_keys.end(), recv_keys );
+    comm.allGatherv( nest_.begin(), nest_.end(), recv_nest );
+
+    std::vector<size_t> keys;
+    std::vector<long> nest;
+    std::vector<size_t> owner;  // lowest task that registered the timer
+    for ( size_t p = 0; p < nproc; ++p ) {
+        size_t pos = 0;
+        for ( size_t i = recv_keys.displs[p]; i < size_t( recv_keys.displs[p] + recv_keys.counts[p] ); ++i ) {
+            auto found = std::find( keys.begin(), keys.end(), recv_keys.buffer[i] );
+            if ( found == keys.end() ) {
+                // Skip the nested timers of the predecessor, to keep the call tree intact
+                while ( pos < keys.size() && nest[pos] > recv_nest.buffer[i] ) {
+                    ++pos;
+                }
+                keys.insert( keys.begin() + pos, recv_keys.buffer[i] );
+                nest.insert( nest.begin() + pos, recv_nest.buffer[i] );
+                owner.insert( owner.begin() + pos, p );
+                ++pos;
+            }
+            else {
+                pos = ( found - keys.begin() ) + 1;
+            }
+        }
+    }
+    const size_t ntimers = keys.size();
+
+    // Titles and locations, packed as "title\nlocation\n" per timer by the task that owns it
+    std::string buffer;
+    {
+        std::stringstream s;
+        for ( size_t j = 0; j < ntimers; ++j ) {
+            if ( owner[j] == rank ) {
+                size_t idx = index_.at( keys[j] );
+                s << titles_[idx] << '\n'
+                  << filter_filepath( locations_[idx].file() ) << " +" << locations_[idx].line() << '\n';
+            }
+        }
+        buffer = s.str();
+    }
+    eckit::mpi::Buffer<char> recv_text( nproc );
+    comm.allGatherv( buffer.begin(), buffer.end(), recv_text );
+    std::vector<std::istringstream> text( nproc );
+    for ( size_t p = 0; p < nproc; ++p ) {
+        text[p].str( std::string( recv_text.buffer.data() + recv_text.displs[p], recv_text.counts[p] ) );
+    }
+
+    // Local contributions; timers not called on this task do not contribute to min/avg/max.
+    // A timer is excluded from reports when it is excluded on all tasks that registered it.
+    std::vector<bool> local_excluded = exclusions( config );
+    std::vector<double> tot( ntimers, 0. );
+    std::vector<double> min( ntimers, std::numeric_limits<double>::max() );
+    std::vector<double> max( ntimers, 0. );
+    std::vector<long> count( ntimers, 0 );
+    std::vector<long> ntasks( ntimers, 0 );
+    std::vector<int> excluded( ntimers, 1 );
+    for ( size_t j = 0; j < ntimers; ++j ) {
+        auto it = index_.find( keys[j] );
+        if ( it != index_.end() ) {
+            size_t idx  = it->second;
+            excluded[j] = local_excluded[idx];
+            if ( counts_[idx] ) {
+                tot[j]    = tot_timings_[idx];
+                min[j]    = tot_timings_[idx];
+                max[j]    = tot_timings_[idx];
+                count[j]  = counts_[idx];
+                ntasks[j] = 1;
+            }
+        }
+    }
+    comm.allReduceInPlace( tot.data(), ntimers, eckit::mpi::sum() );
+    comm.allReduceInPlace( min.data(), ntimers, eckit::mpi::min() );
+    comm.allReduceInPlace( max.data(), ntimers, eckit::mpi::max() );
+    comm.allReduceInPlace( count.data(), ntimers, eckit::mpi::max() );
+    comm.allReduceInPlace( ntasks.data(), ntimers, eckit::mpi::sum() );
+    comm.allReduceInPlace( excluded.data(), ntimers, eckit::mpi::min() );
+
+    // Slowest task: lowest rank attaining the (exactly reduced) maximum
+    std::vector<long> slowest( ntimers, nproc );
+    for ( size_t j = 0; j < ntimers; ++j ) {
+        auto it = index_.find( keys[j] );
+        if ( it != index_.end() && counts_[it->second] && tot_timings_[it->second] == max[j] ) {
+            slowest[j] = rank;
+        }
+    }
+    comm.allReduceInPlace( slowest.data(), ntimers, eckit::mpi::min() );
+
+    std::vector<Timings::Aggregated> aggregated( ntimers );
+    for ( size_t j = 0; j < ntimers; ++j ) {
+        auto& a = aggregated[j];
+        std::getline( text[owner[j]], a.title );
+        std::getline( text[owner[j]], a.location );
+        a.nest     = nest[j];
+        a.count    = count[j];
+        a.ntasks   = ntasks[j];
+        a.min      = ntasks[j] ? min[j] : 0.;
+        a.avg      = ntasks[j] ? tot[j] / double( ntasks[j] ) : 0.;
+        a.max      = max[j];
+        a.slowest  = ntasks[j] ? slowest[j] : owner[j];
+        a.excluded = excluded[j];
+    }
+    return aggregated;
+}
+
+void TimingsRegistry::report_aggregated( std::ostream& out, const eckit::Configuration& config ) {
+    std::vector<Timings::Aggregated> timers = aggregate( config );
+    const size_t ntimers                    = timers.size();
+
+    std::string format = config.getString( "format", "table" );
+    if ( format == "json" || format == "csv" ) {
+        std::vector<std::string> columns{"count", "tasks", "min", "avg", "max", "imbalance", "slowest"};
+        std::vector<ReportRow> rows;
+        for ( size_t j = 0; j < ntimers; ++j ) {
+            if ( not timers[j].excluded ) {
+                const auto& t = timers[j];
+                rows.emplace_back( ReportRow{j,
+                                             t.title,
+                                             t.location,
+                                             t.nest,
+                                             {double( t.count ), double( t.ntasks ), t.min, t.avg, t.max,
+                                              t.imbalance(), double( t.slowest )}} );
+            }
+        }
+        if ( format == "json" ) { write_json( out, columns, rows, "mpi" ); }
+        else {
+            write_csv( out, columns, rows );
+        }
+        return;
+    }
+
+    auto box_horizontal = []( int n ) {
+        std::string s;
+        s.reserve( 2 * n );
+        for ( size_t i = 0; i < n; ++i )
+            s += "\u2500";
+        return s;
+    };
+    std::string box_corner_bl( "\u2514" );
+    std::string box_vertical( "\u2502" );
+    std::string box_T_down( "\u252C" );
+    std::string box_T_up( "\u2534" );
+    std::string box_T_right( "\u251C" );
+    std::string box_cross( "\u253C" );
+
+    long indent   = config.getLong( "indent", 2 );
+    long decimals = config.getLong( "decimals", 5 );
+
+    auto digits_before_decimal = []( double x ) -> int {
+        return std::floor( std::log10( std::trunc( std::max( 1., x ) ) ) ) + 1;
+    };
+    auto digits = []( long x ) -> long { return std::floor( std::log10( std::max( 1l, x ) ) ) + 1l; };
+
+    size_t max_title_length( 0 );
+    size_t max_location_length( 0 );
+    long max_nest( 0 );
+    long max_count( 0 );
+    double max_seconds( 0 );
+    for ( size_t j = 0; j < ntimers; ++j ) {
+        max_nest = std::max( max_nest, timers[j].nest );
+        if ( not timers[j].excluded ) {
+            max_title_length    = std::max( max_title_length, timers[j].title.size() + timers[j].nest * indent );
+            max_count           = std::max( max_count, timers[j].count );
+            max_seconds         = std::max( max_seconds, timers[j].max );
+            max_location_length = std::max( max_location_length, timers[j].location.size() );
+        }
+    }
+    size_t max_count_length  = std::max<size_t>( 3, digits( max_count ) );
+    size_t max_tasks_length  = std::max<size_t>( 5, digits( mpi::comm().size() ) );
+    size_t time_length       = digits_before_decimal( max_seconds ) + decimals + 2;
+    size_t imbalance_length  = 6;
+    size_t id_length         = digits( ntimers ) + 3;
+    size_t max_digits_before = digits_before_decimal( max_seconds );
+
+    auto print_time = [max_digits_before, decimals]( double x ) -> std::string {
+        std::stringstream out;
+        char unit = 's';
+        if ( std::floor( x ) >= 60 ) {
+            x /= 60.;
+            unit = 'm';
+        }
+        out << std::right << std::fixed << std::setprecision( decimals )
+            << std::setw( max_digits_before + decimals + 1 ) << x << unit;
+        return out.str();
+    };
+
+    auto print_horizontal = [&]( const std::string& sep ) -> std::string {
+        std::stringstream ss;
+        ss << box_horizontal( max_title_length + id_length ) << sep << box_horizontal( max_count_length ) << sep
+           << box_horizontal( max_tasks_length ) << sep << box_horizontal( time_length ) << sep
+           << box_horizontal( time_length ) << sep << box_horizontal( time_length ) << sep
+           << box_horizontal( imbalance_length ) << sep << box_horizontal( max_tasks_length ) << sep
+           << box_horizontal( max_location_length );
+        return ss.str();
+    };
+
+    std::string sept = box_horizontal( 1 ) + box_T_down + box_horizontal( 1 );
+    std::string seph = box_horizontal( 1 ) + box_cross + box_horizontal( 1 );
+    std::string sep  = std::string( " " ) + box_vertical + std::string( " " );
+    std::string sepf = box_horizontal( 1 ) + box_T_up + box_horizontal( 1 );
+
+    out << print_horizontal( sept ) << std::endl;
+    out << std::left << std::setw( max_title_length + id_length ) << "Timers (over MPI tasks)" << sep
+        << std::setw( max_count_length ) << "cnt" << sep << std::setw( max_tasks_length ) << "tasks" << sep
+        << std::setw( time_length ) << "min" << sep << std::setw( time_length ) << "avg" << sep
+        << std::setw( time_length ) << "max" << sep << std::setw( imbalance_length ) << "imb" << sep
+        << std::setw( max_tasks_length ) << "slow" << sep << "location" << std::endl;
+    out << print_horizontal( seph ) << std::endl;
+
+    // Tree prefixes, derived from the nesting levels only, so that they are identical on all tasks
+    std::vector<std::string> prefix( ntimers );
+    if ( indent ) {
+        std::vector<bool> active( max_nest + 1, false );
+        for ( long k = long( ntimers ) - 1; k >= 0; --k ) {
+            long nest = timers[k].nest;
+            std::stringstream ss;
+            for ( long i = 0; i < nest - 1; ++i ) {
+                ss << ( active[i] ? box_vertical : std::string( " " ) );
+                for ( long j = 1; j < indent; ++j )
+                    ss << " ";
+            }
+            if ( nest > 0 ) {
+                ss << ( active[nest - 1] ? box_T_right : box_corner_bl );
+                for ( long j = 1; j < indent; ++j )
+                    ss << box_horizontal( 1 );
+                active[nest - 1] = true;
+            }
+            for ( size_t i = std::max( nest, 0l ); i < active.size(); ++i ) {
+                active[i] = false;
+            }
+            prefix[k] = ss.str();
+        }
+    }
+
+    for ( size_t j = 0; j < ntimers; ++j ) {
+        const auto& t = timers[j];
+        if ( not timers[j].excluded ) {
+            out << std::setw( digits( ntimers ) ) << j << " : " << prefix[j] << std::left
+                << std::setw( max_title_length - t.nest * indent ) << t.title << sep << std::left
+                << std::setw( max_count_length ) << t.count << sep << std::setw( max_tasks_length ) << t.ntasks
+                << sep << print_time( t.min ) << sep << print_time( t.avg ) << sep << print_time( t.max ) << sep
+                << std::right << std::fixed << std::setprecision( 2 ) << std::setw( imbalance_length )
+                << t.imbalance() << sep << std::setw( max_tasks_length ) << t.slowest << sep << std::left
+                << t.location << std::endl;
+        }
+    }
+
+    out << print_horizontal( sepf ) << std::endl;
+    out << "imb: load imbalance ratio max/avg over tasks,  slow: task with maximum time" << std::endl;
+}
+
+std::vector<bool> TimingsRegistry::exclusions( const eckit::Configuration& config ) {
+    long depth                                      = config.getLong( "depth", 0 );
+    std::vector<std::string> excluded_labels_vector = config.getStringVector( "exclude", std::vector<std::string>() );
+    std::vector<std::string> include_back;
+
+    for ( auto& label : excluded_labels_vector ) {
+        size_t found = label.find( "/*" );
+        if ( found != std::string::npos ) {
+            label.erase( found, 2 );
+            include_back.push_back( label );
+        }
+    }
+
+    std::set<std::string> excluded_labels( excluded_labels_vector.begin(), excluded_labels_vector.end() );
+
+    std::vector<size_t> excluded_timers_vector;
+    for ( auto label : labels_ ) {
+        auto name = label.first;
+        if ( excluded_labels.count( name ) ) {
+            auto timers = label.second;
+            for ( size_t j : timers ) {
+                excluded_timers_vector.push_back( j );
+            }
+        }
+    }
+    std::set<size_t> excluded_timers( excluded_timers_vector.begin(), excluded_timers_vector.end() );
+
+    auto excluded = [&]( size_t i ) -> bool {
+        if ( depth and nest_[i] > depth ) return true;
+        return excluded_timers.count( i );
+    };
+
+    std::vector<long> excluded_nest_stored( size() );
+    long excluded_nest = size();
+    for ( size_t j = 0; j < size(); ++j ) {
+        if ( nest_[j] > excluded_nest ) { excluded_timers.insert( j ); }
+        if ( not excluded( j ) ) { excluded_nest = nest_[j] + 1; }
+        else {
+            excluded_nest = std::min( excluded_nest, nest_[j] );
+        }
+        excluded_nest_stored[j] = excluded_nest;
+    }
+    for ( auto& label : include_back ) {
+        auto timers = labels_[label];
+        for ( size_t j : timers ) {
+            if ( nest_[j] == excluded_nest_stored[j] ) excluded_timers.erase( j );
+        }
+    }
+
+    std::vector<bool> result( size() );
+    for ( size_t j = 0; j < size(); ++j ) {
+        result[j] = excluded( j );
+    }
+    return result;
+}
+
 std::string TimingsRegistry::filter_filepath( const std::string& filepath ) const {
     std::regex filepath_re( "(.*)?/atlas/src/(.*)" );
     std::smatch matches;
@@ -361,16 +798,32 @@ void Timings::update( const Identifier& id, double seconds ) {
     TimingsRegistry::instance().update( id, seconds );
 }
 
+void Timings::update( const Identifier& id, double seconds, const HardwareCounters::Values& counters ) {
+    TimingsRegistry::instance().update( id, seconds );
+    if ( HardwareCounters::enabled() ) { TimingsRegistry::instance().update( id, counters ); }
+}
+
 std::string Timings::report() {
     return report( util::NoConfig() );
 }
 
 std::string Timings::report( const Configuration& config ) {
     std::stringstream out;
-    TimingsRegistry::instance().report( out, config );
+    if ( config.getBool( "mpi", false ) ) { TimingsRegistry::instance().report_aggregated( out, config ); }
+    else {
+        TimingsRegistry::instance().report( out, config );
+    }
     return out.str();
 }
 
+std::vector<Timings::Aggregated> Timings::aggregate() {
+    return TimingsRegistry::instance().aggregate( util::NoConfig() );
+}
+
+std::vector<Timings::Aggregated> Timings::aggregate( const Configuration& config ) {
+    return TimingsRegistry::instance().aggregate( config );
+}
+
 }  // namespace trace
 }  // namespace runtime
 }  // namespace atlas
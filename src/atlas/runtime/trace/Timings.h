@@ -13,6 +13,8 @@
 #include <string>
 #include <vector>
 
+#include "atlas/runtime/trace/HardwareCounters.h"
+
 //-----------------------------------------------------------------------------------------------------------
 
 namespace eckit {
@@ -35,14 +37,45 @@ public:
     using Identifier    = size_t;
     using Labels        = std::vector<std::string>;
 
+    /// Statistics of one timer, reduced over all MPI tasks.
+    /// Times are the accumulated time of the timer on each task.
+    struct Aggregated {
+        std::string title;
+        std::string location;
+        long nest;
+        long count;      ///< maximum number of calls on any task
+        long ntasks;     ///< number of tasks that have called this timer
+        double min;      ///< minimum time over tasks
+        double avg;      ///< average time over tasks that called this timer
+        double max;      ///< maximum time over tasks
+        size_t slowest;  ///< task with maximum time (lowest rank in case of ties)
+        bool excluded;   ///< filtered out by the "depth" and "exclude" options on all tasks that called it
+        /// Load imbalance ratio max/avg (1 means perfectly balanced)
+        double imbalance() const { return avg > 0. ? max / avg : 1.; }
+    };
+
 public:  // static methods
     static Identifier add( const CodeLocation&, const CallStack&, const std::string& title, const Labels& );
 
     static void update( const Identifier& id, double seconds );
 
+    static void update( const Identifier& id, double seconds, const HardwareCounters::Values& );
+
     static std::string report();
 
+    /// Configuration options:
+    ///  - indent, depth, decimals, header, exclude : see table layout
+    ///  - mpi    : reduce timers over all MPI tasks (collective call), default false
+    ///  - format : "table" (default), "json" or "csv"
     static std::string report( const Configuration& );
+
+    /// Reduce all timers over all MPI tasks. Timers are identified by their call stack. All timers registered on
+    /// any task are included, ordered as registered on MPI task 0, with timers of other tasks inserted after
+    /// their predecessor on that task. Collective call.
+    static std::vector<Aggregated> aggregate();
+
+    /// As aggregate(), marking timers filtered out by the "depth" and "exclude" options of report()
+    static std::vector<Aggregated> aggregate( const Configuration& );
 };
 
 }  // namespace trace
@@ -14,6 +14,7 @@
 #include <string>
 #include <vector>
 
+#include "atlas/runtime/trace/HardwareCounters.h"
 #include "atlas/runtime/trace/Nesting.h"
 #include "atlas/runtime/trace/StopWatch.h"
 #include "atlas/runtime/trace/Timings.h"
@@ -76,6 +77,7 @@ private:  // member functions
 private:  // member data
     bool running_{true};
     StopWatch stopwatch_;
+    HardwareCounters counters_;
     eckit::CodeLocation loc_;
     std::string title_;
     Identifier id_;
@@ -128,7 +130,7 @@ inline void TraceT<TraceTraits>::registerTimer() {
 
 template <typename TraceTraits>
 inline void TraceT<TraceTraits>::updateTimings() const {
-    Timings::update( id_, stopwatch_.elapsed() );
+    Timings::update( id_, stopwatch_.elapsed(), counters_.values() );
 }
 
 template <typename TraceTraits>
@@ -142,11 +144,13 @@ inline void TraceT<TraceTraits>::start() {
     Tracing::start( title_ );
     barrier();
     stopwatch_.start();
+    counters_.start();
 }
 
 template <typename TraceTraits>
 inline void TraceT<TraceTraits>::stop() {
     if ( running_ ) {
+        counters_.stop();
         barrier();
         stopwatch_.stop();
         nesting_.stop();
@@ -159,6 +163,7 @@ inline void TraceT<TraceTraits>::stop() {
 template <typename TraceTraits>
 inline void TraceT<TraceTraits>::pause() {
     if ( running_ ) {
+        counters_.stop();
         barrier();
         stopwatch_.stop();
         nesting_.stop();
@@ -171,6 +176,7 @@ inline void TraceT<TraceTraits>::resume() {
         barrier();
         nesting_.start();
         stopwatch_.start();
+        counters_.start();
     }
 }
 
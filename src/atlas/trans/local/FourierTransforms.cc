@@ -25,10 +25,11 @@ void invtrans_fourier( const size_t trcFT,
                        const int nb_fields,      // Number of fields
                        const double rlegReal[],  // associated Legendre functions, size (trc+1)*trc/2 (in)
                        const double rlegImag[],  // associated Legendre functions, size (trc+1)*trc/2 (in)
-                       double rgp[] )            // gridpoint
+                       double rgp[],             // gridpoint
+                       const int field_stride )  // stride between fields in rgp
 {
     for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
-        rgp[jfld] = 0.;
+        rgp[jfld * field_stride] = 0.;
     }
     // local Fourier transformation:
     for ( int jm = 0; jm <= trcFT; ++jm ) {
@@ -37,7 +38,7 @@ void invtrans_fourier( const size_t trcFT,
         for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
             double real = cos * rlegReal[jm * nb_fields + jfld];
             double imag = sin * rlegImag[jm * nb_fields + jfld];
-            rgp[jfld] += real - imag;
+            rgp[jfld * field_stride] += real - imag;
         }
     }
 }
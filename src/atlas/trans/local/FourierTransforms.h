@@ -27,7 +27,8 @@ void invtrans_fourier( const size_t trcFT,
                        const int nb_fields,      // Number of fields
                        const double rlegReal[],  // values of associated Legendre functions, size (trc+1)*trc/2 (in)
                        const double rlegImag[],  // values of associated Legendre functions, size (trc+1)*trc/2 (in)
-                       double rgp[] );           // gridpoint
+                       double rgp[],             // gridpoint, field jfld at rgp[jfld*field_stride] (out)
+                       const int field_stride = 1 );
 
 int fourier_truncation( const int truncation, const int nx, const int nxmax, const int ndgl, const double lat,
                         const bool fullgrid );
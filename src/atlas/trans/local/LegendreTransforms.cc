@@ -55,6 +55,23 @@ void invtrans_legendre( const size_t trc,    // truncation (in)
     }
 }
 
+void invtrans_legendre_m( const size_t trc, const size_t jm, const double legpol[], const int nb_fields,
+                          const double spec[], double leg_real[], double leg_imag[], const size_t spec_coeff_stride,
+                          const size_t spec_field_stride ) {
+    // Same factor 2 as in invtrans_legendre, which is undone for (jm == 0)
+    const double factor = ( jm == 0 ) ? 1. : 2.;
+    for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+        leg_real[jfld] = 0.;
+        leg_imag[jfld] = 0.;
+    }
+    for ( size_t jn = jm, k = 0; jn <= trc; ++jn, ++k ) {
+        for ( int jfld = 0; jfld < nb_fields; ++jfld ) {
+            leg_real[jfld] += factor * spec[( 2 * k ) * spec_coeff_stride + jfld * spec_field_stride] * legpol[k];
+            leg_imag[jfld] += factor * spec[( 2 * k + 1 ) * spec_coeff_stride + jfld * spec_field_stride] * legpol[k];
+        }
+    }
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 
 }  // namespace trans
@@ -30,6 +30,20 @@ void invtrans_legendre( const size_t trc,    // truncation (in)
                         double leg_real[],      // values of associated Legendre functions, size (trc+1)*trc/2 (out)
                         double leg_imag[] );    // values of associated Legendre functions, size (trc+1)*trc/2 (out)
 
+//-----------------------------------------------------------------------------
+// Legendre transformation of a single zonal wavenumber jm, as computed by
+// invtrans_legendre for jm. Allows the zonal wavenumbers to be distributed.
+// Spectral coefficient k of field jfld is read from spec[k*spec_coeff_stride + jfld*spec_field_stride].
+//
+void invtrans_legendre_m( const size_t trc,       // truncation (in)
+                          const size_t jm,        // zonal wavenumber (in)
+                          const double legpol[],  // values of associated Legendre functions for jm, n=jm..trc (in)
+                          const int nb_fields,    // number of fields
+                          const double spec[],    // spectral data for jm, size 2*(trc+1-jm)*nb_fields (in)
+                          double leg_real[],      // real part for jm, size nb_fields (out)
+                          double leg_imag[],      // imaginary part for jm, size nb_fields (out)
+                          const size_t spec_coeff_stride, const size_t spec_field_stride = 1 );
+
 // --------------------------------------------------------------------------------------------------------------------
 
 }  // namespace trans
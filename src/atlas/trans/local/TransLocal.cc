@@ -10,8 +10,13 @@
 
 #include "atlas/trans/local/TransLocal.h"
 #include "atlas/array.h"
+#include "atlas/field/Field.h"
+#include "atlas/field/FieldSet.h"
+#include "atlas/functionspace/Spectral.h"
 #include "atlas/option.h"
+#include "atlas/parallel/mpi/Statistics.h"
 #include "atlas/parallel/mpi/mpi.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/runtime/ErrorHandling.h"
 #include "atlas/runtime/Log.h"
 #include "atlas/trans/VorDivToUV.h"
@@ -73,10 +78,11 @@ TransLocal::TransLocal( const Cache& cache, const Grid& grid, const long truncat
                 size += legendre_size( truncation_ + 1 );
             }
             legendre_.resize( size );
-            int j( 0 );
-            for ( PointXY p : grid_.xy() ) {
-                double lat = p.y() * util::Constants::degreesToRadians();
-                compute_legendre_polynomials( truncation_ + 1, lat, legendre_data( j++ ) );
+            std::vector<double> xy( 2 * grid_.size() );
+            grid_.fill_xy( xy.data() );
+            atlas_omp_parallel_for( size_t j = 0; j < grid_.size(); ++j ) {
+                double lat = xy[2 * j + 1] * util::Constants::degreesToRadians();
+                compute_legendre_polynomials( truncation_ + 1, lat, legendre_data( j ) );
             }
         }
     }
@@ -94,13 +100,35 @@ TransLocal::~TransLocal() {}
 // --------------------------------------------------------------------------------------------------------------------
 
 void TransLocal::invtrans( const Field& spfield, Field& gpfield, const eckit::Configuration& config ) const {
-    NOTIMP;
+    ATLAS_TRACE( "TransLocal::invtrans" );
+    functionspace::Spectral spectral( spfield.functionspace() );
+    if ( not spectral ) {
+        throw eckit::BadValue( "Spectral field " + spfield.name() + " has no Spectral functionspace", Here() );
+    }
+    ASSERT( spectral.truncation() == truncation_ );
+    ASSERT( gpfield.shape( 0 ) == grid_.size() );
+    ASSERT( spfield.rank() <= 2 );
+    ASSERT( gpfield.rank() <= 2 );
+    const int nb_fields = spfield.rank() > 1 ? spfield.shape( 1 ) : 1;
+    ASSERT( ( gpfield.rank() > 1 ? gpfield.shape( 1 ) : 1 ) == size_t( nb_fields ) );
+
+    // Both fields are accessed in place with their own strides, e.g. (point,level) or (level,point) storage
+    const size_t spec_coeff_stride = spfield.stride( 0 );
+    const size_t spec_field_stride = spfield.rank() > 1 ? spfield.stride( 1 ) : 1;
+    const size_t gp_point_stride   = gpfield.stride( 0 );
+    const size_t gp_field_stride   = gpfield.rank() > 1 ? gpfield.stride( 1 ) : 1;
+
+    invtrans_zonal_wavenumbers( spectral.zonal_wavenumbers(), nb_fields, spfield.data<double>(), spec_coeff_stride,
+                                spec_field_stride, gpfield.data<double>(), gp_point_stride, gp_field_stride );
 }
 
 // --------------------------------------------------------------------------------------------------------------------
 
 void TransLocal::invtrans( const FieldSet& spfields, FieldSet& gpfields, const eckit::Configuration& config ) const {
-    NOTIMP;
+    ASSERT( spfields.size() == gpfields.size() );
+    for ( size_t f = 0; f < spfields.size(); ++f ) {
+        invtrans( spfields[f], gpfields[f], config );
+    }
 }
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -128,21 +156,14 @@ void TransLocal::invtrans( const int nb_scalar_fields, const double scalar_spect
     invtrans_uv( truncation_, nb_scalar_fields, 0, scalar_spectra, gp_fields, config );
 }
 
-void gp_transpose( const int nb_size, const int nb_fields, const double gp_tmp[], double gp_fields[] ) {
-    for ( int jgp = 0; jgp < nb_size; jgp++ ) {
-        for ( int jfld = 0; jfld < nb_fields; jfld++ ) {
-            gp_fields[jfld * nb_size + jgp] = gp_tmp[jgp * nb_fields + jfld];
-        }
-    }
-}
-
 //-----------------------------------------------------------------------------
 // Routine to compute the spectral transform by using a local Fourier
 // transformation
 // for a grid (same latitude for all longitudes, allows to compute Legendre
 // functions
 // once for all longitudes). U and v components are divided by cos(latitude) for
-// nb_vordiv_fields > 0.
+// nb_vordiv_fields > 0. Latitudes (or points for unstructured grids) are
+// distributed over OpenMP threads.
 //
 // Author:
 // Andreas Mueller *ECMWF*
@@ -155,72 +176,186 @@ void TransLocal::invtrans_uv( const int truncation, const int nb_scalar_fields,
 
         // Depending on "precompute_legendre_", we have to compute the
         // legendre polynomials for every latitute
-        std::vector<double> recomputed_legendre_;
-
-        auto legPol = [&]( double lat, int j ) -> const double* {
+        auto legPol = [&]( double lat, int j, std::vector<double>& recomputed_legendre ) -> const double* {
             if ( precompute_ ) { return legendre_data( j ); }
             else {
-                recomputed_legendre_.resize( legendre_size( truncation ) );
-                compute_legendre_polynomials( truncation, lat, recomputed_legendre_.data() );
-                return recomputed_legendre_.data();
+                recomputed_legendre.resize( legendre_size( truncation ) );
+                compute_legendre_polynomials( truncation, lat, recomputed_legendre.data() );
+                return recomputed_legendre.data();
             }
         };
 
-        // Temporary storage for legendre space
-        std::vector<double> legReal( nb_fields * ( truncation + 1 ) );
-        std::vector<double> legImag( nb_fields * ( truncation + 1 ) );
-        std::vector<double> gp_tmp( nb_fields * grid_.size(), 0. );
+        // Results are written directly in gp_fields, where jfld is the slowest index.
+        // Every row (or point) writes its own gridpoints, so the output does not depend on the number of threads.
+        const int nb_gp = grid_.size();
 
         // Transform
         if ( grid::StructuredGrid g = grid_ ) {
             ATLAS_TRACE( "invtrans_uv structured" );
-            int idx = 0;
+            std::vector<int> row_begin( g.ny() + 1, 0 );
             for ( size_t j = 0; j < g.ny(); ++j ) {
-                double lat = g.y( j ) * util::Constants::degreesToRadians();
-                double trcFT =
-                    fourier_truncation( truncation, g.nx( j ), g.nxmax(), g.ny(), lat, grid::RegularGrid( grid_ ) );
-
-                // Legendre transform:
-                invtrans_legendre( truncation, trcFT, truncation_ + 1, legPol( lat, j ), nb_fields, scalar_spectra,
-                                   legReal.data(), legImag.data() );
-
-                // Fourier transform:
-                for ( size_t i = 0; i < g.nx( j ); ++i ) {
-                    double lon = g.x( i, j ) * util::Constants::degreesToRadians();
-                    invtrans_fourier( trcFT, lon, nb_fields, legReal.data(), legImag.data(),
-                                      gp_tmp.data() + ( nb_fields * idx ) );
-                    for ( int jfld = 0; jfld < nb_vordiv_fields; ++jfld ) {
-                        gp_tmp[nb_fields * idx + jfld] /= std::cos( lat );
+                row_begin[j + 1] = row_begin[j] + g.nx( j );
+            }
+            const bool regular = grid::RegularGrid( grid_ );
+
+            atlas_omp_parallel {
+                // Temporary storage for legendre space, per thread
+                std::vector<double> recomputed_legendre;
+                std::vector<double> legReal( nb_fields * ( truncation + 1 ) );
+                std::vector<double> legImag( nb_fields * ( truncation + 1 ) );
+
+                // Rows of reduced grids differ in length and Fourier truncation, so they are scheduled dynamically
+                atlas_omp_pragma( omp for schedule( dynamic, 1 ) )
+                for ( size_t j = 0; j < g.ny(); ++j ) {
+                    double lat   = g.y( j ) * util::Constants::degreesToRadians();
+                    double trcFT = fourier_truncation( truncation, g.nx( j ), g.nxmax(), g.ny(), lat, regular );
+
+                    // Legendre transform:
+                    invtrans_legendre( truncation, trcFT, truncation_ + 1, legPol( lat, j, recomputed_legendre ),
+                                       nb_fields, scalar_spectra, legReal.data(), legImag.data() );
+
+                    // Fourier transform:
+                    const double coslat = std::cos( lat );
+                    int idx             = row_begin[j];
+                    for ( size_t i = 0; i < g.nx( j ); ++i, ++idx ) {
+                        double lon = g.x( i, j ) * util::Constants::degreesToRadians();
+                        invtrans_fourier( trcFT, lon, nb_fields, legReal.data(), legImag.data(), gp_fields + idx,
+                                          nb_gp );
+                        for ( int jfld = 0; jfld < nb_vordiv_fields; ++jfld ) {
+                            gp_fields[nb_gp * jfld + idx] /= coslat;
+                        }
                     }
-                    ++idx;
                 }
             }
         }
         else {
             ATLAS_TRACE( "invtrans_uv unstructured" );
-            int idx = 0;
-            for ( PointXY p : grid_.xy() ) {
-                double lon   = p.x() * util::Constants::degreesToRadians();
-                double lat   = p.y() * util::Constants::degreesToRadians();
-                double trcFT = truncation;
-
-                // Legendre transform:
-                invtrans_legendre( truncation, trcFT, truncation_ + 1, legPol( lat, idx ), nb_fields, scalar_spectra,
-                                   legReal.data(), legImag.data() );
-
-                // Fourier transform:
-                invtrans_fourier( trcFT, lon, nb_fields, legReal.data(), legImag.data(),
-                                  gp_tmp.data() + ( nb_fields * idx ) );
-                for ( int jfld = 0; jfld < nb_vordiv_fields; ++jfld ) {
-                    gp_tmp[nb_fields * idx + jfld] /= std::cos( lat );
+            std::vector<double> xy( 2 * nb_gp );
+            grid_.fill_xy( xy.data() );
+
+            atlas_omp_parallel {
+                // Temporary storage for legendre space, per thread
+                std::vector<double> recomputed_legendre;
+                std::vector<double> legReal( nb_fields * ( truncation + 1 ) );
+                std::vector<double> legImag( nb_fields * ( truncation + 1 ) );
+
+                atlas_omp_for( int idx = 0; idx < nb_gp; ++idx ) {
+                    double lon   = xy[2 * idx + 0] * util::Constants::degreesToRadians();
+                    double lat   = xy[2 * idx + 1] * util::Constants::degreesToRadians();
+                    double trcFT = truncation;
+
+                    // Legendre transform:
+                    invtrans_legendre( truncation, trcFT, truncation_ + 1, legPol( lat, idx, recomputed_legendre ),
+                                       nb_fields, scalar_spectra, legReal.data(), legImag.data() );
+
+                    // Fourier transform:
+                    invtrans_fourier( trcFT, lon, nb_fields, legReal.data(), legImag.data(), gp_fields + idx, nb_gp );
+                    for ( int jfld = 0; jfld < nb_vordiv_fields; ++jfld ) {
+                        gp_fields[nb_gp * jfld + idx] /= std::cos( lat );
+                    }
                 }
-                ++idx;
             }
         }
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
 
-        // transpose result (gp_tmp: jfld is fastest index. gp_fields: jfld needs to
-        // be slowest index)
-        gp_transpose( grid_.size(), nb_fields, gp_tmp.data(), gp_fields );
+// Inverse transform of spectral coefficients distributed by zonal wavenumber, see functionspace::Spectral.
+// Each task computes the Legendre transform of its own zonal wavenumbers for all latitudes; these partial
+// results are summed over tasks, after which every task completes the Fourier transform on the full grid.
+void TransLocal::invtrans_zonal_wavenumbers( const std::vector<int>& zonal_wavenumbers, const int nb_fields,
+                                             const double spectra[], const size_t spec_coeff_stride,
+                                             const size_t spec_field_stride, double gp_fields[],
+                                             const size_t gp_point_stride, const size_t gp_field_stride ) const {
+    const size_t trcLP = truncation_ + 1;  // truncation of (precomputed) Legendre polynomials
+    auto legendre_offset = [&]( size_t m ) { return m * ( trcLP + 1 ) - ( m * ( m - 1 ) ) / 2; };
+
+    // Latitudes ("rows") on which the Legendre transform is computed
+    grid::StructuredGrid g( grid_ );
+    const bool structured = g && not grid_.projection();
+    std::vector<double> lat;
+    std::vector<double> lon;
+    std::vector<int> trcFT;
+    if ( structured ) {
+        lat.resize( g.ny() );
+        trcFT.resize( g.ny() );
+        for ( size_t j = 0; j < g.ny(); ++j ) {
+            lat[j]   = g.y( j ) * util::Constants::degreesToRadians();
+            trcFT[j] =
+                fourier_truncation( truncation_, g.nx( j ), g.nxmax(), g.ny(), lat[j], grid::RegularGrid( grid_ ) );
+        }
+    }
+    else {
+        std::vector<double> xy( 2 * grid_.size() );
+        grid_.fill_xy( xy.data() );
+        lat.resize( grid_.size() );
+        lon.resize( grid_.size() );
+        for ( size_t n = 0; n < grid_.size(); ++n ) {
+            lon[n] = xy[2 * n] * util::Constants::degreesToRadians();
+            lat[n] = xy[2 * n + 1] * util::Constants::degreesToRadians();
+        }
+        trcFT.assign( grid_.size(), truncation_ );
+    }
+    const size_t nb_rows  = lat.size();
+    const size_t leg_size = ( truncation_ + 1 ) * nb_fields;  // per row, for real and for imaginary part
+
+    std::vector<double> leg( 2 * leg_size * nb_rows, 0. );
+    ATLAS_TRACE_SCOPE( "Legendre" ) {
+        // The cost of a row depends on its Fourier truncation, so rows are scheduled dynamically
+        atlas_omp_pragma( omp parallel for schedule( dynamic, 1 ) )
+        for ( size_t j = 0; j < nb_rows; ++j ) {
+            std::vector<double> recomputed_legendre;
+            const double* legpol;
+            if ( precompute_ ) { legpol = legendre_data( j ); }
+            else {
+                recomputed_legendre.resize( legendre_size( trcLP ) );
+                compute_legendre_polynomials( trcLP, lat[j], recomputed_legendre.data() );
+                legpol = recomputed_legendre.data();
+            }
+            double* leg_real = leg.data() + 2 * leg_size * j;
+            double* leg_imag = leg_real + leg_size;
+            size_t offset    = 0;
+            for ( int m : zonal_wavenumbers ) {
+                if ( m <= trcFT[j] ) {
+                    invtrans_legendre_m( truncation_, m, legpol + legendre_offset( m ), nb_fields,
+                                         spectra + offset * spec_coeff_stride, leg_real + m * nb_fields,
+                                         leg_imag + m * nb_fields, spec_coeff_stride, spec_field_stride );
+                }
+                offset += 2 * ( truncation_ + 1 - m );
+            }
+        }
+    }
+
+    if ( zonal_wavenumbers.size() < size_t( truncation_ + 1 ) ) {
+        ATLAS_TRACE_MPI( ALLREDUCE ) { mpi::comm().allReduceInPlace( leg.data(), leg.size(), eckit::mpi::sum() ); }
+    }
+
+    ATLAS_TRACE_SCOPE( "Fourier" ) {
+        if ( structured ) {
+            std::vector<size_t> begin( g.ny(), 0 );
+            for ( size_t j = 1; j < g.ny(); ++j ) {
+                begin[j] = begin[j - 1] + g.nx( j - 1 );
+            }
+            atlas_omp_pragma( omp parallel for schedule( dynamic, 1 ) )
+            for ( size_t j = 0; j < g.ny(); ++j ) {
+                const double* leg_real = leg.data() + 2 * leg_size * j;
+                const double* leg_imag = leg_real + leg_size;
+                for ( size_t i = 0; i < g.nx( j ); ++i ) {
+                    const double lon_i = g.x( i, j ) * util::Constants::degreesToRadians();
+                    invtrans_fourier( trcFT[j], lon_i, nb_fields, leg_real, leg_imag,
+                                      gp_fields + gp_point_stride * ( begin[j] + i ), gp_field_stride );
+                }
+            }
+        }
+        else {
+            atlas_omp_parallel_for( size_t j = 0; j < nb_rows; ++j ) {
+                const double* leg_real = leg.data() + 2 * leg_size * j;
+                const double* leg_imag = leg_real + leg_size;
+                invtrans_fourier( trcFT[j], lon[j], nb_fields, leg_real, leg_imag, gp_fields + gp_point_stride * j,
+                                  gp_field_stride );
+            }
+        }
     }
 }
 
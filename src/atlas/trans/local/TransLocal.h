@@ -36,9 +36,8 @@ namespace trans {
 /// Optimisations are present for structured grids
 /// For global grids, please consider using TransIFS instead.
 ///
-/// @todo:
-///  - support multiple fields
-///  - support atlas::Field and atlas::FieldSet based on function spaces
+/// Fields of a functionspace::Spectral may be distributed over tasks by zonal wavenumber; each task then
+/// computes the Legendre transform of its own zonal wavenumbers. The grid-point result is not distributed.
 ///
 /// @note: Direct transforms are not implemented and cannot be unless
 ///        the grid is global. There are no plans to support this at the moment.
@@ -70,6 +69,10 @@ public:
                                        const eckit::Configuration& = util::NoConfig() ) const override;
 
     // -- IFS style API --
+    // Spectra are global, with spectralCoefficients() coefficients per field, on every task, and are not reduced
+    // over tasks. Note that without the trans library, functionspace::Spectral::nb_spectral_coefficients() is the
+    // count on this task only when running on more than one task; such distributed spectra must be transformed
+    // with invtrans( const Field&, Field& ), or gathered first.
 
     virtual void invtrans( const int nb_scalar_fields, const double scalar_spectra[], const int nb_vordiv_fields,
                            const double vorticity_spectra[], const double divergence_spectra[], double gp_fields[],
@@ -107,6 +110,13 @@ private:
                       const double scalar_spectra[], double gp_fields[],
                       const eckit::Configuration& = util::NoConfig() ) const;
 
+    // spectra[ coeff * spec_coeff_stride + field * spec_field_stride ]
+    // gp_fields[ point * gp_point_stride + field * gp_field_stride ]
+    void invtrans_zonal_wavenumbers( const std::vector<int>& zonal_wavenumbers, const int nb_fields,
+                                     const double spectra[], const size_t spec_coeff_stride,
+                                     const size_t spec_field_stride, double gp_fields[], const size_t gp_point_stride,
+                                     const size_t gp_field_stride ) const;
+
 private:
     Grid grid_;
     int truncation_;
@@ -1,11 +1,14 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 namespace atlas {
 namespace util {
 
-typedef unsigned long checksum_t;
+typedef uint64_t checksum_t;
 
 checksum_t checksum( const int values[], size_t size );
 checksum_t checksum( const long values[], size_t size );
@@ -13,5 +16,42 @@ checksum_t checksum( const float values[], size_t size );
 checksum_t checksum( const double values[], size_t size );
 checksum_t checksum( const checksum_t values[], size_t size );
 
+//------------------------------------------------------------------------------------------------------
+
+/// @brief Fast 64-bit mixing function with full avalanche (finaliser of splitmix64)
+inline checksum_t mix64( checksum_t x ) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+namespace detail {
+template <typename T>
+inline checksum_t bits( const T& value ) {
+    static_assert( sizeof( T ) == 4 || sizeof( T ) == 8, "Only 32-bit and 64-bit types can be hashed" );
+    typename std::conditional<sizeof( T ) == 4, uint32_t, uint64_t>::type b;
+    std::memcpy( &b, &value, sizeof( T ) );
+    return b;
+}
+}  // namespace detail
+
+/// @brief Hash of the values of one point, identified by a key such as its global index
+///
+/// Every value is hashed independently from its bit pattern, its position within the point and the key,
+/// so the loop vectorises. Hashes of different points are meant to be summed (modulo 2^64): the sum
+/// does not depend on the order in which points are visited, nor on how they are distributed.
+template <typename T>
+inline checksum_t hash( checksum_t key, const T values[], size_t size ) {
+    const checksum_t seed = mix64( key + 0x9e3779b97f4a7c15ULL );
+    checksum_t h          = 0;
+    for ( size_t j = 0; j < size; ++j ) {
+        h += mix64( detail::bits( values[j] ) ^ ( seed + j * 0x9e3779b97f4a7c15ULL ) );
+    }
+    return h;
+}
+
 }  // namespace util
 }  // namespace atlas
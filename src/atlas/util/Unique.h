@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 #include "atlas/array/ArrayView.h"
@@ -21,6 +22,7 @@
 #include "atlas/mesh/Connectivity.h"
 #include "atlas/mesh/Mesh.h"
 #include "atlas/mesh/Nodes.h"
+#include "atlas/parallel/omp/omp.h"
 #include "atlas/util/CoordinateEnums.h"
 #include "atlas/util/LonLatMicroDeg.h"
 #include "atlas/util/MicroDeg.h"
@@ -57,6 +59,19 @@ uidx_t unique_lonlat( const array::LocalView<double, 1>& lonlat );
 /// @return uidx_t Return type depends on ATLAS_BITS_GLOBAL [32/64] bits
 uidx_t unique_lonlat( const double elem_lonlat[], size_t npts );
 
+/// @brief Compute unique positive indices of many points in microdegrees at once.
+/// coordinates of point n are stored at lonlat[ n*stride ] and lonlat[ n*stride + 1 ]
+/// uid[n] is identical to unique_lonlat_microdeg( &lonlat[ n*stride ] )
+template <typename UID>
+void unique_lonlat_microdeg_points( const int lonlat[], size_t npts, UID uid[], size_t stride = 2 );
+
+/// @brief Compute unique positive indices of many points in degrees at once.
+/// coordinates are stored in order:
+/// [ x1, y1,   x2, y2,   ... ,   xn, yn ]
+/// uid[n] is identical to unique_lonlat( xn, yn )
+template <typename UID>
+void unique_lonlat_points( const double lonlat[], size_t npts, UID uid[] );
+
 /// @brief Compute unique positive index for a element
 /// This class is a functor initialised with the nodes
 class UniqueLonLat {
@@ -85,6 +100,16 @@ public:
     /// @return uidx_t Return type depends on ATLAS_BITS_GLOBAL [32/64] bits
     uidx_t operator()( const int elem_nodes[], size_t npts ) const;
 
+    /// @brief Compute unique positive indices of the nodes in range [begin,end)
+    /// uid[n-begin] is identical to operator()(n)
+    template <typename UID>
+    void operator()( size_t begin, size_t end, UID uid[] ) const;
+
+    /// @brief Compute unique positive indices of the elements in range [begin,end)
+    /// of a connectivity table. uid[e-begin] is identical to operator()(elem_nodes.row(e))
+    template <typename Connectivity, typename UID>
+    void operator()( const Connectivity& elem_nodes, size_t begin, size_t end, UID uid[] ) const;
+
     /// @brief update the internally cached lonlat view if the field has changed
     void update();
 
@@ -142,6 +167,38 @@ template <>
 inline long uniqueT<long>( const int lon, const int lat ) {
     return unique64( lon, lat );
 }
+
+/// @brief Compute unique ids of n points, with coordinates in degrees given by
+/// functor coordinates(i,crd). Points are processed in blocks, in parallel. Within a block
+/// the conversion to microdegrees and the integer bit mixing are separate loops without calls,
+/// so that the compiler can vectorise them.
+template <typename Coordinates, typename UID>
+inline void unique_lonlat_blocks( size_t n, const Coordinates& coordinates, UID uid[] ) {
+    constexpr size_t block_size = 256;
+    const size_t nb_blocks      = ( n + block_size - 1 ) / block_size;
+    atlas_omp_parallel_for( size_t jblock = 0; jblock < nb_blocks; ++jblock ) {
+        const size_t begin = jblock * block_size;
+        const size_t size  = std::min( block_size, n - begin );
+        double lon[block_size];
+        double lat[block_size];
+        int lon_microdeg[block_size];
+        int lat_microdeg[block_size];
+        for ( size_t j = 0; j < size; ++j ) {
+            double crd[2];
+            coordinates( begin + j, crd );
+            lon[j] = crd[LON];
+            lat[j] = crd[LAT];
+        }
+        for ( size_t j = 0; j < size; ++j ) {
+            lon_microdeg[j] = microdeg( lon[j] );
+            lat_microdeg[j] = microdeg( lat[j] );
+        }
+        for ( size_t j = 0; j < size; ++j ) {
+            uid[begin + j] = uniqueT<uidx_t>( lon_microdeg[j], lat_microdeg[j] );
+        }
+    }
+}
+
 }  // namespace detail
 
 inline uidx_t unique_lonlat_microdeg( const int lon, const int lat ) {
@@ -186,6 +243,23 @@ inline uidx_t unique_lonlat( const double elem_lonlat[], size_t npts ) {
     //  );
 }
 
+template <typename UID>
+inline void unique_lonlat_microdeg_points( const int lonlat[], size_t npts, UID uid[], size_t stride ) {
+    atlas_omp_parallel_for( size_t n = 0; n < npts; ++n ) {
+        uid[n] = detail::uniqueT<uidx_t>( lonlat[n * stride + LON], lonlat[n * stride + LAT] );
+    }
+}
+
+template <typename UID>
+inline void unique_lonlat_points( const double lonlat[], size_t npts, UID uid[] ) {
+    detail::unique_lonlat_blocks( npts,
+                                  [lonlat]( size_t n, double crd[] ) {
+                                      crd[LON] = lonlat[n * 2 + LON];
+                                      crd[LAT] = lonlat[n * 2 + LAT];
+                                  },
+                                  uid );
+}
+
 inline UniqueLonLat::UniqueLonLat( const Mesh& mesh ) :
     nodes( &mesh.nodes() ),
     xy( array::make_view<double, 2>( nodes->xy() ) ) {
@@ -239,6 +313,36 @@ inline uidx_t UniqueLonLat::operator()( const int elem_nodes[], size_t npts ) co
     //  return detail::unique32( microdeg(centroid[XX]), microdeg(centroid[YY]) );
 }
 
+template <typename UID>
+inline void UniqueLonLat::operator()( size_t begin, size_t end, UID uid[] ) const {
+    const array::ArrayView<double, 2>& xy = this->xy;
+    detail::unique_lonlat_blocks( end - begin,
+                                  [&xy, begin]( size_t n, double crd[] ) {
+                                      crd[XX] = xy( begin + n, XX );
+                                      crd[YY] = xy( begin + n, YY );
+                                  },
+                                  uid );
+}
+
+template <typename Connectivity, typename UID>
+inline void UniqueLonLat::operator()( const Connectivity& elem_nodes, size_t begin, size_t end, UID uid[] ) const {
+    const array::ArrayView<double, 2>& xy = this->xy;
+    detail::unique_lonlat_blocks( end - begin,
+                                  [&xy, &elem_nodes, begin]( size_t n, double centroid[] ) {
+                                      const size_t elem = begin + n;
+                                      const size_t npts = elem_nodes.cols( elem );
+                                      centroid[XX]      = 0.;
+                                      centroid[YY]      = 0.;
+                                      for ( size_t jnode = 0; jnode < npts; ++jnode ) {
+                                          centroid[XX] += xy( elem_nodes( elem, jnode ), XX );
+                                          centroid[YY] += xy( elem_nodes( elem, jnode ), YY );
+                                      }
+                                      centroid[XX] /= static_cast<double>( npts );
+                                      centroid[YY] /= static_cast<double>( npts );
+                                  },
+                                  uid );
+}
+
 inline void UniqueLonLat::update() {
     xy = array::make_view<double, 2>( nodes->xy() );
 }
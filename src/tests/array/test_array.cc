@@ -8,10 +8,14 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
+
 #include "eckit/memory/SharedPtr.h"
 
 #include "atlas/array.h"
+#include "atlas/array/Allocator.h"
 #include "atlas/array/MakeView.h"
+#include "atlas/array/native/NativeMemory.h"
 #include "atlas/library/config.h"
 #include "tests/AtlasTestEnvironment.h"
 
@@ -416,6 +420,63 @@ CASE( "test_insert" ) {
     delete ds;
 }
 
+#if !ATLAS_HAVE_GRIDTOOLS_STORAGE
+CASE( "test_reserve" ) {
+    Array* ds = Array::create<int>( 4, 3 );
+    EXPECT( ds->capacity() == 4 );
+    {
+        auto hv = make_host_view<int, 2>( *ds );
+        for ( size_t j = 0; j < 4; ++j ) {
+            for ( size_t k = 0; k < 3; ++k ) {
+                hv( j, k ) = 10 * j + k;
+            }
+        }
+    }
+
+    ds->reserve( 10 );
+    EXPECT( ds->capacity() == 10 );
+    EXPECT( ds->shape( 0 ) == 4 );
+    const void* storage = ds->storage();
+
+    // Growing within capacity does not reallocate
+    ds->resize( 6, 3 );
+    ds->insert( 1, 2 );
+    EXPECT( ds->storage() == storage );
+    EXPECT( ds->shape( 0 ) == 8 );
+    {
+        auto hv = make_host_view<int, 2>( *ds );
+        EXPECT( hv( 0, 2 ) == 2 );
+        EXPECT( hv( 3, 1 ) == 11 );
+        EXPECT( hv( 5, 2 ) == 32 );
+        // Inserted rows are zero, not copies of the shifted rows
+        for ( size_t j = 1; j < 3; ++j ) {
+            for ( size_t k = 0; k < 3; ++k ) {
+                EXPECT( hv( j, k ) == 0 );
+            }
+        }
+    }
+
+    // Growing beyond capacity grows geometrically
+    ds->resize( 11, 3 );
+    EXPECT( ds->capacity() == 15 );
+    EXPECT( ds->storage() != storage );
+    {
+        auto hv = make_host_view<int, 2>( *ds );
+        EXPECT( hv( 0, 2 ) == 2 );
+        EXPECT( hv( 5, 2 ) == 32 );
+    }
+
+    // Changing other dimensions reallocates exactly
+    ds->resize( 11, 4 );
+    EXPECT( ds->capacity() == 11 );
+    {
+        auto hv = make_host_view<int, 2>( *ds );
+        EXPECT( hv( 5, 2 ) == 32 );
+    }
+    delete ds;
+}
+#endif
+
 CASE( "test_insert_throw" ) {
     Array* ds = Array::create<double>( 7, 5, 8 );
 
@@ -578,6 +639,74 @@ CASE( "test_acc_map" ) {
     }
 }
 
+#if !ATLAS_HAVE_GRIDTOOLS_STORAGE
+CASE( "test_aligned_initialised" ) {
+    for ( size_t size : {1ul, 7ul, 100000ul} ) {
+        Array* ds = Array::create<double>( size, 3 );
+        EXPECT( reinterpret_cast<size_t>( ds->storage() ) % native::alignment() == 0 );
+        auto view     = make_host_view<double, 2>( *ds );
+        bool all_zero = true;
+        for ( size_t j = 0; j < size; ++j ) {
+            for ( size_t k = 0; k < 3; ++k ) {
+                all_zero = all_zero && view( j, k ) == 0.;
+            }
+        }
+        EXPECT( all_zero );
+        delete ds;
+    }
+}
+
+CASE( "test_pool_allocator" ) {
+    Allocator& pool = Allocator::pool();
+    Allocator::release();
+
+    void* p1 = pool.allocate( 1000 );
+    EXPECT( reinterpret_cast<size_t>( p1 ) % native::alignment() == 0 );
+    std::fill_n( static_cast<char*>( p1 ), 1000, 1 );
+    pool.deallocate( p1, 1000 );
+
+    // Same size class (1024 bytes) is served from cache
+    size_t hits = pool.statistics().hits;
+    void* p2    = pool.allocate( 900 );
+    EXPECT( p2 == p1 );
+    EXPECT( pool.statistics().hits == hits + 1 );
+    if ( native::initialise() ) {
+        // Data of the previous owner does not leak into the reused block
+        EXPECT( std::all_of( static_cast<char*>( p2 ), static_cast<char*>( p2 ) + 900,
+                             []( char c ) { return c == 0; } ) );
+    }
+    pool.deallocate( p2, 900 );
+
+    {
+        ScopedAllocator scope( pool );
+        Array* ds = Array::create<double>( 128ul );
+        EXPECT( ds->storage() == p1 );
+        delete ds;
+    }
+
+    Allocator::release();
+    EXPECT( pool.statistics().bytes_cached == 0 );
+}
+#endif
+
+CASE( "test_arena" ) {
+    size_t in_use = Allocator::pool().statistics().bytes_in_use;
+    {
+        Arena arena( 1024, Allocator::pool() );
+        double* a = arena.allocate<double>( 3 );
+        double* b = arena.allocate<double>( 5 );
+        EXPECT( reinterpret_cast<size_t>( a ) % native::alignment() == 0 );
+        EXPECT( reinterpret_cast<char*>( b ) - reinterpret_cast<char*>( a ) == native::alignment() );
+
+        // Larger than a block
+        double* c = arena.allocate<double>( 1000 );
+        EXPECT( c != nullptr );
+        EXPECT( arena.size() == 2 * native::alignment() + 1000 * sizeof( double ) );
+        EXPECT( Allocator::pool().statistics().bytes_in_use > in_use );
+    }
+    EXPECT( Allocator::pool().statistics().bytes_in_use == in_use );
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
@@ -8,18 +8,24 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <cmath>
+
 #include "eckit/memory/ScopedPtr.h"
 #include "eckit/types/Types.h"
 
 #include "atlas/array/ArrayView.h"
 #include "atlas/array/MakeView.h"
 #include "atlas/field/Field.h"
+#include "atlas/field/FieldSet.h"
 #include "atlas/functionspace/NodeColumns.h"
 #include "atlas/functionspace/Spectral.h"
 #include "atlas/grid/Grid.h"
 #include "atlas/library/Library.h"
+#include "atlas/mesh/HybridElements.h"
+#include "atlas/mesh/IsGhostNode.h"
 #include "atlas/mesh/Mesh.h"
 #include "atlas/mesh/Nodes.h"
+#include "atlas/mesh/actions/BuildEdges.h"
 #include "atlas/meshgenerator/StructuredMeshGenerator.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "atlas/trans/Trans.h"
@@ -55,6 +61,188 @@ CASE( "test_functionspace_NodeColumns_no_halo" ) {
     }
 }
 
+CASE( "test_functionspace_NodeColumns_interior_boundary" ) {
+    Grid grid( "O16" );
+    Mesh mesh = meshgenerator::StructuredMeshGenerator().generate( grid );
+    functionspace::NodeColumns nodes_fs( mesh, option::halo( 2 ) );
+    mesh::actions::build_edges( mesh );
+    mesh::actions::build_pole_edges( mesh );
+
+    mesh::IsGhostNode is_ghost( mesh.nodes() );
+    size_t nb_owned = 0;
+    for ( size_t n = 0; n < nodes_fs.nb_nodes(); ++n ) {
+        if ( !is_ghost( n ) ) ++nb_owned;
+    }
+
+    for ( size_t depth : {1, 2} ) {
+        EXPECT( nodes_fs.interior_nodes( depth ).size() + nodes_fs.boundary_nodes( depth ).size() == nb_owned );
+        EXPECT( nodes_fs.interior_edges( depth ).size() + nodes_fs.boundary_edges( depth ).size() ==
+                mesh.edges().size() );
+        EXPECT( nodes_fs.boundary_nodes( depth ).size() > 0 );
+    }
+    EXPECT( nodes_fs.interior_nodes( 2 ).size() < nodes_fs.interior_nodes( 1 ).size() );
+
+    const mesh::HybridElements::Connectivity& edge_node = mesh.edges().node_connectivity();
+    const mesh::Nodes::Connectivity& node_edge          = mesh.nodes().edge_connectivity();
+    for ( idx_t n : nodes_fs.interior_nodes( 1 ) ) {
+        EXPECT( !is_ghost( n ) );
+        for ( size_t j = 0; j < node_edge.cols( n ); ++j ) {
+            const idx_t e = node_edge( n, j );
+            EXPECT( !is_ghost( edge_node( e, 0 ) ) );
+            EXPECT( !is_ghost( edge_node( e, 1 ) ) );
+        }
+    }
+    for ( idx_t e : nodes_fs.interior_edges( 1 ) ) {
+        EXPECT( !is_ghost( edge_node( e, 0 ) ) );
+        EXPECT( !is_ghost( edge_node( e, 1 ) ) );
+    }
+    for ( idx_t e : nodes_fs.boundary_edges( 1 ) ) {
+        EXPECT( is_ghost( edge_node( e, 0 ) ) || is_ghost( edge_node( e, 1 ) ) );
+    }
+}
+
+CASE( "test_functionspace_NodeColumns_statistics" ) {
+    Grid grid( "O16" );
+    Mesh mesh = meshgenerator::StructuredMeshGenerator().generate( grid );
+    functionspace::NodeColumns nodes_fs( mesh, option::levels( 4 ) );
+
+    auto value = []( gidx_t g, size_t l, size_t j ) { return std::cos( 0.1 * g ) * ( l + 1 ) + j; };
+
+    FieldSet fields;
+    fields.add( nodes_fs.createField<double>( option::name( "scalar" ) ) );
+    fields.add( nodes_fs.createField<double>( option::name( "vector" ) | option::variables( 2 ) ) );
+    fields.add( nodes_fs.createField<int>( option::name( "surface" ) | option::levels( false ) ) );
+
+    mesh::IsGhostNode is_ghost( mesh.nodes() );
+    auto glb_idx = array::make_view<gidx_t, 1>( mesh.nodes().global_index() );
+    auto scalar  = array::make_view<double, 2>( fields[0] );
+    auto vector  = array::make_view<double, 3>( fields[1] );
+    auto surface = array::make_view<int, 1>( fields[2] );
+    for ( size_t n = 0; n < nodes_fs.nb_nodes(); ++n ) {
+        if ( is_ghost( n ) ) continue;
+        for ( size_t l = 0; l < 4; ++l ) {
+            scalar( n, l ) = value( glb_idx( n ), l, 0 );
+            for ( size_t j = 0; j < 2; ++j ) {
+                vector( n, l, j ) = value( glb_idx( n ), l, j );
+            }
+        }
+        surface( n ) = glb_idx( n ) % 7;
+    }
+    nodes_fs.haloExchange( fields );
+
+    std::vector<NodeColumnsStatistics> stats = nodes_fs.statistics( fields );
+    EXPECT( stats.size() == 3 );
+    EXPECT( stats[0].name == "scalar" );
+    EXPECT( stats[1].levels == 4 );
+    EXPECT( stats[1].variables == 2 );
+    EXPECT( stats[2].levels == 1 );
+    EXPECT( stats[2].variables == 1 );
+
+    SECTION( "per level" ) {
+        size_t N;
+        Field sum( "sum", array::make_datatype<double>(), array::make_shape( 4, 2 ) );
+        Field mean( "mean", array::make_datatype<double>(), array::make_shape( 4, 2 ) );
+        Field stddev( "stddev", array::make_datatype<double>(), array::make_shape( 4, 2 ) );
+        Field min( "min", array::make_datatype<double>(), array::make_shape( 4, 2 ) );
+        Field max( "max", array::make_datatype<double>(), array::make_shape( 4, 2 ) );
+        nodes_fs.sumPerLevel( fields[1], sum, N );
+        nodes_fs.meanAndStandardDeviationPerLevel( fields[1], mean, stddev, N );
+        nodes_fs.minimumPerLevel( fields[1], min );
+        nodes_fs.maximumPerLevel( fields[1], max );
+        EXPECT( stats[1].N == N );
+        auto check = [&]( const Field& field, const std::vector<double>& result ) {
+            auto view = array::make_view<double, 2>( field );
+            for ( size_t l = 0; l < 4; ++l ) {
+                for ( size_t j = 0; j < 2; ++j ) {
+                    EXPECT( eckit::types::is_approximately_equal( result[l * 2 + j], view( l, j ), 1.e-10 ) );
+                }
+            }
+        };
+        check( sum, stats[1].sum );
+        check( mean, stats[1].mean );
+        check( stddev, stats[1].stddev );
+        check( min, stats[1].minimum );
+        check( max, stats[1].maximum );
+        for ( size_t k = 0; k < 8; ++k ) {
+            EXPECT( stats[1].minimum[k] == value( stats[1].minimum_glb_idx[k], k / 2, k % 2 ) );
+            EXPECT( stats[1].maximum[k] == value( stats[1].maximum_glb_idx[k], k / 2, k % 2 ) );
+        }
+    }
+
+    SECTION( "over levels" ) {
+        size_t N;
+        double sum, mean, stddev, min, max;
+        gidx_t gidx_max;
+        size_t level_max;
+        nodes_fs.sum( fields[0], sum, N );
+        nodes_fs.meanAndStandardDeviation( fields[0], mean, stddev, N );
+        nodes_fs.minimum( fields[0], min );
+        nodes_fs.maximumAndLocation( fields[0], max, gidx_max, level_max );
+        NodeColumnsStatistics column = stats[0].reduce_levels();
+        EXPECT( column.N == N );
+        EXPECT( eckit::types::is_approximately_equal( column.sum[0], sum, 1.e-10 ) );
+        EXPECT( eckit::types::is_approximately_equal( column.mean[0], mean, 1.e-12 ) );
+        EXPECT( eckit::types::is_approximately_equal( column.stddev[0], stddev, 1.e-12 ) );
+        EXPECT( column.minimum[0] == min );
+        EXPECT( column.maximum[0] == max );
+        EXPECT( column.maximum_level[0] == level_max );
+        EXPECT( column.maximum[0] == value( column.maximum_glb_idx[0], column.maximum_level[0], 0 ) );
+
+        long sumint;
+        int minint;
+        nodes_fs.sum( fields[2], sumint, N );
+        nodes_fs.minimum( fields[2], minint );
+        EXPECT( stats[2].sum[0] == sumint );
+        EXPECT( stats[2].minimum[0] == minint );
+        EXPECT( stats[2].maximum[0] == 6 );
+    }
+
+    SECTION( "selection" ) {
+        NodeColumnsStatistics sums = nodes_fs.statistics( fields[1], NodeColumnsStatistics::SUM );
+        EXPECT( sums.sum == stats[1].sum );
+        EXPECT( sums.mean.empty() );
+        EXPECT( sums.minimum.empty() );
+        EXPECT( sums.minimum_glb_idx.empty() );
+
+        NodeColumnsStatistics stddev = nodes_fs.statistics( fields[1], NodeColumnsStatistics::STDDEV );
+        EXPECT( stddev.sum.empty() );
+        EXPECT( stddev.mean == stats[1].mean );
+        EXPECT( stddev.stddev == stats[1].stddev );
+    }
+
+    SECTION( "large offset" ) {
+        // Small variations on a large offset, compared with a two-pass reference
+        Field offset = nodes_fs.createField<double>( option::name( "offset" ) | option::levels( false ) );
+        auto view    = array::make_view<double, 1>( offset );
+        for ( size_t n = 0; n < nodes_fs.nb_nodes(); ++n ) {
+            view( n ) = 1.e8 + 0.1 * std::cos( 0.1 * glb_idx( n ) );
+        }
+
+        double sum = 0.;
+        size_t N   = 0;
+        for ( size_t n = 0; n < nodes_fs.nb_nodes(); ++n ) {
+            if ( is_ghost( n ) ) continue;
+            sum += view( n );
+            ++N;
+        }
+        mpi::comm().allReduceInPlace( sum, eckit::mpi::sum() );
+        mpi::comm().allReduceInPlace( N, eckit::mpi::sum() );
+        const double mean = sum / N;
+        double sqr        = 0.;
+        for ( size_t n = 0; n < nodes_fs.nb_nodes(); ++n ) {
+            if ( is_ghost( n ) ) continue;
+            sqr += ( view( n ) - mean ) * ( view( n ) - mean );
+        }
+        mpi::comm().allReduceInPlace( sqr, eckit::mpi::sum() );
+        const double stddev = std::sqrt( sqr / N );
+
+        NodeColumnsStatistics result = nodes_fs.statistics( offset, NodeColumnsStatistics::STDDEV );
+        EXPECT( result.N == N );
+        EXPECT( stddev > 0.05 );
+        EXPECT( eckit::types::is_approximately_equal( result.stddev[0], stddev, 1.e-6 * stddev ) );
+    }
+}
+
 CASE( "test_functionspace_NodeColumns" ) {
     // ScopedPtr<grid::Grid> grid( Grid::create("O2") );
 
@@ -473,33 +661,97 @@ CASE( "test_SpectralFunctionSpace" ) {
 
     Spectral spectral_fs( truncation );
 
+    // With more than one task, the coefficients are distributed
+    size_t nspec2 = spectral_fs.nb_spectral_coefficients();
+    size_t total  = nspec2;
+    mpi::comm().allReduceInPlace( total, eckit::mpi::sum() );
+    EXPECT( total == nspec2g );
+    EXPECT( spectral_fs.nb_spectral_coefficients_global() == nspec2g );
+
     Field surface_scalar_field = spectral_fs.createField<double>( option::name( "scalar" ) );
 
     EXPECT( surface_scalar_field.name() == std::string( "scalar" ) );
 
-    EXPECT( surface_scalar_field.size() == nspec2g );
+    EXPECT( surface_scalar_field.size() == nspec2 );
 
     EXPECT( surface_scalar_field.rank() == 1 );
 
     auto surface_scalar = array::make_view<double, 1>( surface_scalar_field );
 
-    EXPECT( surface_scalar.shape( 0 ) == nspec2g );
+    EXPECT( surface_scalar.shape( 0 ) == nspec2 );
 
     Field columns_scalar_field =
         spectral_fs.createField<double>( option::name( "scalar" ) | option::levels( nb_levels ) );
 
     EXPECT( columns_scalar_field.name() == std::string( "scalar" ) );
 
-    EXPECT( columns_scalar_field.size() == nspec2g * nb_levels );
+    EXPECT( columns_scalar_field.size() == nspec2 * nb_levels );
 
     EXPECT( columns_scalar_field.rank() == 2 );
 
     auto columns_scalar = array::make_view<double, 2>( columns_scalar_field );
 
-    EXPECT( columns_scalar.shape( 0 ) == nspec2g );
+    EXPECT( columns_scalar.shape( 0 ) == nspec2 );
     EXPECT( columns_scalar.shape( 1 ) == nb_levels );
 }
 
+CASE( "test_SpectralFunctionSpace_gather_scatter_norm" ) {
+    size_t truncation = 47;
+    size_t nb_levels  = 3;
+    size_t root       = mpi::comm().size() - 1;
+
+    Spectral spectral_fs( truncation, option::levels( nb_levels ) );
+    size_t nspec2g = spectral_fs.nb_spectral_coefficients_global();
+
+    Field global_field = spectral_fs.createField<double>( option::name( "global" ) | option::global( root ) );
+    Field local_field  = spectral_fs.createField<double>( option::name( "local" ) );
+
+    // Expected norm: coefficients with m > 0 count twice
+    std::vector<double> expected_norms( nb_levels, 0. );
+    if ( mpi::comm().rank() == root ) {
+        auto glb = array::make_view<double, 2>( global_field );
+        size_t k = 0;
+        for ( size_t m = 0; m <= truncation; ++m ) {
+            for ( size_t n = m; n <= truncation; ++n ) {
+                for ( size_t imag = 0; imag < 2; ++imag, ++k ) {
+                    for ( size_t jlev = 0; jlev < nb_levels; ++jlev ) {
+                        glb( k, jlev ) = ( m == 0 && imag ) ? 0. : 1. / double( 1 + k + jlev );
+                        expected_norms[jlev] += ( m == 0 ? 1. : 2. ) * glb( k, jlev ) * glb( k, jlev );
+                    }
+                }
+            }
+        }
+        EXPECT( k == nspec2g );
+    }
+
+    spectral_fs.scatter( global_field, local_field );
+
+    std::vector<double> norms;
+    spectral_fs.norm( local_field, norms, root );
+    if ( mpi::comm().rank() == root ) {
+        for ( size_t jlev = 0; jlev < nb_levels; ++jlev ) {
+            EXPECT( eckit::types::is_approximately_equal( norms[jlev], std::sqrt( expected_norms[jlev] ), 1.e-12 ) );
+        }
+    }
+
+    std::string checksum = spectral_fs.checksum( local_field );
+
+    Field gathered_field = spectral_fs.createField<double>( option::name( "gathered" ) | option::global( root ) );
+    spectral_fs.gather( local_field, gathered_field );
+    if ( mpi::comm().rank() == root ) {
+        auto glb      = array::make_view<double, 2>( global_field );
+        auto gathered = array::make_view<double, 2>( gathered_field );
+        for ( size_t k = 0; k < nspec2g; ++k ) {
+            for ( size_t jlev = 0; jlev < nb_levels; ++jlev ) {
+                EXPECT( gathered( k, jlev ) == glb( k, jlev ) );
+            }
+        }
+    }
+
+    if ( local_field.shape( 0 ) ) { array::make_view<double, 2>( local_field )( 0, 0 ) += 1.; }
+    EXPECT( spectral_fs.checksum( local_field ) != checksum );
+}
+
 #if ATLAS_HAVE_TRANS
 
 CASE( "test_SpectralFunctionSpace_trans_dist" ) {
@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <iomanip>
 #include <sstream>
+#include <vector>
 
 #include "eckit/memory/Builder.h"
 #include "eckit/memory/Factory.h"
@@ -137,6 +138,58 @@ CASE( "test_reducedgaussian" ) {
     EXPECT( N640.size() == custom.size() );
 }
 
+CASE( "test_structured_fill_xy_lonlat" ) {
+    Grid::Config projection;
+    projection.set( "type", "rotated_lonlat" );
+    projection.set( "north_pole", std::vector<double>{-176, 40} );
+    Grid::Config config;
+    config.set( "name", "O16" );
+    config.set( "projection", projection );
+
+    for ( StructuredGrid grid : {StructuredGrid( "O16" ), StructuredGrid( config )} ) {
+        std::vector<double> xy( 2 * grid.size() );
+        std::vector<double> lonlat( 2 * grid.size() );
+        grid.fill_xy( xy.data() );
+        grid.fill_lonlat( lonlat.data() );
+
+        size_t n = 0;
+        for ( size_t j = 0; j < grid.ny(); ++j ) {
+            for ( size_t i = 0; i < grid.nx( j ); ++i, ++n ) {
+                PointLonLat p = grid.lonlat( i, j );
+                EXPECT( xy[2 * n + 0] == grid.x( i, j ) );
+                EXPECT( xy[2 * n + 1] == grid.y( j ) );
+                EXPECT( lonlat[2 * n + 0] == p.lon() );
+                EXPECT( lonlat[2 * n + 1] == p.lat() );
+            }
+        }
+        EXPECT( n == grid.size() );
+
+        // Row range starts at the first point of row jbegin
+        const size_t jbegin = 3, jend = 7;
+        size_t offset       = 0;
+        for ( size_t j = 0; j < jbegin; ++j ) {
+            offset += grid.nx( j );
+        }
+        std::vector<double> lonlat_rows( 2 * grid.size() );
+        grid.fill_lonlat( jbegin, jend, lonlat_rows.data() );
+        for ( size_t j = jbegin, k = 0; j < jend; ++j ) {
+            for ( size_t i = 0; i < grid.nx( j ); ++i, ++k ) {
+                EXPECT( lonlat_rows[2 * k + 0] == lonlat[2 * ( offset + k ) + 0] );
+                EXPECT( lonlat_rows[2 * k + 1] == lonlat[2 * ( offset + k ) + 1] );
+            }
+        }
+
+        EXPECT( grid.cached_xy() == xy );
+        EXPECT( grid.cached_lonlat() == lonlat );
+        EXPECT( grid.cached_lonlat().data() == grid.cached_lonlat().data() );
+
+        // Generic Grid interface gives the same result
+        std::vector<double> lonlat_generic( 2 * grid.size() );
+        Grid( grid ).fill_lonlat( lonlat_generic.data() );
+        EXPECT( lonlat_generic == lonlat );
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
@@ -0,0 +1,177 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <cmath>
+
+#include "eckit/types/FloatCompare.h"
+
+#include "atlas/array.h"
+#include "atlas/functionspace.h"
+#include "atlas/functionspace/PointCloud.h"
+#include "atlas/grid.h"
+#include "atlas/interpolation.h"
+#include "atlas/util/CoordinateEnums.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+using namespace eckit;
+using namespace atlas::functionspace;
+using namespace atlas::util;
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+double func( double lon, double lat ) {
+    const double deg = M_PI / 180.;
+    return std::cos( lat * deg ) * std::cos( lon * deg ) + std::sin( lat * deg );
+}
+
+Field source_field( const StructuredColumns& fs ) {
+    Field field = fs.createField<double>( option::name( "source" ) );
+    auto xy     = array::make_view<double, 2>( fs.xy() );
+    auto source = array::make_view<double, 1>( field );
+    for ( size_t n = 0; n < fs.sizeOwned(); ++n ) {
+        source( n ) = func( xy( n, XX ), xy( n, YY ) );
+    }
+    return field;
+}
+
+CASE( "test_interpolation_structured_pointcloud" ) {
+    StructuredColumns fs( Grid( "O32" ), option::halo( 2 ) );
+
+    // Points at the equator, across the periodic boundary and beyond the first and last latitudes.
+    // With several tasks, every task has all points, most of which are interpolated on other tasks.
+    PointCloud pointcloud( {{0., 0.},
+                            {10., 5.},
+                            {135., -30.},
+                            {359.5, 45.},
+                            {-0.5, -45.},
+                            {42., 89.5},
+                            {271., -89.5}} );
+
+    Field field_source = source_field( fs );
+    Field field_target( "target", array::make_datatype<double>(), array::make_shape( pointcloud.size() ) );
+
+    auto types = {std::make_pair( "structured-bilinear", 2.e-3 ), std::make_pair( "structured-bicubic", 5.e-5 )};
+    for ( auto type : types ) {
+        SECTION( type.first ) {
+            Interpolation interpolation( Config( "type", type.first ), fs, pointcloud );
+            interpolation.execute( field_source, field_target );
+
+            auto lonlat = array::make_view<double, 2>( pointcloud.lonlat() );
+            auto target = array::make_view<double, 1>( field_target );
+            for ( size_t j = 0; j < pointcloud.size(); ++j ) {
+                const double check = func( lonlat( j, LON ), lonlat( j, LAT ) );
+                Log::info() << target( j ) << "  " << check << std::endl;
+                EXPECT( eckit::types::is_approximately_equal( target( j ), check, type.second ) );
+            }
+        }
+    }
+}
+
+CASE( "test_interpolation_structured_to_structured" ) {
+    StructuredColumns source( Grid( "O32" ), option::halo( 2 ) );
+    StructuredColumns target( Grid( "F20" ) );
+
+    Field field_source = source_field( source );
+    Field field_target = target.createField<double>( option::name( "target" ) );
+
+    Interpolation interpolation( Config( "type", "structured-bicubic" ), source, target );
+    interpolation.execute( field_source, field_target );
+
+    auto xy     = array::make_view<double, 2>( target.xy() );
+    auto values = array::make_view<double, 1>( field_target );
+    for ( size_t n = 0; n < target.sizeOwned(); ++n ) {
+        EXPECT( eckit::types::is_approximately_equal( values( n ), func( xy( n, XX ), xy( n, YY ) ), 5.e-5 ) );
+    }
+}
+
+CASE( "test_interpolation_structured_levels_strided" ) {
+    StructuredColumns fs( Grid( "O32" ), option::halo( 2 ) );
+    PointCloud pointcloud( {{0., 0.}, {10., 5.}, {135., -30.}, {359.5, 45.}} );
+    const size_t npts = pointcloud.size();
+    const size_t nlev = 3;
+
+    Field field_source = fs.createField<double>( option::name( "source" ) | option::levels( nlev ) );
+    auto xy            = array::make_view<double, 2>( fs.xy() );
+    auto source        = array::make_view<double, 2>( field_source );
+    for ( size_t n = 0; n < fs.sizeOwned(); ++n ) {
+        for ( size_t l = 0; l < nlev; ++l ) {
+            source( n, l ) = ( l + 1 ) * func( xy( n, XX ), xy( n, YY ) );
+        }
+    }
+
+    // Target stored level-major: all points of a level are contiguous
+    std::vector<double> data( npts * nlev );
+    Field field_target( "target", data.data(),
+                        array::ArraySpec( array::make_shape( npts, nlev ), array::make_strides( 1, npts ) ) );
+    Field field_check( "check", array::make_datatype<double>(), array::make_shape( npts ) );
+
+    Interpolation interpolation( Config( "type", "structured-bicubic" ), fs, pointcloud );
+    interpolation.execute( field_source, field_target );
+    interpolation.execute( source_field( fs ), field_check );
+
+    auto check = array::make_view<double, 1>( field_check );
+    for ( size_t l = 0; l < nlev; ++l ) {
+        for ( size_t j = 0; j < npts; ++j ) {
+            EXPECT( eckit::types::is_approximately_equal( data[l * npts + j], ( l + 1 ) * check( j ), 1.e-12 ) );
+        }
+    }
+}
+
+CASE( "test_interpolation_structured_fieldset" ) {
+    StructuredColumns fs( Grid( "O32" ), option::halo( 2 ) );
+    PointCloud pointcloud( {{0., 0.}, {90., 30.}, {180., -60.}, {270., 85.}} );
+
+    FieldSet source;
+    source.add( source_field( fs ) );
+    source.add( fs.createField<double>( option::name( "source_levels" ) | option::levels( 2 ) ) );
+    auto xy     = array::make_view<double, 2>( fs.xy() );
+    auto levels = array::make_view<double, 2>( source[1] );
+    for ( size_t n = 0; n < fs.sizeOwned(); ++n ) {
+        levels( n, 0 ) = func( xy( n, XX ), xy( n, YY ) );
+        levels( n, 1 ) = -func( xy( n, XX ), xy( n, YY ) );
+    }
+
+    FieldSet target;
+    target.add( Field( "target", array::make_datatype<double>(), array::make_shape( pointcloud.size() ) ) );
+    target.add( Field( "target_levels", array::make_datatype<double>(), array::make_shape( pointcloud.size(), 2 ) ) );
+
+    Interpolation interpolation( Config( "type", "structured-bicubic" ), fs, pointcloud );
+    interpolation.execute( source, target );
+
+    auto lonlat        = array::make_view<double, 2>( pointcloud.lonlat() );
+    auto target_single = array::make_view<double, 1>( target[0] );
+    auto target_levels = array::make_view<double, 2>( target[1] );
+    for ( size_t j = 0; j < pointcloud.size(); ++j ) {
+        const double check = func( lonlat( j, LON ), lonlat( j, LAT ) );
+        EXPECT( eckit::types::is_approximately_equal( target_single( j ), check, 5.e-5 ) );
+        EXPECT( eckit::types::is_approximately_equal( target_levels( j, 0 ), check, 5.e-5 ) );
+        EXPECT( eckit::types::is_approximately_equal( target_levels( j, 1 ), -check, 5.e-5 ) );
+    }
+}
+
+CASE( "test_interpolation_structured_halo" ) {
+    StructuredColumns fs( Grid( "O32" ), option::halo( 1 ) );
+    PointCloud pointcloud( {{0., 0.}, {90., 0.}} );
+    EXPECT_NO_THROW( Interpolation( Config( "type", "structured-bilinear" ), fs, pointcloud ) );
+    EXPECT_THROWS_AS( Interpolation( Config( "type", "structured-bicubic" ), fs, pointcloud ), eckit::BadParameter );
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main( int argc, char** argv ) {
+    return atlas::test::run( argc, argv );
+}
@@ -8,9 +8,16 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <fstream>
+#include <string>
+
+#include "atlas/array/MakeView.h"
+#include "atlas/functionspace/NodeColumns.h"
 #include "atlas/mesh/Mesh.h"
+#include "atlas/mesh/Nodes.h"
 #include "atlas/output/Gmsh.h"
 #include "atlas/output/Output.h"
+#include "atlas/parallel/mpi/mpi.h"
 
 #include "tests/TestMeshes.h"
 #include "tests/AtlasTestEnvironment.h"
@@ -30,6 +37,66 @@ CASE( "test_gmsh_output" ) {
 
 //-----------------------------------------------------------------------------
 
+CASE( "test_gmsh_field_output" ) {
+    Mesh mesh = test::generate_mesh( Grid( "O32" ) );
+    functionspace::NodeColumns fs( mesh );
+    Field field  = fs.createField<double>( option::name( "field" ) | option::variables( 2 ) );
+    auto view    = array::make_view<double, 2>( field );
+    auto glb_idx = array::make_view<gidx_t, 1>( mesh.nodes().global_index() );
+    for ( size_t n = 0; n < fs.nb_nodes(); ++n ) {
+        view( n, 0 ) = n;
+        view( n, 1 ) = -double( n );
+    }
+
+    for ( bool binary : {false, true} ) {
+        std::string file = binary ? "test_gmsh_field_output_binary.msh" : "test_gmsh_field_output_ascii.msh";
+        output::Gmsh( file, util::Config( "binary", binary ) ).write( field );
+        std::string path =
+            mpi::comm().size() == 1 ? file : output::GmshFileStream::parallelPathName( file, mpi::comm().rank() );
+        std::ifstream in( path, std::ios::binary );
+        EXPECT( in.good() );
+
+        std::string line;
+        while ( std::getline( in, line ) && line != "$NodeData" ) {}
+        EXPECT( line == "$NodeData" );
+        for ( int j = 0; j < 8; ++j ) {
+            std::getline( in, line );
+        }
+        EXPECT( std::stoul( line ) == fs.nb_nodes() );
+        std::getline( in, line );  // partition
+
+        if ( binary ) {
+            // node number (global index) as int, followed by 3 components in double precision
+            for ( size_t n = 0; n < fs.nb_nodes(); ++n ) {
+                int g;
+                double v[3];
+                in.read( reinterpret_cast<char*>( &g ), sizeof( int ) );
+                in.read( reinterpret_cast<char*>( v ), 3 * sizeof( double ) );
+                EXPECT( g == glb_idx( n ) );
+                EXPECT( v[0] == double( n ) );
+                EXPECT( v[1] == -double( n ) );
+                EXPECT( v[2] == 0. );
+            }
+        }
+        else {
+            for ( size_t n = 0; n < fs.nb_nodes(); ++n ) {
+                long g;
+                double v[3];
+                in >> g >> v[0] >> v[1] >> v[2];
+                EXPECT( g == glb_idx( n ) );
+                EXPECT( v[0] == double( n ) );
+                EXPECT( v[1] == -double( n ) );
+                EXPECT( v[2] == 0. );
+            }
+        }
+        std::getline( in, line );
+        std::getline( in, line );
+        EXPECT( line == "$EndNodeData" );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 }  // namespace test
 }  // namespace atlas
 
@@ -0,0 +1,126 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <utility>
+#include <vector>
+
+#include "atlas/array/ArrayView.h"
+#include "atlas/array/MakeView.h"
+#include "atlas/functionspace/NodeColumns.h"
+#include "atlas/grid/Grid.h"
+#include "atlas/mesh/HybridElements.h"
+#include "atlas/mesh/Mesh.h"
+#include "atlas/mesh/Nodes.h"
+#include "atlas/mesh/actions/BuildEdges.h"
+#include "atlas/meshgenerator/MeshGenerator.h"
+#include "atlas/output/detail/MeshSnapshotIO.h"
+#include "atlas/parallel/mpi/mpi.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+using atlas::output::detail::MeshSnapshotIO;
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+CASE( "test_mesh_snapshot_roundtrip" ) {
+    Grid grid( "O16" );
+    Mesh mesh = MeshGenerator( "structured" ).generate( grid );
+    functionspace::NodeColumns fs( mesh, option::halo( 1 ) );
+    mesh::actions::build_edges( mesh );
+    mesh::actions::build_pole_edges( mesh );
+
+    MeshSnapshotIO::write( "test_mesh_snapshot", mesh );
+    mpi::comm().barrier();
+
+    EXPECT( MeshSnapshotIO::nb_parts( "test_mesh_snapshot" ) == mpi::comm().size() );
+
+    Mesh snapshot = MeshSnapshotIO::read( "test_mesh_snapshot" );
+
+    SECTION( "metadata" ) {
+        EXPECT( snapshot.grid().name() == grid.name() );
+        EXPECT( snapshot.metadata().getInt( "halo" ) == 1 );
+        EXPECT( snapshot.nodes().metadata().getBool( "parallel" ) );
+    }
+
+    SECTION( "nodes" ) {
+        EXPECT( snapshot.nodes().size() == mesh.nodes().size() );
+        EXPECT( snapshot.nodes().nb_fields() == mesh.nodes().nb_fields() );
+        auto xy        = array::make_view<double, 2>( mesh.nodes().xy() );
+        auto xy_s      = array::make_view<double, 2>( snapshot.nodes().xy() );
+        auto glb_idx   = array::make_view<gidx_t, 1>( mesh.nodes().global_index() );
+        auto glb_idx_s = array::make_view<gidx_t, 1>( snapshot.nodes().global_index() );
+        auto ridx      = array::make_view<int, 1>( mesh.nodes().remote_index() );
+        auto ridx_s    = array::make_view<int, 1>( snapshot.nodes().remote_index() );
+        for ( size_t n = 0; n < mesh.nodes().size(); ++n ) {
+            EXPECT( xy_s( n, 0 ) == xy( n, 0 ) );
+            EXPECT( xy_s( n, 1 ) == xy( n, 1 ) );
+            EXPECT( glb_idx_s( n ) == glb_idx( n ) );
+            EXPECT( ridx_s( n ) == ridx( n ) );
+        }
+    }
+
+    SECTION( "elements" ) {
+        for ( auto elements : {std::make_pair( &mesh.cells(), &snapshot.cells() ),
+                               std::make_pair( &mesh.edges(), &snapshot.edges() )} ) {
+            const mesh::HybridElements& orig = *elements.first;
+            const mesh::HybridElements& read = *elements.second;
+            EXPECT( read.size() == orig.size() );
+            EXPECT( read.nb_types() == orig.nb_types() );
+            for ( size_t e = 0; e < orig.size(); ++e ) {
+                EXPECT( read.node_connectivity().cols( e ) == orig.node_connectivity().cols( e ) );
+                for ( size_t n = 0; n < orig.node_connectivity().cols( e ); ++n ) {
+                    EXPECT( read.node_connectivity()( e, n ) == orig.node_connectivity()( e, n ) );
+                }
+            }
+        }
+        EXPECT( snapshot.edges().cell_connectivity().rows() == mesh.edges().cell_connectivity().rows() );
+    }
+
+    SECTION( "functionspace on snapshot does not rebuild halo" ) {
+        // The halo metadata is restored, so that BuildHalo and BuildParallelFields have nothing to do
+        size_t nb_nodes_including_halo = 0;
+        EXPECT( snapshot.metadata().get( "nb_nodes_including_halo[1]", nb_nodes_including_halo ) );
+        EXPECT( nb_nodes_including_halo == snapshot.nodes().size() );
+
+        const size_t nb_nodes = snapshot.nodes().size();
+        auto ridx_s           = array::make_view<int, 1>( snapshot.nodes().remote_index() );
+        auto part_s           = array::make_view<int, 1>( snapshot.nodes().partition() );
+        std::vector<int> ridx( ridx_s.data(), ridx_s.data() + nb_nodes );
+        std::vector<int> part( part_s.data(), part_s.data() + nb_nodes );
+
+        functionspace::NodeColumns fs_s( snapshot, option::halo( 1 ) );
+        EXPECT( fs_s.nb_nodes() == fs.nb_nodes() );
+        EXPECT( snapshot.nodes().size() == nb_nodes );
+        EXPECT( snapshot.metadata().getInt( "halo" ) == 1 );
+        EXPECT( snapshot.metadata().get<size_t>( "nb_nodes_including_halo[1]" ) == nb_nodes_including_halo );
+
+        auto ridx_after = array::make_view<int, 1>( snapshot.nodes().remote_index() );
+        auto part_after = array::make_view<int, 1>( snapshot.nodes().partition() );
+        for ( size_t n = 0; n < nb_nodes; ++n ) {
+            EXPECT( ridx_after( n ) == ridx[n] );
+            EXPECT( part_after( n ) == part[n] );
+        }
+    }
+
+    // Files are written again for every section
+    mpi::comm().barrier();
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main( int argc, char** argv ) {
+    return atlas::test::run( argc, argv );
+}
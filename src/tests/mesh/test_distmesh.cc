@@ -123,6 +123,34 @@ CASE( "test_distribute_t63" ) {
     }
     Log::info() << "]" << std::endl;
 }
+
+//-----------------------------------------------------------------------------
+
+CASE( "test_partition_graph" ) {
+    meshgenerator::StructuredMeshGenerator generate;
+    Mesh m( generate( Grid( "O32" ) ) );
+
+    const Mesh::PartitionGraph& graph = m.partitionGraph();
+    const size_t mpi_size             = mpi::comm().size();
+    const size_t mpi_rank             = mpi::comm().rank();
+    EXPECT( graph.size() == mpi_size );
+
+    auto neighbours = m.nearestNeighbourPartitions();
+    EXPECT( std::is_sorted( neighbours.begin(), neighbours.end() ) );
+    EXPECT( std::find( neighbours.begin(), neighbours.end(), mpi_rank ) == neighbours.end() );
+    EXPECT( neighbours.size() <= graph.maximumNearestNeighbours() );
+    if ( mpi_size > 1 ) { EXPECT( neighbours.size() > 0 ); }
+
+    // The graph must be symmetric
+    eckit::mpi::Buffer<size_t> recv( mpi_size );
+    mpi::comm().allGatherv( neighbours.begin(), neighbours.end(), recv );
+    for ( size_t p : neighbours ) {
+        auto begin = recv.buffer.begin() + recv.displs[p];
+        auto end   = begin + recv.counts[p];
+        EXPECT( std::find( begin, end, mpi_rank ) != end );
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
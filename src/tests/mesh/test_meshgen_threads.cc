@@ -0,0 +1,117 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <vector>
+
+#include "atlas/array/MakeView.h"
+#include "atlas/grid.h"
+#include "atlas/grid/Partitioner.h"
+#include "atlas/mesh/HybridElements.h"
+#include "atlas/mesh/Mesh.h"
+#include "atlas/mesh/Nodes.h"
+#include "atlas/meshgenerator/StructuredMeshGenerator.h"
+#include "atlas/parallel/omp/omp.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+using namespace atlas::meshgenerator;
+using namespace atlas::grid;
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+// Global indices, partitions and ghost flags of nodes, and global indices, partitions and
+// connectivity (as global node indices) of cells, in storage order
+std::vector<gidx_t> signature( const Mesh& mesh ) {
+    std::vector<gidx_t> s;
+
+    const mesh::Nodes& nodes = mesh.nodes();
+    auto node_gidx           = array::make_view<gidx_t, 1>( nodes.global_index() );
+    auto node_part           = array::make_view<int, 1>( nodes.partition() );
+    auto node_ghost          = array::make_view<int, 1>( nodes.ghost() );
+    s.push_back( nodes.size() );
+    for ( size_t n = 0; n < nodes.size(); ++n ) {
+        s.push_back( node_gidx( n ) );
+        s.push_back( node_part( n ) );
+        s.push_back( node_ghost( n ) );
+    }
+
+    const mesh::HybridElements& cells = mesh.cells();
+    auto cell_gidx                    = array::make_view<gidx_t, 1>( cells.global_index() );
+    auto cell_part                    = array::make_view<int, 1>( cells.partition() );
+    const auto& connectivity          = cells.node_connectivity();
+    s.push_back( cells.size() );
+    for ( size_t e = 0; e < cells.size(); ++e ) {
+        s.push_back( cell_gidx( e ) );
+        s.push_back( cell_part( e ) );
+        for ( size_t k = 0; k < connectivity.cols( e ); ++k ) {
+            s.push_back( node_gidx( connectivity( e, k ) ) );
+        }
+    }
+    return s;
+}
+
+gidx_t checksum( const std::vector<gidx_t>& s ) {
+    gidx_t sum = 0;
+    for ( size_t i = 0; i < s.size(); ++i ) {
+        sum = ( 31 * sum + s[i] ) % 1000000007;
+    }
+    return sum;
+}
+
+// Generate the mesh of one part with a single thread and with several threads
+void check_threads( const std::string& gridname, const util::Config& config ) {
+    const int max_threads = atlas_omp_get_max_threads();
+    const size_t nb_parts = 4;
+    Grid grid( gridname );
+    grid::Distribution distribution( Partitioner( "equal_regions", nb_parts ).partition( grid ) );
+
+    for ( size_t part = 0; part < nb_parts; ++part ) {
+        util::Config options( config );
+        options.set( "nb_parts", nb_parts );
+        options.set( "part", part );
+        StructuredMeshGenerator generate( options );
+
+        atlas_omp_set_num_threads( 1 );
+        std::vector<gidx_t> serial = signature( generate( grid, distribution ) );
+
+        atlas_omp_set_num_threads( 4 );
+        std::vector<gidx_t> threaded = signature( generate( grid, distribution ) );
+
+        atlas_omp_set_num_threads( max_threads );
+
+        Log::info() << gridname << " part " << part << " checksum " << checksum( serial ) << " (1 thread), "
+                    << checksum( threaded ) << " (4 threads)" << std::endl;
+        EXPECT( checksum( serial ) == checksum( threaded ) );
+        EXPECT( serial == threaded );
+    }
+}
+
+CASE( "test_structured_meshgenerator_threads" ) {
+    SECTION( "reduced gaussian" ) { check_threads( "O32", util::Config() ); }
+    SECTION( "regular lonlat, triangulated" ) { check_threads( "L48x25", util::Config( "triangulate", true ) ); }
+    SECTION( "3d with poles" ) {
+        util::Config config;
+        config.set( "3d", true );
+        config.set( "include_pole", true );
+        check_threads( "N24", config );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main( int argc, char** argv ) {
+    return atlas::test::run( argc, argv );
+}
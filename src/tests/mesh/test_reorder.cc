@@ -0,0 +1,197 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "atlas/array/ArrayView.h"
+#include "atlas/array/IndexView.h"
+#include "atlas/array/MakeView.h"
+#include "atlas/functionspace/EdgeColumns.h"
+#include "atlas/functionspace/NodeColumns.h"
+#include "atlas/grid/Grid.h"
+#include "atlas/mesh/HybridElements.h"
+#include "atlas/mesh/Mesh.h"
+#include "atlas/mesh/Nodes.h"
+#include "atlas/mesh/actions/BuildEdges.h"
+#include "atlas/mesh/actions/BuildHalo.h"
+#include "atlas/mesh/actions/BuildParallelFields.h"
+#include "atlas/mesh/actions/BuildPeriodicBoundaries.h"
+#include "atlas/mesh/actions/ReorderMesh.h"
+#include "atlas/meshgenerator/MeshGenerator.h"
+#include "atlas/parallel/mpi/mpi.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+Mesh generate_mesh() {
+    Mesh mesh = MeshGenerator( "structured" ).generate( Grid( "O32" ) );
+    mesh::actions::build_nodes_parallel_fields( mesh.nodes() );
+    mesh::actions::build_periodic_boundaries( mesh );
+    mesh::actions::build_halo( mesh, 1 );
+    mesh::actions::build_edges( mesh );
+    mesh::actions::build_pole_edges( mesh );
+    mesh::actions::build_edges_parallel_fields( mesh );
+    mesh::actions::build_node_to_edge_connectivity( mesh );
+    return mesh;
+}
+
+// Nodes identified by global index and coordinates, in sorted order
+std::vector<std::tuple<gidx_t, double, double>> nodes_signature( const Mesh& mesh, size_t begin, size_t end ) {
+    auto glb_idx = array::make_view<gidx_t, 1>( mesh.nodes().global_index() );
+    auto lonlat  = array::make_view<double, 2>( mesh.nodes().lonlat() );
+    std::vector<std::tuple<gidx_t, double, double>> signature;
+    for ( size_t n = begin; n < end; ++n ) {
+        signature.emplace_back( glb_idx( n ), lonlat( n, 0 ), lonlat( n, 1 ) );
+    }
+    std::sort( signature.begin(), signature.end() );
+    return signature;
+}
+
+// Elements identified by the global indices of their nodes, in sorted order
+std::vector<std::vector<gidx_t>> elements_signature( const Mesh& mesh, const mesh::HybridElements& elements ) {
+    auto glb_idx = array::make_view<gidx_t, 1>( mesh.nodes().global_index() );
+    std::vector<std::vector<gidx_t>> signature;
+    for ( size_t e = 0; e < elements.size(); ++e ) {
+        std::vector<gidx_t> element;
+        for ( size_t j = 0; j < elements.node_connectivity().cols( e ); ++j ) {
+            element.push_back( glb_idx( elements.node_connectivity()( e, j ) ) );
+        }
+        signature.push_back( element );
+    }
+    std::sort( signature.begin(), signature.end() );
+    return signature;
+}
+
+// Global index of each node, paired with the global index received from its owner in a halo exchange
+std::vector<std::pair<gidx_t, double>> nodes_halo_exchange( const Mesh& mesh ) {
+    functionspace::NodeColumns fs( mesh );
+    auto glb_idx = array::make_view<gidx_t, 1>( mesh.nodes().global_index() );
+    auto part    = array::make_view<int, 1>( mesh.nodes().partition() );
+    auto ridx    = array::make_indexview<int, 1>( mesh.nodes().remote_index() );
+
+    Field field = fs.createField<double>( option::name( "glb_idx" ) );
+    auto f      = array::make_view<double, 1>( field );
+    for ( size_t n = 0; n < fs.nb_nodes(); ++n ) {
+        bool owned = ( part( n ) == mpi::comm().rank() && ridx( n ) == n );
+        f( n )     = owned ? glb_idx( n ) : -1.;
+    }
+    fs.haloExchange( field );
+
+    std::vector<std::pair<gidx_t, double>> received;
+    for ( size_t n = 0; n < fs.nb_nodes(); ++n ) {
+        received.emplace_back( glb_idx( n ), f( n ) );
+    }
+    std::sort( received.begin(), received.end() );
+    return received;
+}
+
+// Nodes of each edge, paired with the nodes of the edge at its owner received in a halo exchange
+std::vector<std::pair<double, double>> edges_halo_exchange( const Mesh& mesh ) {
+    functionspace::EdgeColumns fs( mesh );
+    auto glb_idx    = array::make_view<gidx_t, 1>( mesh.nodes().global_index() );
+    auto part       = array::make_view<int, 1>( mesh.edges().partition() );
+    auto ridx       = array::make_indexview<int, 1>( mesh.edges().remote_index() );
+    const auto& e2n = mesh.edges().node_connectivity();
+
+    auto edge_id = [&]( size_t e ) {
+        gidx_t g0 = glb_idx( e2n( e, 0 ) );
+        gidx_t g1 = glb_idx( e2n( e, 1 ) );
+        return double( std::min( g0, g1 ) ) * 1.e7 + double( std::max( g0, g1 ) );
+    };
+
+    Field field = fs.createField<double>( option::name( "edge_id" ) );
+    auto f      = array::make_view<double, 1>( field );
+    for ( size_t e = 0; e < fs.nb_edges(); ++e ) {
+        bool owned = ( part( e ) == mpi::comm().rank() && ridx( e ) == e );
+        f( e )     = owned ? edge_id( e ) : -1.;
+    }
+    fs.haloExchange( field );
+
+    std::vector<std::pair<double, double>> received;
+    for ( size_t e = 0; e < fs.nb_edges(); ++e ) {
+        received.emplace_back( edge_id( e ), f( e ) );
+    }
+    std::sort( received.begin(), received.end() );
+    return received;
+}
+
+//-----------------------------------------------------------------------------
+
+CASE( "test_reorder_mesh" ) {
+    Mesh reference = generate_mesh();
+
+    for ( std::string type : {"hilbert", "morton", "reverse_cuthill_mckee"} ) {
+        SECTION( type ) {
+            Mesh mesh = generate_mesh();
+            mesh::actions::reorder_mesh( mesh, type );
+
+            size_t nb_nodes_halo_1;
+            EXPECT( mesh.metadata().get( "nb_nodes_including_halo[1]", nb_nodes_halo_1 ) );
+
+            // Nodes are permuted within each halo level
+            EXPECT( mesh.nodes().size() == reference.nodes().size() );
+            EXPECT( nodes_signature( mesh, 0, nb_nodes_halo_1 ) == nodes_signature( reference, 0, nb_nodes_halo_1 ) );
+            EXPECT( nodes_signature( mesh, 0, mesh.nodes().size() ) ==
+                    nodes_signature( reference, 0, reference.nodes().size() ) );
+
+            // Elements still refer to the same nodes, and keep their element types
+            EXPECT( elements_signature( mesh, mesh.cells() ) == elements_signature( reference, reference.cells() ) );
+            EXPECT( elements_signature( mesh, mesh.edges() ) == elements_signature( reference, reference.edges() ) );
+            for ( size_t t = 0; t < mesh.cells().nb_types(); ++t ) {
+                EXPECT( mesh.cells().elements( t ).size() == reference.cells().elements( t ).size() );
+            }
+
+            // Connectivities are renumbered consistently
+            const auto& e2n = mesh.edges().node_connectivity();
+            const auto& n2e = mesh.nodes().edge_connectivity();
+            for ( size_t n = 0; n < mesh.nodes().size(); ++n ) {
+                for ( size_t j = 0; j < n2e.cols( n ); ++j ) {
+                    const idx_t e = n2e( n, j );
+                    EXPECT( e2n( e, 0 ) == n || e2n( e, 1 ) == n );
+                }
+            }
+            const auto& e2c = mesh.edges().cell_connectivity();
+            const auto& c2n = mesh.cells().node_connectivity();
+            for ( size_t e = 0; e < mesh.edges().size(); ++e ) {
+                for ( size_t j = 0; j < e2c.cols( e ); ++j ) {
+                    const idx_t c = e2c( e, j );
+                    if ( c == e2c.missing_value() ) continue;
+                    size_t shared = 0;
+                    for ( size_t k = 0; k < c2n.cols( c ); ++k ) {
+                        if ( c2n( c, k ) == e2n( e, 0 ) || c2n( c, k ) == e2n( e, 1 ) ) ++shared;
+                    }
+                    EXPECT( shared == 2 );
+                }
+            }
+
+            // Remote indices refer to the new numbering at the owners
+            EXPECT( nodes_halo_exchange( mesh ) == nodes_halo_exchange( reference ) );
+            EXPECT( edges_halo_exchange( mesh ) == edges_halo_exchange( reference ) );
+        }
+    }
+
+    EXPECT_THROWS_AS( mesh::actions::ReorderMesh( "unknown" ), eckit::BadParameter );
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main( int argc, char** argv ) {
+    return atlas::test::run( argc, argv );
+}
@@ -41,6 +41,7 @@ namespace atlas {
 namespace grid {
 namespace spacing {
 namespace gaussian {
+void compute_gaussian_latitudes_npole_equator( const size_t N, double lats[] );
 void compute_gaussian_quadrature_npole_equator( const size_t N, double lats[], double weights[] );
 }
 }  // namespace spacing
@@ -177,8 +178,9 @@ CASE( "test_gaussian_latitudes" ) {
     std::vector<double> factory_latitudes;
     std::vector<double> computed_latitudes;
     std::vector<double> computed_weights;
+    std::vector<double> computed_latitudes_only;
 
-    size_t size_test_N = 19;
+    size_t size_test_N = 23;
 
     size_t test_N[] = {16,  24,  32,  48,  64,  80,   96,   128,  160,  200,  256, 320,
                        400, 512, 576, 640, 800, 1024, 1280, 1600, 2000, 4000, 8000};
@@ -189,6 +191,7 @@ CASE( "test_gaussian_latitudes" ) {
         factory_latitudes.resize( N );
         computed_latitudes.resize( N );
         computed_weights.resize( N );
+        computed_latitudes_only.resize( N );
         // grid::gaussian::latitudes::gaussian_latitudes_npole_equator (N,
         // factory_latitudes.data());
         // grid::gaussian::latitudes::compute_gaussian_quadrature_npole_equator(N,
@@ -196,12 +199,14 @@ CASE( "test_gaussian_latitudes" ) {
         grid::spacing::gaussian::gaussian_latitudes_npole_equator( N, factory_latitudes.data() );
         grid::spacing::gaussian::compute_gaussian_quadrature_npole_equator( N, computed_latitudes.data(),
                                                                             computed_weights.data() );
+        grid::spacing::gaussian::compute_gaussian_latitudes_npole_equator( N, computed_latitudes_only.data() );
         double wsum = 0;
         for ( size_t i = 0; i < N; ++i ) {
-            EXPECT( eckit::types::is_approximately_equal( computed_latitudes[i], factory_latitudes[i], 0.0000001 ) );
+            EXPECT( eckit::types::is_approximately_equal( computed_latitudes[i], factory_latitudes[i], 1.e-10 ) );
+            EXPECT( computed_latitudes_only[i] == computed_latitudes[i] );
             wsum += computed_weights[i];
         }
-        EXPECT( eckit::types::is_approximately_equal( wsum * 2., 1., 0.0000001 ) );
+        EXPECT( eckit::types::is_approximately_equal( wsum * 2., 1., 1.e-12 ) );
     }
 }
 
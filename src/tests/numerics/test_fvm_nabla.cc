@@ -8,15 +8,20 @@
  * nor does it submit to any jurisdiction.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "atlas/array/MakeView.h"
 #include "atlas/field/Field.h"
 #include "atlas/field/FieldSet.h"
+#include "atlas/functionspace/NodeColumns.h"
 #include "atlas/grid/Grid.h"
 #include "atlas/grid/Partitioner.h"
 #include "atlas/library/Library.h"
+#include "atlas/mesh/HybridElements.h"
 #include "atlas/mesh/Mesh.h"
 #include "atlas/mesh/Nodes.h"
 #include "atlas/meshgenerator/StructuredMeshGenerator.h"
@@ -109,6 +114,103 @@ static std::string griduid() {
     return "Slat80";
 }
 
+/// @brief Edge-based divergence, curl and gradient of a vector field, as a reference for fvm::Nabla.
+/// Fluxes are computed once per edge and then summed per node with node2edge_sign.
+/// Results are stored as div[jnode*nlev+jlev], curl[jnode*nlev+jlev] and grad[(jnode*nlev+jlev)*4+jvar]
+void edge_based_nabla( const fvm::Method& fvm, const Field& wind, std::vector<double>& div,
+                       std::vector<double>& curl, std::vector<double>& grad ) {
+    const double radius      = fvm.radius();
+    const double deg2rad     = M_PI / 180.;
+    const mesh::Nodes& nodes = fvm.mesh().nodes();
+    const mesh::Edges& edges = fvm.mesh().edges();
+    const size_t nnodes      = nodes.size();
+    const size_t nedges      = edges.size();
+    const size_t nlev        = wind.levels();
+
+    const auto v                                  = array::make_view<double, 3>( wind );
+    const auto lonlat_deg                         = array::make_view<double, 2>( nodes.lonlat() );
+    const auto dual_volumes                       = array::make_view<double, 1>( nodes.field( "dual_volumes" ) );
+    const auto dual_normals                       = array::make_view<double, 2>( edges.field( "dual_normals" ) );
+    const auto edge_is_pole                       = array::make_view<int, 1>( edges.field( "is_pole_edge" ) );
+    const auto node2edge_sign                     = array::make_view<double, 2>( nodes.field( "node2edge_sign" ) );
+    const mesh::Connectivity& node2edge           = nodes.edge_connectivity();
+    const mesh::MultiBlockConnectivity& edge2node = edges.node_connectivity();
+
+    // Per edge and level: divergence flux, curl flux, and the 4 gradient fluxes
+    const size_t nflux = 6;
+    std::vector<double> flux( nedges * nlev * nflux );
+    for ( size_t jedge = 0; jedge < nedges; ++jedge ) {
+        const size_t ip1  = edge2node( jedge, 0 );
+        const size_t ip2  = edge2node( jedge, 1 );
+        const double cos1 = std::cos( lonlat_deg( ip1, LAT ) * deg2rad );
+        const double cos2 = std::cos( lonlat_deg( ip2, LAT ) * deg2rad );
+        const double Sx   = dual_normals( jedge, LON ) * deg2rad;
+        const double Sy   = dual_normals( jedge, LAT ) * deg2rad;
+        const double pole = edge_is_pole( jedge );
+        for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
+            double* F = flux.data() + ( jedge * nlev + jlev ) * nflux;
+
+            const double div_x = ( v( ip1, jlev, LON ) + v( ip2, jlev, LON ) ) * 0.5;
+            const double div_y = ( cos1 * v( ip1, jlev, LAT ) + cos2 * v( ip2, jlev, LAT ) ) * 0.5 * ( 1. - pole );
+            F[0]               = Sx * div_x + Sy * div_y;
+
+            const double curl_x =
+                radius * ( cos1 * v( ip1, jlev, LON ) + cos2 * v( ip2, jlev, LON ) ) * 0.5 * ( 1. - pole );
+            const double curl_y = radius * ( v( ip1, jlev, LAT ) + v( ip2, jlev, LAT ) ) * 0.5;
+            F[1]                 = Sx * curl_y - Sy * curl_x;
+
+            const double pbc    = 1. - 2. * pole;
+            const double grad_x = ( v( ip1, jlev, LON ) + pbc * v( ip2, jlev, LON ) ) * 0.5;
+            const double grad_y = ( v( ip1, jlev, LAT ) + pbc * v( ip2, jlev, LAT ) ) * 0.5;
+            F[2]                = Sx * grad_x;  // LONdLON
+            F[3]                = Sy * grad_x;  // LONdLAT
+            F[4]                = Sx * grad_y;  // LATdLON
+            F[5]                = Sy * grad_y;  // LATdLAT
+        }
+    }
+
+    const double scale = deg2rad * deg2rad * radius;
+    div.assign( nnodes * nlev, 0. );
+    curl.assign( nnodes * nlev, 0. );
+    grad.assign( nnodes * nlev * 4, 0. );
+    for ( size_t jnode = 0; jnode < nnodes; ++jnode ) {
+        const double cosy     = std::cos( lonlat_deg( jnode, LAT ) * deg2rad );
+        const double metric_y = 1. / ( dual_volumes( jnode ) * scale );
+        const double metric_x = metric_y / cosy;
+        for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
+            const size_t k = jnode * nlev + jlev;
+            for ( size_t jedge = 0; jedge < node2edge.cols( jnode ); ++jedge ) {
+                const double sign = node2edge_sign( jnode, jedge );
+                const double* F   = flux.data() + ( node2edge( jnode, jedge ) * nlev + jlev ) * nflux;
+                div[k] += sign * F[0];
+                curl[k] += sign * F[1];
+                for ( size_t jvar = 0; jvar < 4; ++jvar ) {
+                    grad[k * 4 + jvar] += sign * F[2 + jvar];
+                }
+            }
+            div[k] *= metric_x;
+            curl[k] *= metric_x / radius;
+            grad[k * 4 + 0] *= metric_x;
+            grad[k * 4 + 1] *= metric_y;
+            grad[k * 4 + 2] *= metric_x;
+            grad[k * 4 + 3] *= metric_y;
+        }
+    }
+
+    // Pole edges connect a node with its image across the pole, which flips the sign of vector components
+    for ( size_t jedge = 0; jedge < nedges; ++jedge ) {
+        if ( !edge_is_pole( jedge ) ) continue;
+        const size_t jnode    = edge2node( jedge, 1 );
+        const double metric_y = 1. / ( dual_volumes( jnode ) * scale );
+        for ( size_t jlev = 0; jlev < nlev; ++jlev ) {
+            const double* F = flux.data() + ( jedge * nlev + jlev ) * nflux;
+            const size_t k  = jnode * nlev + jlev;
+            grad[k * 4 + 1] -= 2. * F[3] * metric_y;
+            grad[k * 4 + 3] -= 2. * F[5] * metric_y;
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 CASE( "test_factory" ) {
@@ -323,6 +425,84 @@ CASE( "test_lapl" ) {
     }
 }
 
+CASE( "test_fieldset" ) {
+    Log::info() << "test_fieldset" << std::endl;
+    size_t nlev         = 3;
+    const double radius = util::Earth::radius();
+    Grid grid( griduid() );
+    MeshGenerator meshgenerator( "structured" );
+    Mesh mesh = meshgenerator.generate( grid, Distribution( grid, Partitioner( "equal_regions" ) ) );
+    fvm::Method fvm( mesh, util::Config( "radius", radius ) | option::levels( nlev ) );
+    Nabla nabla( fvm );
+    const functionspace::NodeColumns& fs = fvm.node_columns();
+
+    FieldSet winds;
+    winds.add( fs.createField<double>( option::name( "wind1" ) | option::variables( 2 ) ) );
+    winds.add( fs.createField<double>( option::name( "wind2" ) | option::variables( 2 ) ) );
+    rotated_flow( fvm, winds[0], M_PI_2 * 0.75 );
+    rotated_flow( fvm, winds[1], M_PI_2 * 0.25 );
+
+    auto create = [&]( const std::string& name, int nvar ) {
+        FieldSet fields;
+        for ( size_t f = 0; f < winds.size(); ++f ) {
+            fields.add( fs.createField<double>( option::name( name + std::to_string( f ) ) |
+                                                option::variables( nvar ) ) );
+        }
+        return fields;
+    };
+
+    FieldSet div  = create( "div", 1 );
+    FieldSet curl = create( "curl", 1 );
+    FieldSet grad = create( "grad", 4 );
+    nabla.divergence( winds, div );
+    nabla.curl( winds, curl );
+    nabla.gradient( winds, grad );
+
+    SECTION( "same as edge-based reference" ) {
+        auto check = [&]( const Field& field, const std::vector<double>& reference ) {
+            EXPECT( field.size() == reference.size() );
+            const double* result = field.data<double>();
+            double max_ref       = 0.;
+            for ( double r : reference ) {
+                max_ref = std::max( max_ref, std::abs( r ) );
+            }
+            EXPECT( max_ref > 0. );
+            for ( size_t k = 0; k < reference.size(); ++k ) {
+                EXPECT( std::abs( result[k] - reference[k] ) <= 1.e-10 * max_ref );
+            }
+        };
+        for ( size_t f = 0; f < winds.size(); ++f ) {
+            std::vector<double> div_ref, curl_ref, grad_ref;
+            edge_based_nabla( fvm, winds[f], div_ref, curl_ref, grad_ref );
+            check( div[f], div_ref );
+            check( curl[f], curl_ref );
+            check( grad[f], grad_ref );
+        }
+    }
+
+    SECTION( "single precision" ) {
+        Field wind   = fs.createField<float>( option::variables( 2 ) );
+        Field curl_r = fs.createField<float>( option::variables( 1 ) );
+        auto w       = array::make_view<float, 3>( wind );
+        auto w_d     = array::make_view<double, 3>( winds[0] );
+        for ( size_t n = 0; n < fs.nb_nodes(); ++n ) {
+            for ( size_t l = 0; l < nlev; ++l ) {
+                w( n, l, LON ) = w_d( n, l, LON );
+                w( n, l, LAT ) = w_d( n, l, LAT );
+            }
+        }
+        nabla.curl( wind, curl_r );
+        auto c   = array::make_view<double, 2>( curl[0] );
+        auto c_r = array::make_view<float, 2>( curl_r );
+        double max_c( 0 ), max_diff( 0 );
+        for ( size_t n = 0; n < fs.nb_nodes(); ++n ) {
+            max_c    = std::max( max_c, std::abs( c( n, 0 ) ) );
+            max_diff = std::max( max_diff, std::abs( c( n, 0 ) - c_r( n, 0 ) ) );
+        }
+        EXPECT( max_diff <= 1.e-3 * max_c );
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 }  // namespace test
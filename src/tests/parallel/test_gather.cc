@@ -16,6 +16,7 @@
 #include "atlas/array/ArrayView.h"
 #include "atlas/array/MakeView.h"
 #include "atlas/library/config.h"
+#include "atlas/parallel/Checksum.h"
 #include "atlas/parallel/GatherScatter.h"
 #include "atlas/parallel/mpi/mpi.h"
 #include "eckit/utils/Translator.h"
@@ -681,6 +682,59 @@ CASE( "test_gather" ) {
                 }
             }
         }
+
+        SECTION( "test_gather_multiple_roots" ) {
+            const size_t nproc = mpi::comm().size();
+            std::vector<size_t> roots{0, nproc - 1, nproc / 2};
+            const size_t nb_fields = roots.size();
+
+            std::vector<std::vector<POD>> loc( nb_fields, std::vector<POD>( f.Nl ) );
+            std::vector<std::vector<POD>> glb( nb_fields );
+            std::vector<parallel::Field<POD const>> loc_fields;
+            std::vector<parallel::Field<POD>> glb_fields;
+            for ( size_t jfield = 0; jfield < nb_fields; ++jfield ) {
+                f.root = roots[jfield];
+                glb[jfield].resize( f.Ng() );
+                for ( int j = 0; j < f.Nl; ++j ) {
+                    loc[jfield][j] = ( size_t( f.part[j] ) != mpi::comm().rank() ? 0 : f.gidx[j] * ( jfield + 1 ) );
+                }
+                loc_fields.emplace_back( loc[jfield].data(), 1 );
+                glb_fields.emplace_back( glb[jfield].data(), 1 );
+            }
+
+            f.gather_scatter.gather( loc_fields.data(), glb_fields.data(), nb_fields, roots );
+
+            for ( size_t jfield = 0; jfield < nb_fields; ++jfield ) {
+                if ( mpi::comm().rank() == roots[jfield] ) {
+                    EXPECT( glb[jfield].size() == 9 );
+                    for ( size_t j = 0; j < glb[jfield].size(); ++j ) {
+                        EXPECT( glb[jfield][j] == POD( ( j + 1 ) * ( jfield + 1 ) ) );
+                    }
+                }
+            }
+        }
+
+        SECTION( "test_checksum" ) {
+            std::vector<POD> loc( f.Nl );
+            for ( int j = 0; j < f.Nl; ++j ) {
+                loc[j] = f.gidx[j] * 10;
+            }
+            parallel::Checksum checksum;
+            checksum.setup( f.part.data(), f.ridx.data(), 0, f.gidx.data(), f.Nl );
+
+            // Same result as hashing the global field in any order on a single task
+            util::checksum_t expected = 0;
+            for ( gidx_t g = 9; g >= 1; --g ) {
+                POD value = g * 10;
+                expected += util::hash( g, &value, 1 );
+            }
+            EXPECT( checksum.execute( loc.data(), 1 ) ==
+                    eckit::Translator<util::checksum_t, std::string>()( expected ) );
+
+            loc[2] += 1.;  // an owned point on every task
+            EXPECT( checksum.execute( loc.data(), 1 ) !=
+                    eckit::Translator<util::checksum_t, std::string>()( expected ) );
+        }
     }
 }
 
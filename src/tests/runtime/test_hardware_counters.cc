@@ -0,0 +1,107 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <cmath>
+#include <string>
+
+#include "atlas/parallel/omp/omp.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/runtime/trace/HardwareCounters.h"
+#include "atlas/util/Config.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+using atlas::runtime::trace::HardwareCounters;
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+volatile double sink;
+
+void work( size_t n ) {
+    double sum = 0.;
+    for ( size_t i = 0; i < n; ++i ) {
+        sum += std::sqrt( double( i ) );
+    }
+    sink = sum;
+}
+
+HardwareCounters::Values count_work( size_t n ) {
+    HardwareCounters counters;
+    counters.start();
+    work( n );
+    counters.stop();
+    return counters.values();
+}
+
+std::string first_line( const std::string& s ) {
+    return s.substr( 0, s.find( '\n' ) );
+}
+
+//-----------------------------------------------------------------------------
+
+CASE( "test_hardware_counters" ) {
+    {
+        ATLAS_TRACE( "work" );
+        work( 1000000 );
+    }
+
+    // Reading the counters the first time may disable them, when not supported
+    auto serial = count_work( 10000000 );
+
+    if ( HardwareCounters::enabled() ) {
+        Log::info() << "Hardware counters enabled" << std::endl;
+        EXPECT( serial[HardwareCounters::CYCLES] > 0 );
+        EXPECT( serial[HardwareCounters::INSTRUCTIONS] > 10000000 );
+
+        SECTION( "work of other OpenMP threads is counted" ) {
+            if ( atlas_omp_get_max_threads() > 1 ) {
+                HardwareCounters counters;
+                counters.start();
+                atlas_omp_parallel {
+                    if ( atlas_omp_get_thread_num() == 1 ) { work( 10000000 ); }
+                }
+                counters.stop();
+                EXPECT( counters.values()[HardwareCounters::INSTRUCTIONS] >
+                        0.9 * serial[HardwareCounters::INSTRUCTIONS] );
+            }
+        }
+
+        SECTION( "report" ) {
+            EXPECT( first_line( Trace::report( util::Config( "format", "csv" ) ) ) ==
+                    "id,title,nest,location,count,tot,avg,std,min,max,"
+                    "cycles,instructions,llc_misses,branch_misses,ipc,bytes_per_instruction" );
+            EXPECT( Trace::report().find( "B/ins" ) != std::string::npos );
+        }
+    }
+    else {
+        Log::info() << "Hardware counters disabled" << std::endl;
+        for ( auto c : serial ) {
+            EXPECT( c == 0 );
+        }
+
+        SECTION( "report" ) {
+            EXPECT( first_line( Trace::report( util::Config( "format", "csv" ) ) ) ==
+                    "id,title,nest,location,count,tot,avg,std,min,max" );
+            EXPECT( Trace::report().find( "B/ins" ) == std::string::npos );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main( int argc, char** argv ) {
+    return atlas::test::run( argc, argv );
+}
@@ -0,0 +1,111 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "atlas/parallel/mpi/mpi.h"
+#include "atlas/runtime/Trace.h"
+#include "atlas/runtime/trace/Timings.h"
+#include "atlas/util/Config.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+using atlas::runtime::trace::Timings;
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+size_t find( const std::vector<Timings::Aggregated>& timers, const std::string& title ) {
+    for ( size_t j = 0; j < timers.size(); ++j ) {
+        if ( timers[j].title == title ) { return j; }
+    }
+    return timers.size();
+}
+
+CASE( "test_timings_aggregate" ) {
+    const size_t rank  = mpi::comm().rank();
+    const size_t nproc = mpi::comm().size();
+
+    // All tasks call "common", for a time that increases with rank; only the first task calls "first",
+    // and only the last task calls "last", nested in "common"
+    double elapsed;
+    {
+        Trace common( Here(), "common" );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 * ( rank + 1 ) ) );
+        if ( rank == 0 ) { Trace first( Here(), "first" ); }
+        if ( rank == nproc - 1 ) { Trace last( Here(), "last" ); }
+        common.stop();
+        elapsed = common.elapsed();
+    }
+
+    double min = elapsed, max = elapsed, sum = elapsed;
+    mpi::comm().allReduceInPlace( min, eckit::mpi::min() );
+    mpi::comm().allReduceInPlace( max, eckit::mpi::max() );
+    mpi::comm().allReduceInPlace( sum, eckit::mpi::sum() );
+    size_t slowest = elapsed == max ? rank : nproc;
+    mpi::comm().allReduceInPlace( slowest, eckit::mpi::min() );
+
+    std::vector<Timings::Aggregated> timers = Timings::aggregate();
+
+    const size_t c = find( timers, "common" );
+    const size_t f = find( timers, "first" );
+    const size_t l = find( timers, "last" );
+    EXPECT( c < timers.size() );
+    EXPECT( f < timers.size() );
+    EXPECT( l < timers.size() );
+
+    // Timers are re-entered when the case is repeated for sections, so all checks are done in one pass
+    const auto& t = timers[c];
+    EXPECT( t.count == 1 );
+    EXPECT( t.ntasks == long( nproc ) );
+    EXPECT( t.min == min );
+    EXPECT( t.max == max );
+    EXPECT( std::abs( t.avg - sum / nproc ) < 1.e-12 * max );
+    EXPECT( t.slowest == slowest );
+    EXPECT( not t.excluded );
+
+    // Timers of a single task
+    EXPECT( timers[f].ntasks == 1 );
+    EXPECT( timers[f].slowest == 0 );
+    EXPECT( timers[l].ntasks == 1 );
+    EXPECT( timers[l].slowest == nproc - 1 );
+
+    // Nested timers follow their parent, on all tasks
+    EXPECT( timers[f].nest == t.nest + 1 );
+    EXPECT( timers[l].nest == t.nest + 1 );
+    EXPECT( f > c );
+    EXPECT( l > c );
+    for ( size_t j = c + 1; j < std::max( f, l ); ++j ) {
+        EXPECT( timers[j].nest > t.nest );
+    }
+
+    // Exclusions
+    std::vector<Timings::Aggregated> filtered = Timings::aggregate( util::Config( "depth", t.nest ) );
+    EXPECT( filtered.size() == timers.size() );
+    EXPECT( not filtered[c].excluded );
+    EXPECT( filtered[f].excluded );
+    EXPECT( filtered[l].excluded );
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main( int argc, char** argv ) {
+    return atlas::test::run( argc, argv );
+}
@@ -0,0 +1,83 @@
+/*
+ * (C) Copyright 2013 ECMWF.
+ *
+ * This software is licensed under the terms of the Apache Licence Version 2.0
+ * which can be obtained at http://www.apache.org/licenses/LICENSE-2.0.
+ * In applying this licence, ECMWF does not waive the privileges and immunities
+ * granted to it by virtue of its status as an intergovernmental organisation
+ * nor does it submit to any jurisdiction.
+ */
+
+#include <vector>
+
+#include "atlas/grid/Grid.h"
+#include "atlas/mesh/HybridElements.h"
+#include "atlas/mesh/Mesh.h"
+#include "atlas/mesh/Nodes.h"
+#include "atlas/meshgenerator/MeshGenerator.h"
+#include "atlas/util/MicroDeg.h"
+#include "atlas/util/Unique.h"
+
+#include "tests/AtlasTestEnvironment.h"
+
+namespace atlas {
+namespace test {
+
+//-----------------------------------------------------------------------------
+
+CASE( "test_unique_lonlat_points" ) {
+    // More points than a single block, with negative and periodic longitudes
+    std::vector<double> lonlat;
+    for ( int j = 0; j < 1000; ++j ) {
+        lonlat.push_back( -180. + 0.7231 * j );
+        lonlat.push_back( 90. - 0.1797 * j );
+    }
+    const size_t npts = lonlat.size() / 2;
+
+    std::vector<uidx_t> uid( npts );
+    util::unique_lonlat_points( lonlat.data(), npts, uid.data() );
+    std::vector<int> lonlat_microdeg_idx;
+    for ( size_t n = 0; n < npts; ++n ) {
+        EXPECT( uid[n] == util::unique_lonlat( lonlat[2 * n], lonlat[2 * n + 1] ) );
+        lonlat_microdeg_idx.push_back( util::microdeg( lonlat[2 * n] ) );
+        lonlat_microdeg_idx.push_back( util::microdeg( lonlat[2 * n + 1] ) );
+        lonlat_microdeg_idx.push_back( n );
+    }
+
+    std::vector<gidx_t> uid_microdeg( npts );
+    util::unique_lonlat_microdeg_points( lonlat_microdeg_idx.data(), npts, uid_microdeg.data(), 3 );
+    for ( size_t n = 0; n < npts; ++n ) {
+        EXPECT( uid_microdeg[n] == gidx_t( uid[n] ) );
+    }
+}
+
+CASE( "test_unique_lonlat_mesh" ) {
+    Mesh mesh = MeshGenerator( "structured" ).generate( Grid( "O32" ) );
+    const util::UniqueLonLat compute_uid( mesh );
+
+    const size_t nb_nodes = mesh.nodes().size();
+    std::vector<uidx_t> node_uid( nb_nodes );
+    compute_uid( 0, nb_nodes, node_uid.data() );
+    for ( size_t n = 0; n < nb_nodes; ++n ) {
+        EXPECT( node_uid[n] == compute_uid( n ) );
+    }
+
+    // Sub-range of the elements
+    const auto& cell_nodes = mesh.cells().node_connectivity();
+    const size_t begin     = 10;
+    const size_t end       = mesh.cells().size();
+    std::vector<uidx_t> cell_uid( end - begin );
+    compute_uid( cell_nodes, begin, end, cell_uid.data() );
+    for ( size_t e = begin; e < end; ++e ) {
+        EXPECT( cell_uid[e - begin] == compute_uid( cell_nodes.row( e ) ) );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+}  // namespace test
+}  // namespace atlas
+
+int main( int argc, char** argv ) {
+    return atlas::test::run( argc, argv );
+}